@@ -0,0 +1,166 @@
+/**
+ * @file bench_event_bus.cpp
+ * @brief EventBus publish/poll latency under multi-producer contention
+ * 
+ * N producer threads publish VisionEvents while one consumer drains the
+ * topic with the zero-copy consume<T>() path. Reports per-call publish
+ * latency percentiles, consume batch latency and end-to-end throughput.
+ * A second phase measures push delivery lag to an event-driven subscriber.
+ * 
+ * Usage: bench_event_bus [producers=4] [events_per_producer=200000]
+ */
+
+#include <iostream>
+#include <iomanip>
+#include <thread>
+#include <vector>
+#include <atomic>
+#include <chrono>
+#include <algorithm>
+#include <cstdlib>
+#include "cognitive_os/event_bus.h"
+
+using namespace melvin::cognitive_os;
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+double percentile(std::vector<double>& v, double p) {
+    if (v.empty()) return 0.0;
+    size_t idx = static_cast<size_t>(p * (v.size() - 1));
+    std::nth_element(v.begin(), v.begin() + idx, v.end());
+    return v[idx];
+}
+
+void print_latency(const char* label, std::vector<double>& ns) {
+    std::cout << "   " << std::left << std::setw(10) << label
+              << " p50=" << std::setw(8) << percentile(ns, 0.50)
+              << " p99=" << std::setw(8) << percentile(ns, 0.99)
+              << " p999=" << std::setw(8) << percentile(ns, 0.999)
+              << " (ns)\n";
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    int producers = argc > 1 ? std::max(1, std::atoi(argv[1])) : 4;
+    int per_producer = argc > 2 ? std::max(1, std::atoi(argv[2])) : 200000;
+    
+    std::cout << "📊 EventBus contention benchmark\n";
+    std::cout << "   Producers: " << producers << ", events/producer: " << per_producer << "\n\n";
+    
+    EventBus bus(1024);
+    std::atomic<bool> go{false};
+    std::atomic<int> producers_done{0};
+    std::vector<std::vector<double>> publish_ns(producers);
+    std::vector<std::thread> threads;
+    
+    for (int p = 0; p < producers; p++) {
+        threads.emplace_back([&, p]() {
+            VisionEvent ev;
+            ev.obj_ids = {p, p + 1, p + 2};
+            ev.bbox = {0.0f, 0.0f, 1.0f, 1.0f};
+            auto& samples = publish_ns[p];
+            samples.reserve(per_producer);
+            while (!go.load(std::memory_order_acquire)) {}
+            for (int i = 0; i < per_producer; i++) {
+                auto t0 = Clock::now();
+                bus.publish(topic_ids::VISION_EVENTS, ev);
+                auto t1 = Clock::now();
+                samples.push_back(std::chrono::duration<double, std::nano>(t1 - t0).count());
+            }
+            producers_done.fetch_add(1, std::memory_order_release);
+        });
+    }
+    
+    std::vector<double> consume_ns;
+    uint64_t consumed = 0;
+    std::thread consumer([&]() {
+        while (!go.load(std::memory_order_acquire)) {}
+        for (;;) {
+            bool done = producers_done.load(std::memory_order_acquire) == producers;
+            auto t0 = Clock::now();
+            size_t n = bus.consume<VisionEvent>(topic_ids::VISION_EVENTS,
+                [](TypedEvent<VisionEvent>& ev) { (void)ev; });
+            auto t1 = Clock::now();
+            if (n > 0) {
+                consume_ns.push_back(std::chrono::duration<double, std::nano>(t1 - t0).count() / n);
+                consumed += n;
+            } else if (done) {
+                break;
+            }
+        }
+    });
+    
+    auto start = Clock::now();
+    go.store(true, std::memory_order_release);
+    for (auto& t : threads) t.join();
+    consumer.join();
+    double elapsed_s = std::chrono::duration<double>(Clock::now() - start).count();
+    
+    std::vector<double> all_publish;
+    for (auto& v : publish_ns) all_publish.insert(all_publish.end(), v.begin(), v.end());
+    
+    uint64_t published = static_cast<uint64_t>(producers) * per_producer;
+    std::cout << std::fixed << std::setprecision(1);
+    print_latency("publish", all_publish);
+    print_latency("consume", consume_ns);
+    std::cout << "   Throughput: " << (published / elapsed_s / 1e6) << " M events/s\n";
+    std::cout << "   Consumed:   " << consumed << " / " << published
+              << " (dropped " << bus.dropped_messages() << ")\n";
+    
+    bool ring_ok = consumed + bus.dropped_messages() == published;
+    
+    // ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
+    // PUSH DELIVERY: publish -> subscriber callback lag
+    // ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
+    
+    std::cout << "\n📬 Push delivery (" << producers << " producers → 1 subscriber)\n";
+    
+    EventBus push_bus(1024);
+    SubscriptionOptions options;
+    options.name = "bench_subscriber";
+    options.queue_capacity = 1024;
+    std::atomic<uint64_t> received{0};
+    push_bus.subscribe(topics::COG_ANSWER, [&](const Event&) {
+        received.fetch_add(1, std::memory_order_relaxed);
+    }, options);
+    
+    const int push_per_producer = 2000;
+    threads.clear();
+    for (int p = 0; p < producers; p++) {
+        threads.emplace_back([&]() {
+            CogAnswer answer;
+            answer.text = "bench";
+            for (int i = 0; i < push_per_producer; i++) {
+                push_bus.publish(topic_ids::COG_ANSWER, answer);
+                std::this_thread::sleep_for(std::chrono::microseconds(200));
+            }
+        });
+    }
+    for (auto& t : threads) t.join();
+    
+    uint64_t pushed = static_cast<uint64_t>(producers) * push_per_producer;
+    for (int i = 0; i < 100 && received.load() + push_bus.dropped_messages() < pushed; i++) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    
+    for (const auto& st : push_bus.subscriber_stats()) {
+        std::cout << "   " << st.name << ": delivered=" << st.delivered
+                  << " dropped=" << st.dropped
+                  << " max_depth=" << st.max_queue_depth
+                  << " avg_lag=" << std::setprecision(3) << st.avg_lag_ms << "ms"
+                  << " max_lag=" << st.max_lag_ms << "ms\n";
+    }
+    
+    std::cout << "\n⏱  Publish → consume lag histograms (ms):\n";
+    for (const auto& lat : melvin::metrics::LatencyRegistry::instance().snapshot()) {
+        std::cout << "   " << std::left << std::setw(24) << lat.name << std::right
+                  << " n=" << lat.count
+                  << " p50=" << lat.p50_ms << " p99=" << lat.p99_ms
+                  << " p999=" << lat.p999_ms << "\n";
+    }
+    
+    bool push_ok = received.load() + push_bus.dropped_messages() == pushed;
+    return ring_ok && push_ok ? 0 : 1;
+}
@@ -0,0 +1,189 @@
+/**
+ * @file bench_field_messages.cpp
+ * @brief UnifiedActivationField message queue enqueue/drain throughput
+ *
+ * N producer threads post messages round-robin over every MessageType
+ * while one consumer per type batch-drains its queue. Reports per-call
+ * post latency percentiles, per-message drain cost and end-to-end
+ * throughput, then runs the same load through the previous design
+ * (one mutex-guarded std::queue, drain-by-type with requeue) for
+ * comparison.
+ *
+ * Usage: bench_field_messages [producers=4] [messages_per_producer=200000] [payload_floats=128]
+ */
+
+#include <iostream>
+#include <iomanip>
+#include <thread>
+#include <vector>
+#include <queue>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <algorithm>
+#include <cstdlib>
+#include "core/fields/activation_field_unified.h"
+
+using namespace melvin::fields;
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+double percentile(std::vector<double>& v, double p) {
+    if (v.empty()) return 0.0;
+    size_t idx = static_cast<size_t>(p * (v.size() - 1));
+    std::nth_element(v.begin(), v.begin() + idx, v.end());
+    return v[idx];
+}
+
+void print_latency(const char* label, std::vector<double>& ns) {
+    std::cout << "   " << std::left << std::setw(10) << label
+              << " p50=" << std::setw(8) << percentile(ns, 0.50)
+              << " p99=" << std::setw(8) << percentile(ns, 0.99)
+              << " p999=" << std::setw(8) << percentile(ns, 0.999)
+              << " (ns)\n";
+}
+
+/**
+ * @brief The shared-queue design the per-type queues replaced
+ */
+class LegacyMessageQueue {
+public:
+    void post(const FieldMessage& msg) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        queue_.push(msg);
+    }
+
+    std::vector<FieldMessage> drain(MessageType type) {
+        std::vector<FieldMessage> result;
+        std::vector<FieldMessage> remaining;
+        std::lock_guard<std::mutex> lock(mutex_);
+        while (!queue_.empty()) {
+            auto msg = queue_.front();
+            queue_.pop();
+            if (msg.type == type) result.push_back(msg);
+            else remaining.push_back(msg);
+        }
+        for (const auto& msg : remaining) queue_.push(msg);
+        return result;
+    }
+
+private:
+    std::queue<FieldMessage> queue_;
+    std::mutex mutex_;
+};
+
+struct RunResult {
+    std::vector<double> post_ns;
+    std::vector<double> drain_ns;  // Per message, per non-empty drain
+    uint64_t drained = 0;
+    double elapsed_s = 0.0;
+};
+
+/**
+ * @brief Run producers and one consumer per type; post/drain are the design under test
+ */
+template<typename PostFn, typename DrainFn>
+RunResult run_load(int producers, int per_producer, int payload, PostFn post, DrainFn drain) {
+    RunResult result;
+    std::atomic<bool> go{false};
+    std::atomic<int> producers_done{0};
+    std::vector<std::vector<double>> post_ns(producers);
+    std::vector<std::vector<double>> drain_ns(MESSAGE_TYPE_COUNT);
+    std::atomic<uint64_t> drained{0};
+    std::vector<std::thread> threads;
+
+    for (int p = 0; p < producers; p++) {
+        threads.emplace_back([&, p]() {
+            FieldMessage msg(MessageType::SENSORY_INPUT, p, 0, 1.0f);
+            msg.data.assign(payload, 0.5f);
+            auto& samples = post_ns[p];
+            samples.reserve(per_producer);
+            while (!go.load(std::memory_order_acquire)) {}
+            for (int i = 0; i < per_producer; i++) {
+                msg.type = static_cast<MessageType>(i % MESSAGE_TYPE_COUNT);
+                msg.target_node_id = i;
+                auto t0 = Clock::now();
+                post(msg);
+                auto t1 = Clock::now();
+                samples.push_back(std::chrono::duration<double, std::nano>(t1 - t0).count());
+            }
+            producers_done.fetch_add(1, std::memory_order_release);
+        });
+    }
+
+    for (size_t t = 0; t < MESSAGE_TYPE_COUNT; t++) {
+        threads.emplace_back([&, t]() {
+            MessageType type = static_cast<MessageType>(t);
+            while (!go.load(std::memory_order_acquire)) {}
+            for (;;) {
+                bool done = producers_done.load(std::memory_order_acquire) == producers;
+                auto t0 = Clock::now();
+                size_t n = drain(type);
+                auto t1 = Clock::now();
+                if (n > 0) {
+                    drain_ns[t].push_back(std::chrono::duration<double, std::nano>(t1 - t0).count() / n);
+                    drained.fetch_add(n, std::memory_order_relaxed);
+                } else if (done) {
+                    break;
+                }
+            }
+        });
+    }
+
+    auto start = Clock::now();
+    go.store(true, std::memory_order_release);
+    for (auto& t : threads) t.join();
+    result.elapsed_s = std::chrono::duration<double>(Clock::now() - start).count();
+
+    for (auto& v : post_ns) result.post_ns.insert(result.post_ns.end(), v.begin(), v.end());
+    for (auto& v : drain_ns) result.drain_ns.insert(result.drain_ns.end(), v.begin(), v.end());
+    result.drained = drained.load();
+    return result;
+}
+
+void print_result(RunResult& r, uint64_t posted) {
+    print_latency("post", r.post_ns);
+    print_latency("drain/msg", r.drain_ns);
+    std::cout << "   Throughput: " << (posted / r.elapsed_s / 1e6) << " M messages/s\n";
+    std::cout << "   Drained:    " << r.drained << " / " << posted << "\n";
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    int producers = argc > 1 ? std::max(1, std::atoi(argv[1])) : 4;
+    int per_producer = argc > 2 ? std::max(1, std::atoi(argv[2])) : 200000;
+    int payload = argc > 3 ? std::max(0, std::atoi(argv[3])) : 128;
+    uint64_t posted = static_cast<uint64_t>(producers) * per_producer;
+
+    std::cout << "📊 Field message queue benchmark\n";
+    std::cout << "   Producers: " << producers << ", messages/producer: " << per_producer
+              << ", payload: " << payload << " floats, consumers: " << MESSAGE_TYPE_COUNT << "\n\n";
+    std::cout << std::fixed << std::setprecision(1);
+
+    std::cout << "⚡ Per-type MPSC queues + slab payloads (batch drain)\n";
+    UnifiedActivationField field;
+    std::vector<FieldMessageBatch> batches(MESSAGE_TYPE_COUNT);
+    auto current = run_load(producers, per_producer, payload,
+        [&](const FieldMessage& msg) { field.post_message(msg); },
+        [&](MessageType type) {
+            auto& batch = batches[static_cast<size_t>(type)];
+            batch.clear();
+            return field.drain_messages(type, batch, 1024);
+        });
+    print_result(current, posted);
+    std::cout << "   Dropped:    " << field.dropped_messages() << "\n\n";
+
+    std::cout << "🐢 Shared std::queue + requeue (previous design)\n";
+    LegacyMessageQueue legacy;
+    auto previous = run_load(producers, per_producer, payload,
+        [&](const FieldMessage& msg) { legacy.post(msg); },
+        [&](MessageType type) { return legacy.drain(type).size(); });
+    print_result(previous, posted);
+
+    std::cout << "\n   Speedup: " << std::setprecision(2)
+              << previous.elapsed_s / current.elapsed_s << "x end-to-end\n";
+
+    return current.drained + field.dropped_messages() == posted ? 0 : 1;
+}
@@ -0,0 +1,194 @@
+/**
+ * @file bench_harness.h
+ * @brief Minimal microbenchmark harness (timing, JSON results, baselines)
+ *
+ * Each benchmark is a callable timed one operation at a time after a
+ * short warmup. Per-op samples go into a metrics::Histogram, so results
+ * report p50/p99 as well as the mean.
+ *
+ * Results are written one JSON object per line, which is also the
+ * baseline format: compare_to_baseline() re-reads a previous run and
+ * flags any benchmark whose p50 grew by more than the tolerance.
+ */
+
+#ifndef MELVIN_BENCH_HARNESS_H
+#define MELVIN_BENCH_HARNESS_H
+
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "core/metrics/latency_histogram.h"
+
+namespace melvin {
+namespace bench {
+
+struct BenchResult {
+    std::string name;
+    uint64_t iterations = 0;
+    double mean_ns = 0.0;
+    double p50_ns = 0.0;
+    double p99_ns = 0.0;
+    double max_ns = 0.0;
+    double ops_per_sec = 0.0;
+};
+
+struct BenchOptions {
+    int warmup_iterations = 3;
+    int min_iterations = 10;
+    int max_iterations = 100000;
+    double min_time_ms = 300.0;
+};
+
+/**
+ * @brief Time fn() until both the iteration and time minimums are met
+ */
+template<typename Fn>
+BenchResult run_bench(const std::string& name, const BenchOptions& opts, Fn&& fn) {
+    using Clock = std::chrono::steady_clock;
+
+    for (int i = 0; i < opts.warmup_iterations; i++) {
+        fn();
+    }
+
+    metrics::Histogram histogram;
+    auto start = Clock::now();
+    double elapsed_ms = 0.0;
+    int iterations = 0;
+
+    while (iterations < opts.max_iterations &&
+           (iterations < opts.min_iterations || elapsed_ms < opts.min_time_ms)) {
+        auto t0 = Clock::now();
+        fn();
+        auto t1 = Clock::now();
+        histogram.record(static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count()));
+        iterations++;
+        elapsed_ms = std::chrono::duration<double, std::milli>(t1 - start).count();
+    }
+
+    BenchResult r;
+    r.name = name;
+    r.iterations = histogram.count();
+    r.mean_ns = histogram.mean();
+    r.p50_ns = static_cast<double>(histogram.value_at(0.50));
+    r.p99_ns = static_cast<double>(histogram.value_at(0.99));
+    r.max_ns = static_cast<double>(histogram.max());
+    r.ops_per_sec = r.mean_ns > 0.0 ? 1e9 / r.mean_ns : 0.0;
+    return r;
+}
+
+inline std::string to_json(const BenchResult& r) {
+    std::ostringstream oss;
+    oss << std::fixed << std::setprecision(1);
+    oss << "{\"name\":\"" << r.name << "\""
+        << ",\"iterations\":" << r.iterations
+        << ",\"mean_ns\":" << r.mean_ns
+        << ",\"p50_ns\":" << r.p50_ns
+        << ",\"p99_ns\":" << r.p99_ns
+        << ",\"max_ns\":" << r.max_ns
+        << ",\"ops_per_sec\":" << r.ops_per_sec
+        << "}";
+    return oss.str();
+}
+
+inline void print_result(const BenchResult& r) {
+    std::cout << "   " << std::left << std::setw(30) << r.name << std::right
+              << std::fixed << std::setprecision(3)
+              << " n=" << std::setw(7) << r.iterations
+              << " p50=" << std::setw(10) << r.p50_ns / 1e3
+              << " p99=" << std::setw(10) << r.p99_ns / 1e3
+              << " mean=" << std::setw(10) << r.mean_ns / 1e3 << " (µs)\n";
+}
+
+inline bool write_results(const std::string& path, const std::vector<BenchResult>& results) {
+    std::ofstream out(path);
+    if (!out.is_open()) return false;
+    for (const auto& r : results) {
+        out << to_json(r) << "\n";
+    }
+    return out.good();
+}
+
+namespace detail {
+
+inline bool json_field(const std::string& line, const std::string& key, std::string& value) {
+    std::string pattern = "\"" + key + "\":";
+    size_t pos = line.find(pattern);
+    if (pos == std::string::npos) return false;
+    pos += pattern.size();
+    if (pos < line.size() && line[pos] == '"') {
+        size_t end = line.find('"', pos + 1);
+        if (end == std::string::npos) return false;
+        value = line.substr(pos + 1, end - pos - 1);
+    } else {
+        size_t end = line.find_first_of(",}", pos);
+        value = line.substr(pos, end - pos);
+    }
+    return true;
+}
+
+} // namespace detail
+
+/**
+ * @brief Read results written by write_results()
+ */
+inline std::vector<BenchResult> read_results(const std::string& path) {
+    std::vector<BenchResult> results;
+    std::ifstream in(path);
+    std::string line;
+    while (std::getline(in, line)) {
+        BenchResult r;
+        std::string value;
+        if (!detail::json_field(line, "name", r.name)) continue;
+        if (detail::json_field(line, "iterations", value)) r.iterations = std::stoull(value);
+        if (detail::json_field(line, "mean_ns", value)) r.mean_ns = std::stod(value);
+        if (detail::json_field(line, "p50_ns", value)) r.p50_ns = std::stod(value);
+        if (detail::json_field(line, "p99_ns", value)) r.p99_ns = std::stod(value);
+        if (detail::json_field(line, "max_ns", value)) r.max_ns = std::stod(value);
+        if (detail::json_field(line, "ops_per_sec", value)) r.ops_per_sec = std::stod(value);
+        results.push_back(r);
+    }
+    return results;
+}
+
+/**
+ * @brief Compare p50 against a baseline run
+ *
+ * @return Number of benchmarks slower than baseline * (1 + tolerance)
+ */
+inline int compare_to_baseline(const std::vector<BenchResult>& results,
+                               const std::vector<BenchResult>& baseline,
+                               double tolerance) {
+    int regressions = 0;
+    std::cout << "\n📏 Baseline comparison (tolerance " << std::setprecision(0)
+              << tolerance * 100.0 << "%)\n";
+
+    for (const auto& r : results) {
+        const BenchResult* base = nullptr;
+        for (const auto& b : baseline) {
+            if (b.name == r.name) { base = &b; break; }
+        }
+        if (!base || base->p50_ns <= 0.0) {
+            std::cout << "   " << std::left << std::setw(30) << r.name << std::right << "   (no baseline)\n";
+            continue;
+        }
+
+        double change = r.p50_ns / base->p50_ns - 1.0;
+        bool regressed = change > tolerance;
+        if (regressed) regressions++;
+        std::cout << "   " << (regressed ? "❌ " : "✅ ") << std::left << std::setw(30) << r.name
+                  << std::right << std::showpos << std::fixed << std::setprecision(1)
+                  << change * 100.0 << "%" << std::noshowpos << "\n";
+    }
+    return regressions;
+}
+
+} // namespace bench
+} // namespace melvin
+
+#endif // MELVIN_BENCH_HARNESS_H
@@ -0,0 +1,420 @@
+/**
+ * @file melvin_bench.cpp
+ * @brief Reproducible microbenchmarks for the hot paths
+ *
+ * Runs each component against a deterministic synthetic graph (no
+ * CognitiveOS, no hardware) and reports per-op p50/p99. Results can be
+ * written as JSON lines and compared against a stored baseline; the exit
+ * status is non-zero when any p50 regresses beyond the tolerance.
+ *
+ * The graph comes from storage::generate_graph (same generator as
+ * tools/graph_gen), or from unified_*.bin files with --graph-dir.
+ *
+ * Usage: melvin_bench [--nodes N] [--degree D] [--model ba|rmat] [--seed S]
+ *                     [--graph-dir DIR] [--filter substr] [--time-ms T]
+ *                     [--json out.json] [--baseline base.json] [--tolerance 0.15]
+ */
+
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <cstdio>
+#include <cstdlib>
+#include <cmath>
+#include "bench/bench_harness.h"
+#include "storage/synthetic_graph.h"
+#include "storage/graph_loader.h"
+#include "core/fields/parallel_graph_traversal.h"
+#include "core/fields/activation_field_unified.h"
+#include "core/reasoning/spreading_activation.h"
+#include "core/reasoning/predictor.h"
+#include "core/unified_intelligence.h"
+#include "crossmodal/cm_index.h"
+#include "crossmodal/cm_io.h"
+#include "crossmodal/cm_space.h"
+#include "cognitive_os/event_bus.h"
+#include "core/vision/vision_pipeline.h"
+#include "core/audio/vocal_synthesis.h"
+
+using namespace melvin;
+using namespace melvin::bench;
+
+namespace {
+
+struct Config {
+    int nodes = 20000;
+    int degree = 8;
+    storage::GraphModel model = storage::GraphModel::BA;
+    uint64_t seed = 42;
+    std::string graph_dir;
+    std::string filter;
+    double time_ms = 300.0;
+    std::string json_path;
+    std::string baseline_path;
+    double tolerance = 0.15;
+};
+
+bool parse_args(int argc, char** argv, Config& cfg) {
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        bool has_value = i + 1 < argc;
+        if (arg == "--nodes" && has_value) cfg.nodes = std::max(16, std::atoi(argv[++i]));
+        else if (arg == "--degree" && has_value) cfg.degree = std::max(1, std::atoi(argv[++i]));
+        else if (arg == "--model" && has_value) {
+            std::string model = argv[++i];
+            cfg.model = model == "rmat" ? storage::GraphModel::RMAT : storage::GraphModel::BA;
+        }
+        else if (arg == "--seed" && has_value) cfg.seed = std::strtoull(argv[++i], nullptr, 10);
+        else if (arg == "--graph-dir" && has_value) cfg.graph_dir = argv[++i];
+        else if (arg == "--filter" && has_value) cfg.filter = argv[++i];
+        else if (arg == "--time-ms" && has_value) cfg.time_ms = std::atof(argv[++i]);
+        else if (arg == "--json" && has_value) cfg.json_path = argv[++i];
+        else if (arg == "--baseline" && has_value) cfg.baseline_path = argv[++i];
+        else if (arg == "--tolerance" && has_value) cfg.tolerance = std::atof(argv[++i]);
+        else {
+            std::cerr << "Unknown argument: " << arg << "\n";
+            return false;
+        }
+    }
+    return true;
+}
+
+struct BenchGraph {
+    std::unordered_map<int, std::vector<std::pair<int, float>>> graph;
+    std::unordered_map<int, std::vector<float>> embeddings;
+    std::unordered_map<int, std::string> id_to_word;
+    std::unordered_map<std::string, int> word_to_id;
+    std::string nodes_path;
+    std::string edges_path;
+    std::string embeddings_path;
+};
+
+bool load_graph_files(BenchGraph& g) {
+    storage::GraphLoader loader;
+    std::unordered_map<int, float> priors;
+    return loader.LoadNodesBIN(g.nodes_path, g.id_to_word, g.word_to_id, priors) &&
+           loader.LoadEdgesBIN(g.edges_path, g.graph, true) &&
+           loader.LoadEmbeddingsBIN(g.embeddings_path, g.embeddings);
+}
+
+/**
+ * @brief Generate (and write, for the load benchmark) or load the graph
+ */
+bool prepare_graph(const Config& cfg, BenchGraph& g) {
+    if (!cfg.graph_dir.empty()) {
+        g.nodes_path = cfg.graph_dir + "/unified_nodes.bin";
+        g.edges_path = cfg.graph_dir + "/unified_edges.bin";
+        g.embeddings_path = cfg.graph_dir + "/unified_embeddings.bin";
+        return load_graph_files(g);
+    }
+
+    storage::SyntheticGraphParams params;
+    params.model = cfg.model;
+    params.nodes = cfg.nodes;
+    params.degree = cfg.degree;
+    params.seed = cfg.seed;
+    storage::GeneratedGraph generated = storage::generate_graph(params);
+    storage::to_adjacency(generated, g.graph, g.embeddings);
+    for (int id = 0; id < generated.nodes; id++) {
+        std::string word = storage::synthetic_label(id);
+        g.id_to_word[id] = word;
+        g.word_to_id[word] = id;
+    }
+
+    g.nodes_path = "/tmp/melvin_bench_nodes.bin";
+    g.edges_path = "/tmp/melvin_bench_edges.bin";
+    g.embeddings_path = "/tmp/melvin_bench_embeddings.bin";
+    if (!storage::write_nodes_bin(generated, g.nodes_path) ||
+        !storage::write_edges_bin(generated, g.edges_path) ||
+        !storage::write_embeddings_bin(generated, g.embeddings_path)) {
+        std::cerr << "⚠️  Cannot write graph files to /tmp; skipping graph.load_bin\n";
+        g.nodes_path.clear();
+    }
+    return true;
+}
+
+/**
+ * @brief Synthetic 640x480 frame with a few moving blocks
+ */
+cv::Mat make_frame(int t) {
+    cv::Mat frame(480, 640, CV_8UC3, cv::Scalar(40, 40, 40));
+    for (int i = 0; i < 4; i++) {
+        int x = (60 + i * 140 + t * 7) % 560;
+        int y = 80 + i * 90;
+        cv::rectangle(frame, cv::Rect(x, y, 60, 60),
+                      cv::Scalar(60 * i, 255 - 50 * i, 120), cv::FILLED);
+    }
+    return frame;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Config cfg;
+    if (!parse_args(argc, argv, cfg)) {
+        return 2;
+    }
+
+    BenchOptions opts;
+    opts.min_time_ms = cfg.time_ms;
+
+    std::cout << "📊 MELVIN microbenchmarks\n";
+    BenchGraph g;
+    if (!prepare_graph(cfg, g)) {
+        std::cerr << "❌ Cannot load graph from " << cfg.graph_dir << "\n";
+        return 2;
+    }
+    size_t edge_entries = 0;
+    for (const auto& [id, nbrs] : g.graph) edge_entries += nbrs.size();
+    cfg.nodes = static_cast<int>(g.id_to_word.size());
+    std::cout << "   Graph: " << cfg.nodes << " nodes, " << edge_entries / 2 << " edges"
+              << (cfg.graph_dir.empty() ? " (synthetic, seed " + std::to_string(cfg.seed) + ")"
+                                        : " (" + cfg.graph_dir + ")") << "\n\n";
+
+    std::vector<BenchResult> results;
+    auto run = [&](const std::string& name, const BenchOptions& o, auto&& fn) {
+        if (!cfg.filter.empty() && name.find(cfg.filter) == std::string::npos) return;
+        BenchResult r = run_bench(name, o, fn);
+        print_result(r);
+        results.push_back(r);
+    };
+
+    // Seeds spread over the id range (hubs are the low ids)
+    std::vector<int> seeds;
+    for (int i = 0; i < 8; i++) {
+        seeds.push_back(static_cast<int>((static_cast<uint64_t>(i) * 7919 + cfg.seed) % cfg.nodes));
+    }
+
+    // ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
+    // GRAPH LOAD
+    // ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
+
+    if (!g.nodes_path.empty()) {
+        BenchOptions load_opts = opts;
+        load_opts.warmup_iterations = 1;
+        load_opts.min_iterations = 3;
+        run("graph.load_bin", load_opts, [&]() {
+            BenchGraph loaded;
+            loaded.nodes_path = g.nodes_path;
+            loaded.edges_path = g.edges_path;
+            loaded.embeddings_path = g.embeddings_path;
+            load_graph_files(loaded);
+        });
+    }
+
+    // ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
+    // TRAVERSAL & FIELDS
+    // ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
+
+    size_t seed_index = 0;
+    run("traversal.spread", opts, [&]() {
+        // Fresh instance: convergence state carries across calls
+        fields::ParallelGraphTraversal traversal;
+        std::vector<int> origin = {seeds[seed_index++ % seeds.size()]};
+        auto activated = traversal.spread_activation(origin, g.graph, g.embeddings, 0.01f, 0.85f, 5000);
+        (void)activated;
+    });
+
+    reasoning::ActivationField field;
+    run("field.tick", opts, [&]() {
+        field.inject_energy(seeds[seed_index++ % seeds.size()], 1.0f);
+        field.tick(g.graph);
+    });
+
+    // Decay + spread + Hopfield over the whole graph as hybrid edges
+    fields::UnifiedActivationField unified;
+    static const std::vector<float> no_embedding;
+    for (const auto& [from, nbrs] : g.graph) {
+        auto from_emb = g.embeddings.find(from);
+        for (const auto& [to, weight] : nbrs) {
+            auto to_emb = g.embeddings.find(to);
+            unified.add_edge(from, to, fields::HybridEdge::Type::EXACT, weight,
+                             from_emb != g.embeddings.end() ? from_emb->second : no_embedding,
+                             to_emb != g.embeddings.end() ? to_emb->second : no_embedding);
+        }
+    }
+    run("field.unified_tick", opts, [&]() {
+        int seed = seeds[seed_index++ % seeds.size()];
+        auto emb = g.embeddings.find(seed);
+        unified.inject_energy(seed, 1.0f, emb != g.embeddings.end() ? emb->second : no_embedding);
+        unified.tick(0.05f);
+    });
+
+    // Post 256 messages round-robin over every type, then batch-drain each queue
+    std::vector<fields::FieldMessageBatch> batches(fields::MESSAGE_TYPE_COUNT);
+    std::vector<float> message_payload(128, 0.5f);
+    run("field.messages_256", opts, [&]() {
+        for (int i = 0; i < 256; i++) {
+            unified.post_message(static_cast<fields::MessageType>(i % fields::MESSAGE_TYPE_COUNT),
+                                 0, i, 1.0f, 1.0f, message_payload.data(), message_payload.size());
+        }
+        for (size_t t = 0; t < fields::MESSAGE_TYPE_COUNT; t++) {
+            batches[t].clear();
+            unified.drain_messages(static_cast<fields::MessageType>(t), batches[t]);
+        }
+    });
+
+    reasoning::Predictor predictor(128);
+    for (int i = 0; i + 3 < cfg.nodes && i < 20000; i++) {
+        const auto& nbrs = g.graph[i];
+        if (nbrs.empty()) continue;
+        predictor.record_sequence({i, nbrs[0].first}, nbrs.back().first);
+    }
+    run("predictor.predict_next", opts, [&]() {
+        int a = seeds[seed_index++ % seeds.size()];
+        const auto& nbrs = g.graph[a];
+        std::vector<int> context = {a};
+        if (!nbrs.empty()) context.push_back(nbrs[0].first);
+        auto predictions = predictor.predict_next(context, field, g.graph, g.embeddings, 5);
+        (void)predictions;
+    });
+
+    // ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
+    // REASONING
+    // ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
+
+    intelligence::UnifiedIntelligence reasoner;
+    reasoner.initialize(g.graph, g.embeddings, g.word_to_id, g.id_to_word);
+    run("reason", opts, [&]() {
+        int a = seeds[seed_index++ % seeds.size()];
+        int b = seeds[seed_index % seeds.size()];
+        auto result = reasoner.reason("what is " + g.id_to_word[a] + " and " + g.id_to_word[b]);
+        (void)result;
+    });
+
+    // ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
+    // CROSSMODAL INDEX
+    // ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
+
+    auto& space = crossmodal::CMSpace::Instance();
+    crossmodal::CMIndex index;
+    int index_size = std::min(cfg.nodes, 20000);
+    for (int i = 0; i < index_size; i++) {
+        index.Add(g.id_to_word[i], space.EncodeText(g.id_to_word[i]));
+    }
+    auto query = space.EncodeVision("red_ball");
+    run("cmindex.topk", opts, [&]() {
+        auto top = index.TopK(query, 10);
+        (void)top;
+    });
+    index.SetScan(crossmodal::CMIndex::Scan::FP32);
+    run("cmindex.topk_fp32", opts, [&]() {
+        auto top = index.TopK(query, 10);
+        (void)top;
+    });
+    index.SetScan(crossmodal::CMIndex::Scan::INT8);
+    std::vector<crossmodal::CMVec> working_set;
+    for (int i = 0; i < 7; i++) {
+        working_set.push_back(space.EncodeText(g.id_to_word[seeds[i % seeds.size()]]));
+    }
+    run("cmindex.topk_batch7", opts, [&]() {
+        auto top = index.TopKBatch(working_set, 10);
+        (void)top;
+    });
+    crossmodal::CMGrounder grounder;
+    for (int i = 0; i < index_size; i++) {
+        grounder.vision_index().Add(g.id_to_word[i], space.EncodeVision(g.id_to_word[i]));
+        grounder.bindings().Upsert({i % 1000, crossmodal::Binding::VISION, g.id_to_word[i], 0.5f, "bench"});
+    }
+    const std::string snapshot_path = "cm_snapshot.bench.bin";
+    if (crossmodal::CMIO::SaveSnapshot(snapshot_path, grounder)) {
+        run("cmio.snapshot_restore", opts, [&]() {
+            bool ok = crossmodal::CMIO::LoadSnapshot(snapshot_path, grounder);
+            (void)ok;
+        });
+        std::remove(snapshot_path.c_str());
+    }
+
+    // ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
+    // EVENT BUS
+    // ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
+
+    cognitive_os::EventBus bus(1024);
+    cognitive_os::VisionEvent vision_event;
+    vision_event.obj_ids = {1, 2, 3};
+    vision_event.bbox = {0.0f, 0.0f, 1.0f, 1.0f};
+    run("bus.publish_consume_64", opts, [&]() {
+        for (int i = 0; i < 64; i++) {
+            bus.publish(cognitive_os::topic_ids::VISION_EVENTS, vision_event);
+        }
+        size_t n = bus.consume<cognitive_os::VisionEvent>(cognitive_os::topic_ids::VISION_EVENTS,
+            [](cognitive_os::TypedEvent<cognitive_os::VisionEvent>& ev) { (void)ev; });
+        (void)n;
+    });
+
+    // ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
+    // VISION (synthetic frames)
+    // ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
+
+    vision::Stage1_VisionInput stage1;
+    vision::Stage2_Tokenize stage2;
+    vision::Stage3_Connect stage3;
+    vision::Stage5_Generalize stage5;
+    std::vector<cv::Mat> frames;
+    for (int t = 0; t < 16; t++) frames.push_back(make_frame(t));
+
+    int frame_index = 0;
+    cv::Point2f focus(320.0f, 240.0f);
+    run("vision.input", opts, [&]() {
+        auto out = stage1.process(frames[frame_index++ % frames.size()], focus);
+        (void)out;
+    });
+
+    auto input_out = stage1.process(frames[0], focus);
+    run("vision.tokenize", opts, [&]() {
+        auto out = stage2.process(input_out);
+        (void)out;
+    });
+
+    auto tokenize_out = stage2.process(input_out);
+    run("vision.connect", opts, [&]() {
+        auto out = stage3.process(tokenize_out);
+        (void)out;
+    });
+
+    auto connect_out = stage3.process(tokenize_out);
+    run("vision.generalize", opts, [&]() {
+        auto out = stage5.process(connect_out);
+        (void)out;
+    });
+
+    // ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
+    // VOCAL SYNTHESIS
+    // ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
+
+    audio::VocalSynthesizer synthesizer(16000);
+    run("vocal.synthesize_text", opts, [&]() {
+        auto samples = synthesizer.synthesize_text("hello melvin");
+        (void)samples;
+    });
+
+    // ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
+    // OUTPUT & BASELINE
+    // ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
+
+    if (!cfg.json_path.empty()) {
+        if (write_results(cfg.json_path, results)) {
+            std::cout << "\n💾 Results written to " << cfg.json_path << "\n";
+        } else {
+            std::cerr << "❌ Cannot write " << cfg.json_path << "\n";
+            return 2;
+        }
+    }
+
+    if (!cfg.baseline_path.empty()) {
+        auto baseline = read_results(cfg.baseline_path);
+        if (baseline.empty()) {
+            std::cerr << "❌ No results in baseline " << cfg.baseline_path << "\n";
+            return 2;
+        }
+        int regressions = compare_to_baseline(results, baseline, cfg.tolerance);
+        if (regressions > 0) {
+            std::cout << "\n❌ " << regressions << " benchmark(s) regressed\n";
+            return 1;
+        }
+        std::cout << "\n✅ No regressions\n";
+    }
+
+    return 0;
+}
@@ -0,0 +1,137 @@
+/**
+ * @file candidate_pool.cpp
+ * @brief Implementation of the candidate sampling pool
+ */
+
+#include "candidate_pool.h"
+#include <algorithm>
+
+namespace melvin {
+namespace cognitive_os {
+
+CandidatePool::CandidatePool()
+    : melvin_id_(-1),
+      intelligence_id_(-1),
+      vocab_size_(0),
+      built_(false),
+      rng_(std::random_device{}()) {}
+
+void CandidatePool::build(const std::unordered_map<int, std::string>& id_to_word,
+                          const std::unordered_map<int, int>* node_degree,
+                          int min_degree) {
+    ids_.clear();
+    prob_.clear();
+    alias_.clear();
+    melvin_id_ = -1;
+    intelligence_id_ = -1;
+
+    std::vector<double> weights;
+    ids_.reserve(id_to_word.size());
+    weights.reserve(id_to_word.size());
+
+    for (const auto& [id, word] : id_to_word) {
+        if (word == "melvin") melvin_id_ = id;
+        else if (word == "intelligence") intelligence_id_ = id;
+
+        double weight = 1.0;
+        if (node_degree) {
+            auto it = node_degree->find(id);
+            if (it != node_degree->end()) {
+                if (it->second < min_degree) continue;
+                weight = 1.0 / static_cast<double>(std::max(1, it->second));
+            }
+        }
+        ids_.push_back(id);
+        weights.push_back(weight);
+    }
+
+    vocab_size_ = id_to_word.size();
+    built_ = true;
+
+    // Vose's alias method: O(n) construction, O(1) draws
+    size_t n = ids_.size();
+    if (n == 0) return;
+
+    double total = 0.0;
+    for (double w : weights) total += w;
+
+    std::vector<double> scaled(n);
+    std::vector<uint32_t> small, large;
+    for (size_t i = 0; i < n; i++) {
+        scaled[i] = weights[i] * static_cast<double>(n) / total;
+        (scaled[i] < 1.0 ? small : large).push_back(static_cast<uint32_t>(i));
+    }
+
+    prob_.assign(n, 1.0f);
+    alias_.resize(n);
+    for (size_t i = 0; i < n; i++) alias_[i] = static_cast<uint32_t>(i);
+
+    while (!small.empty() && !large.empty()) {
+        uint32_t s = small.back(); small.pop_back();
+        uint32_t l = large.back(); large.pop_back();
+        prob_[s] = static_cast<float>(scaled[s]);
+        alias_[s] = l;
+        scaled[l] = (scaled[l] + scaled[s]) - 1.0;
+        (scaled[l] < 1.0 ? small : large).push_back(l);
+    }
+    // Leftovers (numerical residue) keep probability 1
+}
+
+// ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
+// EXCLUSIONS
+// ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
+
+void CandidatePool::blacklist(int id, double until) {
+    if (id < 0) return;
+    double& expiry = blacklist_until_[id];
+    expiry = std::max(expiry, until);
+    blacklist_bits_.set(id);
+}
+
+void CandidatePool::expire(double now) {
+    for (auto it = blacklist_until_.begin(); it != blacklist_until_.end(); ) {
+        if (it->second < now) {
+            blacklist_bits_.reset(it->first);
+            it = blacklist_until_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+void CandidatePool::push_ior(int id) {
+    if (id < 0 || ior_bits_.test(id)) return;
+    ior_.push_back(id);
+    ior_bits_.set(id);
+    while (ior_.size() > MAX_IOR) {
+        ior_bits_.reset(ior_.front());
+        ior_.pop_front();
+    }
+}
+
+void CandidatePool::set_active(const std::vector<int>& ids) {
+    for (int id : active_) active_bits_.reset(id);
+    active_ = ids;
+    for (int id : active_) active_bits_.set(id);
+}
+
+// ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
+// SAMPLING
+// ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
+
+int CandidatePool::sample(int max_attempts) {
+    if (ids_.empty()) return -1;
+
+    std::uniform_int_distribution<size_t> column(0, ids_.size() - 1);
+    std::uniform_real_distribution<float> coin(0.0f, 1.0f);
+
+    for (int attempt = 0; attempt < max_attempts; attempt++) {
+        size_t i = column(rng_);
+        int id = ids_[coin(rng_) < prob_[i] ? i : alias_[i]];
+        if (!excluded(id)) return id;
+    }
+    return -1;
+}
+
+} // namespace cognitive_os
+} // namespace melvin
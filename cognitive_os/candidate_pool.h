@@ -0,0 +1,159 @@
+/**
+ * @file candidate_pool.h
+ * @brief Precomputed sampling pool for autonomous query generation
+ *
+ * The vocabulary is indexed once into an alias table (Vose) weighted by
+ * node degree, so drawing a diversification candidate is O(1) no matter
+ * how large the graph is. Blacklisted, recently used (inhibition of
+ * return) and currently active concepts are tracked in bitsets indexed
+ * by node ID and rejected on draw instead of being filtered by scanning.
+ */
+
+#ifndef MELVIN_CANDIDATE_POOL_H
+#define MELVIN_CANDIDATE_POOL_H
+
+#include <vector>
+#include <deque>
+#include <string>
+#include <unordered_map>
+#include <random>
+#include <cstdint>
+
+namespace melvin {
+namespace cognitive_os {
+
+/**
+ * @brief Growable bitset over non-negative node IDs
+ */
+class NodeBitset {
+public:
+    void set(int id) {
+        if (id < 0) return;
+        size_t word = static_cast<size_t>(id) >> 6;
+        if (word >= bits_.size()) bits_.resize(word + 1, 0);
+        bits_[word] |= uint64_t(1) << (id & 63);
+    }
+
+    void reset(int id) {
+        if (id < 0) return;
+        size_t word = static_cast<size_t>(id) >> 6;
+        if (word < bits_.size()) bits_[word] &= ~(uint64_t(1) << (id & 63));
+    }
+
+    bool test(int id) const {
+        if (id < 0) return false;
+        size_t word = static_cast<size_t>(id) >> 6;
+        return word < bits_.size() && (bits_[word] >> (id & 63)) & 1;
+    }
+
+private:
+    std::vector<uint64_t> bits_;
+};
+
+/**
+ * @brief Degree-weighted candidate pool with O(1) exclusion checks
+ */
+class CandidatePool {
+public:
+    CandidatePool();
+
+    /**
+     * @brief Index the vocabulary (O(V), done once per vocabulary change)
+     *
+     * Nodes with a known degree below min_degree are not eligible. The
+     * remaining nodes are weighted by inverse degree so sparsely connected
+     * concepts are preferred (curiosity bias).
+     */
+    void build(const std::unordered_map<int, std::string>& id_to_word,
+               const std::unordered_map<int, int>* node_degree,
+               int min_degree = 4);
+
+    /**
+     * @brief True if the vocabulary size changed since the last build
+     */
+    bool stale(const std::unordered_map<int, std::string>& id_to_word) const {
+        return !built_ || id_to_word.size() != vocab_size_;
+    }
+
+    /**
+     * @brief Force a rebuild on the next stale() check (word or degree map replaced)
+     */
+    void invalidate() { built_ = false; }
+
+    size_t size() const { return ids_.size(); }
+
+    // Well-known IDs cached at build time (-1 if absent)
+    int melvin_id() const { return melvin_id_; }
+    int intelligence_id() const { return intelligence_id_; }
+
+    // ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
+    // EXCLUSIONS
+    // ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
+
+    /**
+     * @brief Exclude a concept until a timestamp (extends an existing entry)
+     */
+    void blacklist(int id, double until);
+
+    /**
+     * @brief Drop expired blacklist entries (O(blacklisted))
+     */
+    void expire(double now);
+
+    /**
+     * @brief Record a concept as recently used (bounded FIFO)
+     */
+    void push_ior(int id);
+
+    /**
+     * @brief Replace the set of currently active concepts (O(previous + new))
+     */
+    void set_active(const std::vector<int>& ids);
+
+    bool blacklisted(int id) const { return blacklist_bits_.test(id); }
+    bool in_ior(int id) const { return ior_bits_.test(id); }
+    bool active(int id) const { return active_bits_.test(id); }
+    bool excluded(int id) const { return blacklisted(id) || in_ior(id) || active(id); }
+
+    // ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
+    // SAMPLING
+    // ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
+
+    /**
+     * @brief Draw one non-excluded candidate
+     *
+     * O(1) per attempt; excluded draws are rejected and retried up to
+     * max_attempts times.
+     *
+     * @return Node ID, or -1 if the pool is empty or every attempt was rejected
+     */
+    int sample(int max_attempts = 16);
+
+    static constexpr size_t MAX_IOR = 10;
+
+private:
+    // Alias table over eligible nodes
+    std::vector<int> ids_;
+    std::vector<float> prob_;
+    std::vector<uint32_t> alias_;
+
+    int melvin_id_;
+    int intelligence_id_;
+    size_t vocab_size_;
+    bool built_;
+
+    // Exclusions
+    std::unordered_map<int, double> blacklist_until_;
+    NodeBitset blacklist_bits_;
+    std::deque<int> ior_;
+    NodeBitset ior_bits_;
+    std::vector<int> active_;
+    NodeBitset active_bits_;
+
+    std::mt19937 rng_;
+};
+
+} // namespace cognitive_os
+} // namespace melvin
+
+#endif // MELVIN_CANDIDATE_POOL_H
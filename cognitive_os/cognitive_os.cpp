@@ -4,6 +4,7 @@
  */
 
 #include "cognitive_os.h"
+#include "core/metrics/trace.h"
 #include <chrono>
 #include <thread>
 #include <algorithm>
@@ -13,7 +14,10 @@
 namespace melvin {
 namespace cognitive_os {
 
-CognitiveOS::CognitiveOS() : field_(nullptr), intelligence_(nullptr) {
+CognitiveOS::CognitiveOS() : field_(nullptr), intelligence_(nullptr), executor_(0, &cpu_) {
+    for (int i = 0; i < BUILTIN_SERVICE_COUNT; i++) task_ids_[i] = -1;
+    last_evolution_time_ = get_timestamp();
+    
     // Initialize arousal to balanced state
     arousal_.noradrenaline = 0.5f;
     arousal_.dopamine = 0.5f;
@@ -30,6 +34,9 @@ void CognitiveOS::attach(
 ) {
     intelligence_ = intelligence;
     field_ = field;
+    if (intelligence_) {
+        intelligence_confidence_.store(intelligence_->metrics().confidence, std::memory_order_relaxed);
+    }
 }
 
 void CognitiveOS::start() {
@@ -39,14 +46,16 @@ void CognitiveOS::start() {
     
     running_.store(true, std::memory_order_relaxed);
     
-    // Start scheduler thread
-    scheduler_thread_ = std::thread([this]() {
-        scheduler_loop();
-    });
+    // Start service executor
+    if (!tasks_registered_) {
+        register_tasks();
+        tasks_registered_ = true;
+    }
+    executor_.start();
     
     std::cout << "✅ Cognitive OS started\n";
     std::cout << "   Services running at natural frequencies\n";
-    std::cout << "   Scheduler: 50 Hz (20ms ticks)\n";
+    std::cout << "   Scheduler: 50 Hz control tick, EDF service executor\n";
 }
 
 void CognitiveOS::stop() {
@@ -56,42 +65,67 @@ void CognitiveOS::stop() {
     
     running_.store(false, std::memory_order_relaxed);
     
-    if (scheduler_thread_.joinable()) {
-        scheduler_thread_.join();
-    }
+    executor_.stop();
     
     std::cout << "✅ Cognitive OS stopped\n";
 }
 
 void CognitiveOS::join() {
-    if (scheduler_thread_.joinable()) {
-        scheduler_thread_.join();
-    }
+    executor_.join();
 }
 
 // ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
-// SCHEDULER LOOP (50 Hz - 20ms ticks)
+// SCHEDULER (EDF executor, 50 Hz control tick)
 // ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
 
-void CognitiveOS::scheduler_loop() {
-    const auto tick_period = std::chrono::milliseconds(20);  // 50 Hz
-    auto next_tick = std::chrono::steady_clock::now();
-    
-    while (running_.load(std::memory_order_relaxed)) {
-        auto start = std::chrono::steady_clock::now();
-        
-        // Run one tick
-        run_tick();
-        
-        // Sleep until next tick
-        next_tick += tick_period;
-        std::this_thread::sleep_until(next_tick);
-        
-        total_ticks_++;
-    }
+void CognitiveOS::register_tasks() {
+    // Exclusion groups: services that mutate the same state never overlap.
+    // Intelligence: reason(), learn(), intelligence metrics and every genome
+    // read or write (attention tunes the baseline params). Working memory:
+    // attention reads the slots WM rewrites. The control task is in no
+    // group: it touches neither, and exchanges arousal targets and
+    // confidence with the intelligence tasks through atomics.
+    constexpr uint32_t GROUP_INTELLIGENCE = 1u << 0;
+    constexpr uint32_t GROUP_WM = 1u << 1;
+    
+    auto add = [this](int slot, float period_ms, float budget_ms, Criticality crit,
+                      uint32_t group, std::function<void(float)> fn) {
+        TaskSpec spec;
+        spec.name = builtin_service_name(slot);
+        spec.period_ms = period_ms;
+        spec.budget_ms = budget_ms;
+        spec.criticality = crit;
+        spec.exclusion_group = group;
+        spec.account_slot = slot;
+        spec.fn = std::move(fn);
+        task_ids_[slot] = executor_.add_task(spec);
+    };
+    
+    // Control tick: field metrics, arousal, budgets, KPIs (50 Hz)
+    TaskSpec control;
+    control.name = "control";
+    control.period_ms = 20.0f;
+    control.budget_ms = 1.0f;
+    control.criticality = Criticality::HIGH;
+    control.fn = [this](float) { run_tick(); };
+    control_task_ = executor_.add_task(control);
+    
+    add(SVC_COGNITION, 40.0f, budgets_.cognition, Criticality::HIGH, GROUP_INTELLIGENCE,
+        [this](float b) { tick_cognition(b); });
+    add(SVC_ATTENTION, 20.0f, budgets_.attention, Criticality::NORMAL, GROUP_WM | GROUP_INTELLIGENCE,
+        [this](float b) { tick_attention(b); });
+    add(SVC_WORKING_MEMORY, 40.0f, budgets_.wm, Criticality::NORMAL, GROUP_WM,
+        [this](float b) { tick_working_memory(b); });
+    add(SVC_LEARNING, 100.0f, budgets_.learning, Criticality::LOW, GROUP_INTELLIGENCE,
+        [this](float b) { tick_learning(b); });
+    add(SVC_REFLECTION, 200.0f, budgets_.reflection, Criticality::LOW, GROUP_INTELLIGENCE,
+        [this](float b) { tick_reflection(b); });
+    add(SVC_FIELD_MAINTENANCE, 20.0f, 0.5f, Criticality::NORMAL, 0,
+        [this](float b) { tick_field_maintenance(b); });
 }
 
 void CognitiveOS::run_tick() {
+    MELVIN_TRACE_SCOPE("os.run_tick");
     auto tick_start = std::chrono::high_resolution_clock::now();
     
     // ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
@@ -110,7 +144,7 @@ void CognitiveOS::run_tick() {
     metrics.confidence = 0.0f;  // Computed by cognition
     
     // Publish to bus
-    bus_.publish(topics::FIELD_METRICS, metrics);
+    bus_.publish(topic_ids::FIELD_METRICS, metrics);
     
     // ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
     // 2. COMPUTE AROUSAL (neuromodulator analog)
@@ -126,40 +160,26 @@ void CognitiveOS::run_tick() {
     adapt_budgets(metrics, cpu_load);
     
     // ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
-    // 4. UPDATE GENOME FROM AROUSAL
+    // 4. PUBLISH GENOME TARGETS FROM AROUSAL
     // ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
     
-    update_genome_from_arousal();
+    // Temperature ← noradrenaline (high arousal = more exploration)
+    target_temperature_.store(0.5f + arousal_.noradrenaline, std::memory_order_relaxed);
+    
+    // Semantic threshold ← acetylcholine (high Ach = higher threshold = focus)
+    target_semantic_threshold_.store(0.1f + 0.3f * arousal_.acetylcholine, std::memory_order_relaxed);
     
     // ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
-    // 5. RUN SERVICES (inline for now, at varying rates)
+    // 5. PUSH BUDGETS AND LOAD TO THE EXECUTOR
     // ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
     
-    // Cognition: 30 Hz (run every 1-2 ticks)
-    if (total_ticks_ % 2 == 0) {
-        tick_cognition(budgets_.cognition);
-    }
-    
-    // Attention: 60 Hz (run every tick)
-    tick_attention(budgets_.attention);
-    
-    // Working Memory: 30 Hz
-    if (total_ticks_ % 2 == 0) {
-        tick_working_memory(budgets_.wm);
-    }
-    
-    // Learning: 10 Hz (run every 5 ticks)
-    if (total_ticks_ % 5 == 0) {
-        tick_learning(budgets_.learning);
-    }
-    
-    // Reflection: 5 Hz (run every 10 ticks)
-    if (total_ticks_ % 10 == 0) {
-        tick_reflection(budgets_.reflection);
-    }
-    
-    // Field maintenance: every tick
-    tick_field_maintenance(0.5f);
+    // Services themselves run as EDF tasks on the executor's workers
+    executor_.set_load(cpu_load);
+    executor_.set_budget(task_ids_[SVC_COGNITION], budgets_.cognition);
+    executor_.set_budget(task_ids_[SVC_ATTENTION], budgets_.attention);
+    executor_.set_budget(task_ids_[SVC_WORKING_MEMORY], budgets_.wm);
+    executor_.set_budget(task_ids_[SVC_LEARNING], budgets_.learning);
+    executor_.set_budget(task_ids_[SVC_REFLECTION], budgets_.reflection);
     
     // ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
     // 6. LOG METRICS
@@ -180,10 +200,17 @@ void CognitiveOS::run_tick() {
     kpis.cpu_usage = cpu_load;
     kpis.gpu_usage = 0.0f;
     kpis.dropped_msgs = bus_.dropped_messages();
-    kpis.services_active = 6;
-    kpis.avg_service_load = cpu_load;
+    kpis.services_active = BUILTIN_SERVICE_COUNT;
+    kpis.deadline_misses = executor_.total_deadline_misses();
+    kpis.degrade_level = executor_.degrade_level();
+    kpis.avg_service_load = cpu_.avg_service_load();
+    for (int i = 0; i < BUILTIN_SERVICE_COUNT; i++) {
+        kpis.service_load[i] = cpu_.service_load(i);
+    }
     
     metrics_.log(kpis);
+    
+    total_ticks_.fetch_add(1, std::memory_order_relaxed);
 }
 
 // ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
@@ -196,7 +223,7 @@ void CognitiveOS::compute_arousal(const FieldMetrics& metrics) {
     
     // Dopamine: high when confidence high (from intelligence)
     if (intelligence_) {
-        arousal_.dopamine = intelligence_->metrics().confidence;
+        arousal_.dopamine = intelligence_confidence_.load(std::memory_order_relaxed);
     }
     
     // Acetylcholine: high when need focus (low coherence)
@@ -204,16 +231,19 @@ void CognitiveOS::compute_arousal(const FieldMetrics& metrics) {
 }
 
 void CognitiveOS::update_genome_from_arousal() {
+    // Intelligence group only: applies the targets the control tick published
     if (!intelligence_) return;
     
     auto& genome = const_cast<melvin::evolution::DynamicGenome&>(intelligence_->genome());
     auto& params = genome.reasoning_params();
-    
-    // Temperature ← noradrenaline (high arousal = more exploration)
-    params.temperature = 0.5f + arousal_.noradrenaline;
-    
-    // Semantic threshold ← acetylcholine (high Ach = higher threshold = focus)
-    params.semantic_threshold = 0.1f + 0.3f * arousal_.acetylcholine;
+    params.temperature = target_temperature_.load(std::memory_order_relaxed);
+    params.semantic_threshold = target_semantic_threshold_.load(std::memory_order_relaxed);
+}
+
+void CognitiveOS::note_intelligence_metrics() {
+    // Intelligence group only: hands the control tick its confidence input
+    if (!intelligence_) return;
+    intelligence_confidence_.store(intelligence_->metrics().confidence, std::memory_order_relaxed);
 }
 
 // ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
@@ -224,14 +254,20 @@ void CognitiveOS::adapt_budgets(const FieldMetrics& metrics, float cpu_load) {
     // Reset to defaults
     budgets_ = ServiceBudgets();
     
-    // If low confidence, give more time to cognition
-    if (intelligence_ && intelligence_->metrics().confidence < 0.4f) {
-        budgets_.cognition += 2.0f;
+    // If low confidence, give more time to cognition (more when cores are idle)
+    if (intelligence_ && intelligence_confidence_.load(std::memory_order_relaxed) < 0.4f) {
+        budgets_.cognition += (cpu_load < 0.3f) ? 4.0f : 2.0f;
     }
     
-    // If high CPU load, reduce learning
+    // If high CPU load, reduce background services first
     if (cpu_load > 0.85f) {
         budgets_.learning -= 1.0f;
+        budgets_.reflection = std::max(0.25f, budgets_.reflection - 0.5f);
+    }
+    
+    // Services measured running past their budget under load lose their bonus
+    if (cpu_load > 0.6f && cpu_.service_cpu_ms(SVC_COGNITION) > budgets_.cognition) {
+        budgets_.cognition = ServiceBudgets().cognition;
     }
     
     // If high entropy, increase reflection
@@ -245,15 +281,30 @@ void CognitiveOS::adapt_budgets(const FieldMetrics& metrics, float cpu_load) {
 // ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
 
 void CognitiveOS::tick_cognition(float budget_ms) {
-    // Check for queries
-    auto events = bus_.poll(topics::COG_QUERY);
+    MELVIN_TRACE_SCOPE("os.tick_cognition");
+    // The budget bounds the whole tick: reasoning returns its best answer so far at the deadline.
+    // External queries are served first, each with an even share of what is left; the autonomous
+    // query only gets the remainder.
+    auto tick_deadline = std::chrono::steady_clock::now() +
+        std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+            std::chrono::duration<float, std::milli>(budget_ms));
     
-    for (const auto& event : events) {
-        auto query = event.get<CogQuery>();
-        if (!query || !intelligence_) continue;
+    update_genome_from_arousal();
+    
+    // Check for queries (move text out of the ring; reasoning runs after the slot is released)
+    std::vector<std::string> queries;
+    bus_.consume<CogQuery>(topic_ids::COG_QUERY, [&](TypedEvent<CogQuery>& ev) {
+        queries.push_back(std::move(ev.data.text));
+    });
+    
+    for (size_t i = 0; i < queries.size(); ++i) {
+        if (!intelligence_) continue;
         
-        // Run reasoning
-        auto result = intelligence_->reason(query->text);
+        // Run reasoning with this query's share of the remaining budget
+        auto start = std::chrono::steady_clock::now();
+        auto remaining = std::max(tick_deadline - start, std::chrono::steady_clock::duration::zero());
+        auto deadline = start + remaining / static_cast<long>(queries.size() - i);
+        auto result = intelligence_->reason(queries[i], deadline);
         
         // Publish answer
         CogAnswer answer;
@@ -261,8 +312,9 @@ void CognitiveOS::tick_cognition(float budget_ms) {
         answer.text = result.answer;
         answer.reasoning_chain = result.reasoning_path;
         answer.confidence = result.confidence;
+        answer.truncated = result.truncated;
         
-        bus_.publish(topics::COG_ANSWER, answer);
+        bus_.publish(topic_ids::COG_ANSWER, answer);
         
         // Activate result concepts in field
         for (const auto& [concept, score] : result.top_concepts) {
@@ -274,7 +326,9 @@ void CognitiveOS::tick_cognition(float budget_ms) {
     // Autonomous outputs: generate queries from baseline activity (continuous)
     if (intelligence_ && field_) {
         double now = get_timestamp();
-        if (now - last_internal_query_time_ > 1.0) { // ~1 Hz thinking cadence
+        // ~1 Hz thinking cadence; deferred to the next tick if external queries used the budget
+        if (now - last_internal_query_time_ > 1.0 &&
+            std::chrono::steady_clock::now() < tick_deadline) {
             // Get currently active nodes from field
             auto active_nodes = field_->get_active(0.1f);  // Lower threshold to catch baseline
             
@@ -284,35 +338,28 @@ void CognitiveOS::tick_cognition(float budget_ms) {
                 std::stringstream query_builder;
                 int word_count = 0;
                 
-                // Loop-control state (static across ticks)
-                static std::deque<int> ior_concepts; // inhibition of return (recently used)
-                static std::unordered_map<int, double> temp_blacklist_until; // concept_id -> expiry ts
-                static std::vector<std::string> last_lines;
+                // Echo filter history (kept across ticks)
+                auto& last_lines = echo_history_;
                 if (last_lines.size() > 10) last_lines.erase(last_lines.begin());
-                // Time-limited self-dampers for {melvin, intelligence}
+
                 if (id_to_word_) {
-                    int melvin_id = -1, intel_id = -1;
-                    for (const auto& kv : *id_to_word_) {
-                        if (kv.second == "melvin") melvin_id = kv.first;
-                        else if (kv.second == "intelligence") intel_id = kv.first;
+                    // Vocabulary is indexed once; rebuilt only when it changes size
+                    if (candidates_.stale(*id_to_word_)) {
+                        candidates_.build(*id_to_word_, node_degree_);
                     }
+                    
+                    // Time-limited self-dampers for {melvin, intelligence}
                     double window_s = large_graph_ ? 60.0 : 300.0;
-                    if (melvin_id >= 0) temp_blacklist_until[melvin_id] = std::max(temp_blacklist_until[melvin_id], now + window_s);
-                    if (intel_id >= 0) temp_blacklist_until[intel_id] = std::max(temp_blacklist_until[intel_id], now + window_s);
-                }
-                // Expire blacklist
-                for (auto it = temp_blacklist_until.begin(); it != temp_blacklist_until.end(); ) {
-                    if (it->second < now) it = temp_blacklist_until.erase(it); else ++it;
-                }
+                    candidates_.blacklist(candidates_.melvin_id(), now + window_s);
+                    candidates_.blacklist(candidates_.intelligence_id(), now + window_s);
+                    candidates_.expire(now);
+                    candidates_.set_active(active_nodes);
 
-                if (id_to_word_) {
                     // Limit to 3 words max
                     int max_words = 2; // keep internal queries short
-                    // Seed from active nodes excluding IOR and blacklist
+                    // Seed from active nodes excluding IOR and blacklist (O(1) bitset checks)
                     for (int node_id : active_nodes) {
-                        if ((int)ior_concepts.size() > 10) ior_concepts.pop_front();
-                        bool in_ior = std::find(ior_concepts.begin(), ior_concepts.end(), node_id) != ior_concepts.end();
-                        if (temp_blacklist_until.count(node_id) || in_ior) continue;
+                        if (candidates_.blacklisted(node_id) || candidates_.in_ior(node_id)) continue;
                         auto it = id_to_word_->find(node_id);
                         if (it != id_to_word_->end()) {
                             if (word_count > 0) query_builder << " ";
@@ -321,36 +368,17 @@ void CognitiveOS::tick_cognition(float budget_ms) {
                             if (word_count >= max_words) break;
                         }
                     }
-                    // Diversify: sample from non-recent, non-active pool (top-k=32, require min out-degree 4)
+                    // Diversify: draw from the non-recent, non-active pool (min out-degree 4,
+                    // inverse-degree weighted for curiosity)
                     if (word_count < max_words) {
-                        std::vector<int> candidates; candidates.reserve(64);
-                        for (const auto& kv : *id_to_word_) {
-                            int nid = kv.first;
-                            if (temp_blacklist_until.count(nid)) continue;
-                            if (std::find(active_nodes.begin(), active_nodes.end(), nid) != active_nodes.end()) continue;
-                            if (std::find(ior_concepts.begin(), ior_concepts.end(), nid) != ior_concepts.end()) continue;
-                            if (node_degree_ && node_degree_->count(nid) && node_degree_->at(nid) < 4) continue;
-                            candidates.push_back(nid);
-                            if ((int)candidates.size() >= 32) break;
-                        }
-                        if (!candidates.empty()) {
-                            int pick = candidates[0];
-                            if (node_degree_ && !candidates.empty()) {
-                                // Curiosity bias: prefer lower-degree nodes (+0.15 implicit by picking min degree)
-                                pick = *std::min_element(candidates.begin(), candidates.end(), [&](int a, int b){
-                                    int da = node_degree_->count(a) ? node_degree_->at(a) : 0;
-                                    int db = node_degree_->count(b) ? node_degree_->at(b) : 0;
-                                    return da < db;
-                                });
-                            } else {
-                                pick = candidates[std::min((int)candidates.size()-1, rand() % (int)candidates.size())];
-                            }
+                        int pick = candidates_.sample();
+                        if (pick >= 0) {
                             auto it2 = id_to_word_->find(pick);
                             if (it2 != id_to_word_->end()) {
                                 if (word_count > 0) query_builder << " ";
                                 query_builder << it2->second;
                                 word_count++;
-                                ior_concepts.push_back(pick);
+                                candidates_.push_ior(pick);
                             }
                         }
                     }
@@ -362,7 +390,7 @@ void CognitiveOS::tick_cognition(float budget_ms) {
                     : "melvin intelligence thinking";
                 
                 // Run FULL reasoning pipeline with real concepts
-                auto result = intelligence_->reason(internal_query);
+                auto result = intelligence_->reason(internal_query, tick_deadline);
                 
                 // Echo filter: suppress highly repetitive lines (Jaccard with last 5 > 0.7)
                 auto compute_jaccard = [](const std::string& a, const std::string& b){
@@ -386,15 +414,19 @@ void CognitiveOS::tick_cognition(float budget_ms) {
                 answer.text = (echo ? "..." : (result.answer.empty() ? "..." : result.answer));
                 answer.reasoning_chain = result.reasoning_path;
                 answer.confidence = result.confidence;
-                if (!echo) bus_.publish(topics::COG_ANSWER, answer);
+                answer.truncated = result.truncated;
+                if (!echo) bus_.publish(topic_ids::COG_ANSWER, answer);
             }
             
             last_internal_query_time_ = now;
         }
     }
+    
+    note_intelligence_metrics();
 }
 
 void CognitiveOS::tick_attention(float budget_ms) {
+    MELVIN_TRACE_SCOPE("os.tick_attention");
     (void)budget_ms;
     if (!field_ || !intelligence_) return;
     
@@ -447,6 +479,7 @@ void CognitiveOS::tick_attention(float budget_ms) {
 }
 
 void CognitiveOS::tick_working_memory(float budget_ms) {
+    MELVIN_TRACE_SCOPE("os.tick_working_memory");
     // Decay existing slots
     for (auto& slot : working_memory_) {
         slot.strength *= 0.95f;
@@ -490,10 +523,11 @@ void CognitiveOS::tick_working_memory(float budget_ms) {
         wm.strengths.push_back(slot.strength);
     }
     
-    bus_.publish(topics::WM_CONTEXT, wm);
+    bus_.publish(topic_ids::WM_CONTEXT, wm);
 }
 
 void CognitiveOS::tick_learning(float budget_ms) {
+    MELVIN_TRACE_SCOPE("os.tick_learning");
     if (!intelligence_) return;
     
     // ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
@@ -501,7 +535,7 @@ void CognitiveOS::tick_learning(float budget_ms) {
     // ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
     
     // Check for motor feedback (success/failure from actions)
-    auto motor_events = bus_.poll(topics::MOTOR_FEEDBACK);
+    auto motor_events = bus_.poll(topic_ids::MOTOR_FEEDBACK);
     for (const auto& event : motor_events) {
         // If feedback event type exists, extract success/failure
         // For now, assume positive feedback
@@ -509,7 +543,7 @@ void CognitiveOS::tick_learning(float budget_ms) {
     }
     
     // Check for cognitive feedback (user corrections)
-    auto cognitive_feedback = bus_.poll(topics::COG_FEEDBACK);
+    auto cognitive_feedback = bus_.poll(topic_ids::COG_FEEDBACK);
     for (const auto& event : cognitive_feedback) {
         // Would extract correct/incorrect from feedback event
         intelligence_->learn(true);  // TODO: Extract actual correctness from event
@@ -517,24 +551,26 @@ void CognitiveOS::tick_learning(float budget_ms) {
     
     // Hebbian learning is automatically applied after each reasoning step
     // (see UnifiedIntelligence::reason() → apply_hebbian_learning())
+    
+    note_intelligence_metrics();
 }
 
 void CognitiveOS::tick_reflection(float budget_ms) {
+    MELVIN_TRACE_SCOPE("os.tick_reflection");
     if (!intelligence_) return;
     
     // ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
     // CONTINUOUS EVOLUTION: Self-improve when no prompt
     // ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
     
-    static double last_evolution_time = get_timestamp();
     double now = get_timestamp();
-    float dt = static_cast<float>(now - last_evolution_time);
+    float dt = static_cast<float>(now - last_evolution_time_);
     
     // Every reflection tick (~5Hz), evolve genome towards intelligence
     auto& genome = const_cast<evolution::DynamicGenome&>(intelligence_->genome());
     genome.evolve_towards_intelligence(dt);
     
-    last_evolution_time = now;
+    last_evolution_time_ = now;
     
     // Observe current metrics
     auto& metrics = intelligence_->metrics();
@@ -548,10 +584,13 @@ void CognitiveOS::tick_reflection(float budget_ms) {
     cmd.theta = intelligence_->genome().reasoning_params().semantic_threshold;
     cmd.strategy = "adaptive";
     
-    bus_.publish(topics::REFLECT_COMMAND, cmd);
+    bus_.publish(topic_ids::REFLECT_COMMAND, cmd);
+    
+    note_intelligence_metrics();
 }
 
 void CognitiveOS::tick_field_maintenance(float budget_ms) {
+    MELVIN_TRACE_SCOPE("os.tick_field_maintenance");
     // Global decay
     field_->decay(0.05f);
     
@@ -571,7 +610,7 @@ void CognitiveOS::tick_field_maintenance(float budget_ms) {
         safety.severity = 0.7f;
         safety.details = "Too many active nodes, applied k-WTA";
         
-        bus_.publish(topics::SAFETY_EVENTS, safety);
+        bus_.publish(topic_ids::SAFETY_EVENTS, safety);
     }
 }
 
@@ -585,10 +624,15 @@ double CognitiveOS::get_timestamp() const {
     return std::chrono::duration<double>(duration).count();
 }
 
-float CognitiveOS::estimate_cpu_load() const {
-    // Simple estimate: if we're hitting our 20ms budget, we're at 100%
-    // This is a placeholder - real implementation would query system
-    return 0.5f;  // Assume 50% for now
+float CognitiveOS::estimate_cpu_load() {
+    // Close the accounting window opened by the previous tick
+    cpu_.sample();
+    return cpu_.process_load();
+}
+
+void CognitiveOS::run_service(ServiceBase* service, float budget_ms) {
+    if (!service || !service->is_running()) return;
+    service->run_tick(budget_ms);
 }
 
 // ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
@@ -678,7 +722,7 @@ std::vector<int> CognitiveOS::sample_contextual_seeds(int k) {
     auto& params = intelligence_->genome().reasoning_params();
     std::vector<int> seeds;
     
-    static std::mt19937 rng(std::random_device{}());
+    auto& rng = seed_rng_;
     std::uniform_real_distribution<float> prob_dist(0.0f, 1.0f);
     std::uniform_int_distribution<int> node_dist(0, 24);  // Assuming 25 nodes in minimal graph
     
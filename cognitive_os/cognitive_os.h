@@ -12,11 +12,16 @@
 #include "field_facade.h"
 #include "service_base.h"
 #include "metrics.h"
+#include "cpu_accounting.h"
+#include "service_executor.h"
+#include "candidate_pool.h"
 #include "core/unified_intelligence.h"
 #include <vector>
 #include <thread>
 #include <atomic>
 #include <memory>
+#include <random>
+#include <string>
 
 namespace melvin {
 namespace cognitive_os {
@@ -91,12 +96,18 @@ public:
     /**
      * @brief Set id_to_word map for internal query generation
      */
-    void set_word_map(const std::unordered_map<int, std::string>* map) { id_to_word_ = map; }
+    void set_word_map(const std::unordered_map<int, std::string>* map) {
+        id_to_word_ = map;
+        candidates_.invalidate();
+    }
 
     /**
      * @brief Provide node degree map (for curiosity bias toward low-degree nodes)
      */
-    void set_node_degrees(const std::unordered_map<int, int>* deg) { node_degree_ = deg; }
+    void set_node_degrees(const std::unordered_map<int, int>* deg) {
+        node_degree_ = deg;
+        candidates_.invalidate();
+    }
 
     /**
      * @brief Hint that a large unified graph is loaded (adjusts dampers)
@@ -108,6 +119,29 @@ public:
      */
     MetricsLogger* metrics() { return &metrics_; }
     
+    /**
+     * @brief Measured process and per-service CPU load
+     */
+    const CpuAccountant& cpu() const { return cpu_; }
+    
+    /**
+     * @brief Per-service deadline misses, jitter and budget overruns
+     */
+    std::vector<TaskStats> service_stats() const { return executor_.stats(); }
+    
+    /**
+     * @brief Latency percentiles for every instrumented service, reasoning
+     *        stage, bus topic and field tick
+     */
+    std::vector<metrics::LatencySummary> latency_summaries() const {
+        return metrics::LatencyRegistry::instance().snapshot();
+    }
+    
+    /**
+     * @brief Current overload degrade level (0 = nominal)
+     */
+    int degrade_level() const { return executor_.degrade_level(); }
+    
     /**
      * @brief Check if running
      */
@@ -121,27 +155,38 @@ private:
     FieldFacade* field_;
     melvin::intelligence::UnifiedIntelligence* intelligence_;
     MetricsLogger metrics_;
+    CpuAccountant cpu_;
     const std::unordered_map<int, std::string>* id_to_word_{nullptr};  // For internal query generation
     const std::unordered_map<int, int>* node_degree_{nullptr};          // For curiosity bias
     bool large_graph_{false};
+    CandidatePool candidates_;  // Internal query seeds (cognition task only)
     
     // Services (lightweight, run in scheduler thread)
     std::vector<std::unique_ptr<ServiceBase>> services_;
     
-    // Scheduler
-    std::thread scheduler_thread_;
+    // Scheduler: built-in services run as EDF tasks on a worker pool
+    ServiceExecutor executor_;
+    int task_ids_[BUILTIN_SERVICE_COUNT];
+    int control_task_{-1};
+    bool tasks_registered_{false};
     std::atomic<bool> running_{false};
     
-    // State
+    // State (control task)
     ServiceBudgets budgets_;
     ArousalState arousal_;
     
+    // Exchanged between the control task and the intelligence group
+    std::atomic<float> target_temperature_{1.0f};         // From arousal, applied to the genome
+    std::atomic<float> target_semantic_threshold_{0.25f};
+    std::atomic<float> intelligence_confidence_{0.5f};    // Last seen metrics().confidence
+    
     // Scheduler methods
-    void scheduler_loop();
+    void register_tasks();
     void run_tick();
     void compute_arousal(const FieldMetrics& metrics);
     void adapt_budgets(const FieldMetrics& metrics, float cpu_load);
     void update_genome_from_arousal();
+    void note_intelligence_metrics();
     
     // Service execution
     void run_service(ServiceBase* service, float budget_ms);
@@ -164,7 +209,7 @@ private:
     static constexpr int MAX_WM_SLOTS = 7;
     
     // Stats
-    uint64_t total_ticks_{0};
+    std::atomic<uint64_t> total_ticks_{0};
     double last_tick_time_{0.0};
     
     // Adaptive baseline activity state
@@ -175,6 +220,7 @@ private:
     double last_dmn_switch_{0.0};              // For network cycling
     enum class DMNFocus { INTROSPECTION, SALIENCE, EXPLORATION } dmn_focus_{DMNFocus::INTROSPECTION};
     std::vector<int> recent_active_nodes_;     // For contextual baseline seeding
+    std::mt19937 seed_rng_{std::random_device{}()};  // Baseline seed sampling (attention)
             double last_internal_query_time_{0.0};     // For autonomous text outputs
     
     // Self-tuning state (evolution feedback)
@@ -182,8 +228,13 @@ private:
     int consecutive_dead_ticks_{0};            // Ticks with 0 nodes (death detection)
     static constexpr int MAX_DEAD_TICKS = 20;  // After this, trigger emergency evolution
     
+    // Per-service state, safe without locks because each service's runs
+    // are serialized by the executor
+    std::vector<std::string> echo_history_;    // Recent autonomous answers (cognition)
+    double last_evolution_time_{0.0};          // Last genome evolution step (reflection)
+    
     double get_timestamp() const;
-    float estimate_cpu_load() const;
+    float estimate_cpu_load();
     
     // Adaptive baseline helpers
     void update_baseline_targets(int active_nodes, float entropy, float coherence);
@@ -0,0 +1,111 @@
+/**
+ * @file cpu_accounting.cpp
+ * @brief Implementation of CPU accounting
+ */
+
+#include "cpu_accounting.h"
+#include <chrono>
+#include <thread>
+#include <algorithm>
+#include <time.h>
+
+namespace melvin {
+namespace cognitive_os {
+
+namespace {
+
+double clock_ms(clockid_t clock) {
+    struct timespec ts;
+    if (clock_gettime(clock, &ts) != 0) return 0.0;
+    return ts.tv_sec * 1000.0 + ts.tv_nsec / 1e6;
+}
+
+const char* SERVICE_NAMES[BUILTIN_SERVICE_COUNT] = {
+    "cognition", "attention", "wm", "learning", "reflection", "field"
+};
+
+constexpr float LOAD_SMOOTHING = 0.2f;  // EMA weight of the newest window
+
+} // namespace
+
+const char* builtin_service_name(int service) {
+    return (service >= 0 && service < BUILTIN_SERVICE_COUNT) ? SERVICE_NAMES[service] : "unknown";
+}
+
+double thread_cpu_time_ms() {
+    return clock_ms(CLOCK_THREAD_CPUTIME_ID);
+}
+
+double process_cpu_time_ms() {
+    return clock_ms(CLOCK_PROCESS_CPUTIME_ID);
+}
+
+double wall_time_ms() {
+    auto now = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(now.time_since_epoch()).count();
+}
+
+CpuAccountant::CpuAccountant()
+    : cores_(std::max(1u, std::thread::hardware_concurrency())),
+      last_wall_ms_(wall_time_ms()),
+      last_process_cpu_ms_(process_cpu_time_ms()) {}
+
+void CpuAccountant::record(int service, double cpu_ms) {
+    if (service < 0 || service >= BUILTIN_SERVICE_COUNT) return;
+    auto& slot = slots_[service];
+    slot.cpu_ns.fetch_add(static_cast<uint64_t>(std::max(0.0, cpu_ms) * 1e6), std::memory_order_relaxed);
+    slot.calls.fetch_add(1, std::memory_order_relaxed);
+}
+
+void CpuAccountant::sample() {
+    double now = wall_time_ms();
+    double process_cpu = process_cpu_time_ms();
+    double window_ms = now - last_wall_ms_;
+    if (window_ms <= 0.0) return;
+    
+    // Whole process: CPU consumed by all threads over wall time x cores
+    float load = static_cast<float>((process_cpu - last_process_cpu_ms_) / (window_ms * cores_));
+    load = std::min(1.0f, std::max(0.0f, load));
+    float prev = process_load_.load(std::memory_order_relaxed);
+    process_load_.store(LOAD_SMOOTHING * load + (1.0f - LOAD_SMOOTHING) * prev, std::memory_order_relaxed);
+    
+    // Per service: CPU consumed in this window relative to one core
+    for (auto& slot : slots_) {
+        double cpu_ms = slot.cpu_ns.exchange(0, std::memory_order_relaxed) / 1e6;
+        uint64_t calls = slot.calls.exchange(0, std::memory_order_relaxed);
+        
+        float service_load = static_cast<float>(std::min(1.0, cpu_ms / window_ms));
+        float prev_load = slot.load.load(std::memory_order_relaxed);
+        slot.load.store(LOAD_SMOOTHING * service_load + (1.0f - LOAD_SMOOTHING) * prev_load,
+                        std::memory_order_relaxed);
+        
+        if (calls > 0) {
+            float per_call = static_cast<float>(cpu_ms / calls);
+            float prev_call = slot.cpu_ms_per_call.load(std::memory_order_relaxed);
+            slot.cpu_ms_per_call.store(LOAD_SMOOTHING * per_call + (1.0f - LOAD_SMOOTHING) * prev_call,
+                                       std::memory_order_relaxed);
+        }
+    }
+    
+    last_wall_ms_ = now;
+    last_process_cpu_ms_ = process_cpu;
+}
+
+float CpuAccountant::service_load(int service) const {
+    if (service < 0 || service >= BUILTIN_SERVICE_COUNT) return 0.0f;
+    return slots_[service].load.load(std::memory_order_relaxed);
+}
+
+float CpuAccountant::service_cpu_ms(int service) const {
+    if (service < 0 || service >= BUILTIN_SERVICE_COUNT) return 0.0f;
+    return slots_[service].cpu_ms_per_call.load(std::memory_order_relaxed);
+}
+
+float CpuAccountant::avg_service_load() const {
+    float sum = 0.0f;
+    for (const auto& slot : slots_) sum += slot.load.load(std::memory_order_relaxed);
+    return sum / BUILTIN_SERVICE_COUNT;
+}
+
+} // namespace cognitive_os
+} // namespace melvin
@@ -0,0 +1,130 @@
+/**
+ * @file cpu_accounting.h
+ * @brief Per-service and whole-process CPU time accounting
+ * 
+ * Uses the kernel's per-thread and per-process CPU clocks, so the numbers
+ * reflect time actually spent on a core (not wall time spent sleeping or
+ * preempted).
+ */
+
+#ifndef MELVIN_CPU_ACCOUNTING_H
+#define MELVIN_CPU_ACCOUNTING_H
+
+#include <atomic>
+#include <cstdint>
+
+namespace melvin {
+namespace cognitive_os {
+
+/**
+ * @brief Built-in CognitiveOS services (index into accounting slots)
+ */
+enum BuiltinService : int {
+    SVC_COGNITION = 0,
+    SVC_ATTENTION,
+    SVC_WORKING_MEMORY,
+    SVC_LEARNING,
+    SVC_REFLECTION,
+    SVC_FIELD_MAINTENANCE,
+    BUILTIN_SERVICE_COUNT
+};
+
+const char* builtin_service_name(int service);
+
+/**
+ * @brief CPU time consumed by the calling thread (ms)
+ */
+double thread_cpu_time_ms();
+
+/**
+ * @brief CPU time consumed by the whole process, all threads (ms)
+ */
+double process_cpu_time_ms();
+
+/**
+ * @brief Monotonic wall time (ms)
+ */
+double wall_time_ms();
+
+/**
+ * @brief Accumulates CPU time per service and samples process load
+ * 
+ * record() is thread-safe (services may run on any thread); sample() is
+ * called once per scheduler tick to close the accounting window.
+ */
+class CpuAccountant {
+public:
+    CpuAccountant();
+    
+    /**
+     * @brief RAII timer attributing the enclosed thread CPU time to a service
+     */
+    class Scope {
+    public:
+        Scope(CpuAccountant& accountant, int service)
+            : accountant_(accountant), service_(service),
+              cpu_start_(thread_cpu_time_ms()) {}
+        ~Scope() {
+            accountant_.record(service_, thread_cpu_time_ms() - cpu_start_);
+        }
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+    private:
+        CpuAccountant& accountant_;
+        int service_;
+        double cpu_start_;
+    };
+    
+    /**
+     * @brief Attribute one run of a service
+     */
+    void record(int service, double cpu_ms);
+    
+    /**
+     * @brief Close the current window and update smoothed loads
+     */
+    void sample();
+    
+    /**
+     * @brief Process CPU load as a fraction of all cores (0-1)
+     */
+    float process_load() const { return process_load_.load(std::memory_order_relaxed); }
+    
+    /**
+     * @brief Service CPU load as a fraction of one core (0-1)
+     */
+    float service_load(int service) const;
+    
+    /**
+     * @brief Average CPU ms per run of a service (last windows, smoothed)
+     */
+    float service_cpu_ms(int service) const;
+    
+    /**
+     * @brief Mean load across built-in services (fraction of one core)
+     */
+    float avg_service_load() const;
+    
+    unsigned cores() const { return cores_; }
+    
+private:
+    struct Slot {
+        std::atomic<uint64_t> cpu_ns{0};
+        std::atomic<uint64_t> calls{0};
+        std::atomic<float> load{0.0f};
+        std::atomic<float> cpu_ms_per_call{0.0f};
+    };
+    
+    Slot slots_[BUILTIN_SERVICE_COUNT];
+    unsigned cores_;
+    
+    // Window state (touched only by sample())
+    double last_wall_ms_;
+    double last_process_cpu_ms_;
+    std::atomic<float> process_load_{0.0f};
+};
+
+} // namespace cognitive_os
+} // namespace melvin
+
+#endif // MELVIN_CPU_ACCOUNTING_H
@@ -10,42 +10,277 @@
 namespace melvin {
 namespace cognitive_os {
 
-EventBus::EventBus(size_t buffer_size) : buffer_capacity_(buffer_size) {}
+namespace {
 
-void EventBus::subscribe(const std::string& topic, 
-                         std::function<void(const Event&)> callback) {
-    std::lock_guard<std::mutex> lock(mutex_);
-    subscribers_[topic].push_back(callback);
+struct WellKnownTopic {
+    const char* name;
+    TopicId id;
+    bool keep_latest;  // State-like topics read via get_latest()
+};
+
+const WellKnownTopic WELL_KNOWN_TOPICS[] = {
+    {topics::VISION_EVENTS,   topic_ids::VISION_EVENTS,   false},
+    {topics::AUDIO_EVENTS,    topic_ids::AUDIO_EVENTS,    false},
+    {topics::MOTOR_STATE,     topic_ids::MOTOR_STATE,     true},
+    {topics::MOTOR_FEEDBACK,  topic_ids::MOTOR_FEEDBACK,  false},
+    {topics::COG_QUERY,       topic_ids::COG_QUERY,       false},
+    {topics::COG_ANSWER,      topic_ids::COG_ANSWER,      true},
+    {topics::COG_FEEDBACK,    topic_ids::COG_FEEDBACK,    false},
+    {topics::FIELD_METRICS,   topic_ids::FIELD_METRICS,   true},
+    {topics::WM_CONTEXT,      topic_ids::WM_CONTEXT,      true},
+    {topics::REFLECT_COMMAND, topic_ids::REFLECT_COMMAND, true},
+    {topics::SAFETY_EVENTS,   topic_ids::SAFETY_EVENTS,   false},
+};
+
+} // namespace
+
+EventBus::EventBus(size_t buffer_size) : buffer_capacity_(buffer_size) {
+    for (size_t i = 0; i < MAX_TOPICS; i++) {
+        channels_[i].store(nullptr, std::memory_order_relaxed);
+        keep_latest_[i].store(false, std::memory_order_relaxed);
+        subscriber_count_[i].store(0, std::memory_order_relaxed);
+    }
+    
+    // Register well-known topics so their IDs match topic_ids::*
+    for (const auto& t : WELL_KNOWN_TOPICS) {
+        TopicId id = topic_id(t.name);
+        (void)id;  // Equal to t.id by construction order
+        keep_latest_[t.id].store(t.keep_latest, std::memory_order_relaxed);
+    }
 }
 
-std::vector<Event> EventBus::poll(const std::string& topic) {
-    std::lock_guard<std::mutex> lock(mutex_);
+EventBus::~EventBus() {
+    stop_recording();
+    
+    {
+        std::lock_guard<std::mutex> lock(subscribers_mutex_);
+        for (size_t i = 0; i < MAX_TOPICS; i++) {
+            auto list = std::atomic_load(&subscribers_[i]);
+            if (!list) continue;
+            for (const auto& sub : *list) sub->close();
+        }
+    }
+    for (auto& [sub, t] : delivery_threads_) {
+        if (t.joinable()) t.join();
+    }
+    
+    for (size_t i = 0; i < MAX_TOPICS; i++) {
+        delete channels_[i].exchange(nullptr, std::memory_order_acq_rel);
+    }
+}
+
+TopicId EventBus::topic_id(const std::string& topic) {
+    std::lock_guard<std::mutex> lock(registry_mutex_);
+    
+    auto it = topic_ids_.find(topic);
+    if (it != topic_ids_.end()) {
+        return it->second;
+    }
+    
+    if (topic_names_.size() >= MAX_TOPICS) {
+        return INVALID_TOPIC;
+    }
+    
+    TopicId id = static_cast<TopicId>(topic_names_.size());
+    topic_names_.push_back(topic);
+    topic_ids_[topic] = id;
+    return id;
+}
+
+std::string EventBus::topic_name(TopicId id) const {
+    std::lock_guard<std::mutex> lock(registry_mutex_);
+    return id < topic_names_.size() ? topic_names_[id] : std::string();
+}
+
+detail::TopicChannelBase* EventBus::create_channel(
+    TopicId id, const std::function<detail::TopicChannelBase*(const std::string&)>& factory) {
+    std::lock_guard<std::mutex> lock(registry_mutex_);
+    
+    // Re-check under the lock: another thread may have won the race
+    auto* existing = channels_[id].load(std::memory_order_acquire);
+    if (existing) return existing;
+    if (id >= topic_names_.size()) return nullptr;
+    
+    auto* channel = factory(topic_names_[id]);
+    channel->set_keep_latest(keep_latest_[id].load(std::memory_order_relaxed));
+    channels_[id].store(channel, std::memory_order_release);
+    return channel;
+}
+
+std::shared_ptr<Subscription> EventBus::open_subscription(const std::string& topic,
+                                                        const SubscriptionOptions& options) {
+    TopicId id = topic_id(topic);
+    if (id == INVALID_TOPIC) return nullptr;
+    
+    auto subscription = std::make_shared<Subscription>(topic, options);
+    
+    bool first;
+    {
+        std::lock_guard<std::mutex> lock(subscribers_mutex_);
+        auto current = std::atomic_load(&subscribers_[id]);
+        auto updated = std::make_shared<SubscriberList>(current ? *current : SubscriberList());
+        updated->push_back(subscription);
+        std::atomic_store(&subscribers_[id], std::shared_ptr<const SubscriberList>(updated));
+        subscriber_count_[id].store(static_cast<int>(updated->size()), std::memory_order_release);
+        first = updated->size() == 1;
+    }
+    
+    // Publishers switch to push delivery from here on; what they queued in
+    // the ring before goes to the first subscriber (pairs with publish())
+    if (first) {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        flush_ring(id);
+    }
+    
+    return subscription;
+}
+
+std::shared_ptr<Subscription> EventBus::subscribe(const std::string& topic, 
+                                                  std::function<void(const Event&)> callback,
+                                                  const SubscriptionOptions& options) {
+    auto subscription = open_subscription(topic, options);
+    if (!subscription) return nullptr;
+    
+    std::lock_guard<std::mutex> lock(subscribers_mutex_);
+    delivery_threads_.emplace(subscription.get(), std::thread([subscription, callback]() {
+        while (!subscription->closed()) {
+            if (subscription->wait_for(100.0)) {
+                subscription->drain(callback);
+            }
+        }
+    }));
+    
+    return subscription;
+}
+
+void EventBus::unsubscribe(const std::shared_ptr<Subscription>& subscription) {
+    if (!subscription) return;
+    
+    TopicId id = topic_id(subscription->topic());
+    if (id == INVALID_TOPIC) return;
+    
+    std::thread delivery;
+    {
+        std::lock_guard<std::mutex> lock(subscribers_mutex_);
+        auto current = std::atomic_load(&subscribers_[id]);
+        if (current) {
+            auto updated = std::make_shared<SubscriberList>(*current);
+            updated->erase(std::remove(updated->begin(), updated->end(), subscription), updated->end());
+            std::atomic_store(&subscribers_[id], std::shared_ptr<const SubscriberList>(updated));
+            subscriber_count_[id].store(static_cast<int>(updated->size()), std::memory_order_release);
+        }
+        subscription->close();
+        
+        auto it = delivery_threads_.find(subscription.get());
+        if (it != delivery_threads_.end()) {
+            delivery = std::move(it->second);
+            delivery_threads_.erase(it);
+        }
+    }
     
-    auto it = buffers_.find(topic);
-    if (it == buffers_.end() || it->second.empty()) {
+    // Reap the delivery thread; a callback may unsubscribe its own subscription
+    if (delivery.joinable()) {
+        if (delivery.get_id() == std::this_thread::get_id()) {
+            delivery.detach();
+        } else {
+            delivery.join();
+        }
+    }
+}
+
+std::vector<SubscriberStats> EventBus::subscriber_stats() const {
+    std::vector<SubscriberStats> stats;
+    std::lock_guard<std::mutex> lock(subscribers_mutex_);
+    for (size_t i = 0; i < MAX_TOPICS; i++) {
+        auto list = std::atomic_load(&subscribers_[i]);
+        if (!list) continue;
+        for (const auto& sub : *list) stats.push_back(sub->stats());
+    }
+    return stats;
+}
+
+void EventBus::dispatch(TopicId id, const Event& event) {
+    auto list = std::atomic_load(&subscribers_[id]);
+    if (!list) return;
+    size_t dropped = 0;
+    for (const auto& sub : *list) {
+        dropped += sub->deliver(event);
+    }
+    if (dropped) {
+        dropped_msgs_.fetch_add(dropped, std::memory_order_relaxed);
+    }
+}
+
+void EventBus::flush_ring(TopicId id) {
+    auto* channel = find_channel(id);
+    if (!channel) return;
+    
+    std::vector<Event> pending;
+    channel->drain(pending);
+    for (const auto& event : pending) {
+        dispatch(id, event);
+    }
+}
+
+std::vector<Event> EventBus::poll(TopicId id) {
+    auto* channel = find_channel(id);
+    if (!channel) {
         return {};
     }
     
-    std::vector<Event> events = it->second;
-    it->second.clear();
+    std::vector<Event> events;
+    events.reserve(channel->size());
+    channel->drain(events);
     
     return events;
 }
 
-Event EventBus::get_latest(const std::string& topic) {
-    std::lock_guard<std::mutex> lock(mutex_);
+std::vector<Event> EventBus::poll(const std::string& topic) {
+    return poll(topic_id(topic));
+}
+
+Event EventBus::get_latest(TopicId id) {
+    if (id >= MAX_TOPICS) {
+        return Event{};
+    }
     
-    auto it = buffers_.find(topic);
-    if (it == buffers_.end() || it->second.empty()) {
+    keep_latest_[id].store(true, std::memory_order_relaxed);
+    auto* channel = find_channel(id);
+    if (!channel) {
         return Event{};
     }
     
-    return it->second.back();
+    channel->set_keep_latest(true);
+    return channel->latest();
+}
+
+Event EventBus::get_latest(const std::string& topic) {
+    return get_latest(topic_id(topic));
+}
+
+void EventBus::clear(TopicId id) {
+    auto* channel = find_channel(id);
+    if (channel) {
+        channel->clear();
+    }
 }
 
 void EventBus::clear(const std::string& topic) {
-    std::lock_guard<std::mutex> lock(mutex_);
-    buffers_[topic].clear();
+    clear(topic_id(topic));
+}
+
+bool EventBus::start_recording(const std::string& filepath) {
+    recording_.store(false, std::memory_order_relaxed);
+    if (!recorder_.open(filepath)) {
+        return false;
+    }
+    recording_.store(true, std::memory_order_relaxed);
+    return true;
+}
+
+void EventBus::stop_recording() {
+    recording_.store(false, std::memory_order_relaxed);
+    recorder_.close();
 }
 
 double EventBus::get_timestamp() const {
@@ -56,4 +291,3 @@ double EventBus::get_timestamp() const {
 
 } // namespace cognitive_os
 } // namespace melvin
-
@@ -2,7 +2,8 @@
  * @file event_bus.h
  * @brief Lock-free pub/sub event bus for cognitive services
  * 
- * Zero-copy where possible, SPSC ring buffers per topic
+ * Interned topic IDs, lock-free MPMC ring buffers per topic,
+ * optional binary capture of published events
  */
 
 #ifndef MELVIN_EVENT_BUS_H
@@ -15,6 +16,15 @@
 #include <atomic>
 #include <mutex>
 #include <memory>
+#include <cstdint>
+#include <array>
+#include <thread>
+#include <chrono>
+#include "mpmc_ring.h"
+#include "subscription.h"
+#include "event_types.h"
+#include "event_record.h"
+#include "core/metrics/latency_histogram.h"
 
 namespace melvin {
 namespace cognitive_os {
@@ -37,160 +47,387 @@ namespace topics {
 }
 
 /**
- * @brief Vision event
+ * @brief Interned topic identifier
  */
-struct VisionEvent {
-    double timestamp;
-    std::vector<int> obj_ids;
-    std::vector<std::vector<float>> embeddings;
-    std::vector<float> bbox;  // [x, y, w, h]
-};
+using TopicId = uint32_t;
+constexpr TopicId INVALID_TOPIC = 0xFFFFFFFFu;
 
 /**
- * @brief Audio event
+ * @brief Pre-interned IDs of the well-known topics (hot-path publishers)
+ * 
+ * Order matches the registration order in the EventBus constructor.
  */
-struct AudioEvent {
-    double timestamp;
-    std::vector<std::string> phonemes;
-    float energy;
-    std::vector<float> embedding;
-};
+namespace topic_ids {
+    constexpr TopicId VISION_EVENTS = 0;
+    constexpr TopicId AUDIO_EVENTS = 1;
+    constexpr TopicId MOTOR_STATE = 2;
+    constexpr TopicId MOTOR_FEEDBACK = 3;
+    constexpr TopicId COG_QUERY = 4;
+    constexpr TopicId COG_ANSWER = 5;
+    constexpr TopicId COG_FEEDBACK = 6;
+    constexpr TopicId FIELD_METRICS = 7;
+    constexpr TopicId WM_CONTEXT = 8;
+    constexpr TopicId REFLECT_COMMAND = 9;
+    constexpr TopicId SAFETY_EVENTS = 10;
+}
 
 /**
- * @brief Motor state
+ * @brief Generic event wrapper
  */
-struct MotorState {
+struct Event {
+    std::string topic;
     double timestamp;
-    std::vector<float> joint_pos;
-    std::vector<float> joint_vel;
-    std::vector<float> torque;
+    std::shared_ptr<void> data;
+    
+    template<typename T>
+    std::shared_ptr<T> get() const {
+        return std::static_pointer_cast<T>(data);
+    }
 };
 
 /**
- * @brief Cognitive query
+ * @brief Typed event as stored in a topic ring slot
  */
-struct CogQuery {
-    double timestamp;
-    std::string text;
-    std::vector<float> embedding;
-    int intent;  // 0=DEFINE, 1=LOCATE, etc.
+template<typename T>
+struct TypedEvent {
+    double timestamp = 0.0;
+    T data{};
 };
 
-/**
- * @brief Cognitive answer
- */
-struct CogAnswer {
-    double timestamp;
-    std::string text;
-    std::vector<std::string> reasoning_chain;
-    float confidence;
-};
+namespace detail {
 
 /**
- * @brief Field metrics
+ * @brief Per-type identity used to check topic payload types
  */
-struct FieldMetrics {
-    double timestamp;
-    int active_nodes;
-    float energy_variance;
-    float sparsity;
-    float entropy;
-    float coherence;
-    float confidence;
-};
+template<typename T>
+const void* type_tag() {
+    static const char tag = 0;
+    return &tag;
+}
 
 /**
- * @brief Working memory context
+ * @brief Bus clock (seconds, same epoch as Event::timestamp)
  */
-struct WMContext {
-    double timestamp;
-    std::vector<int> node_ids;  // Max 7
-    std::vector<float> strengths;
-};
+inline double bus_now() {
+    auto now = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration<double>(now.time_since_epoch()).count();
+}
 
 /**
- * @brief Reflection command
+ * @brief Name of a topic's publish -> consume lag metric
+ * 
+ * Path separators become dots: "/cog/answer" -> "bus.lag.cog.answer"
  */
-struct ReflectCommand {
-    double timestamp;
-    int mode;  // 0=EXPLORATORY, 1=EXPLOITATIVE, etc.
-    float beta;
-    float theta;
-    std::string strategy;
-};
+inline std::string lag_metric_name(const std::string& topic) {
+    std::string name = "bus.lag.";
+    for (char c : topic) {
+        if (c != '/') name += c;
+        else if (name.back() != '.') name += '.';
+    }
+    if (name.back() == '.') name.pop_back();
+    return name;
+}
 
 /**
- * @brief Safety event
+ * @brief Type-erased topic channel
  */
-struct SafetyEvent {
-    double timestamp;
-    std::string event_type;  // "BACKPRESSURE", "OVERHEAT", "QUEUE_OVERFLOW"
-    float severity;  // 0-1
-    std::string details;
+class TopicChannelBase {
+public:
+    TopicChannelBase(const std::string& name, const void* tag)
+        : name_(name), tag_(tag), lag_(metrics::latency_metric(lag_metric_name(name))) {}
+    virtual ~TopicChannelBase() = default;
+    
+    const std::string& name() const { return name_; }
+    const void* tag() const { return tag_; }
+    
+    void set_keep_latest(bool v) { keep_latest_.store(v, std::memory_order_relaxed); }
+    
+    virtual size_t drain(std::vector<Event>& out) = 0;
+    virtual Event latest() = 0;
+    virtual size_t clear() = 0;
+    virtual size_t size() const = 0;
+    
+protected:
+    std::string name_;
+    const void* tag_;
+    std::atomic<bool> keep_latest_{false};
+    metrics::LatencyMetric& lag_;  // Publish -> poll/consume latency
 };
 
 /**
- * @brief Generic event wrapper
+ * @brief Topic channel with preallocated slots of one payload type
  */
-struct Event {
-    std::string topic;
-    double timestamp;
-    std::shared_ptr<void> data;
+template<typename T>
+class TopicChannel : public TopicChannelBase {
+public:
+    TopicChannel(const std::string& name, size_t capacity)
+        : TopicChannelBase(name, type_tag<T>()), ring_(capacity) {}
     
-    template<typename T>
-    std::shared_ptr<T> get() const {
-        return std::static_pointer_cast<T>(data);
+    /**
+     * @brief Push event, dropping the oldest in O(1) when full
+     * @return Number of dropped events
+     */
+    size_t push(double timestamp, const T& data) {
+        note_latest(timestamp, data);
+        TypedEvent<T> ev;
+        ev.timestamp = timestamp;
+        ev.data = data;
+        return ring_.push_overwrite(std::move(ev));
+    }
+    
+    /**
+     * @brief Visit pending events in place, recording publish -> consume lag
+     */
+    template<typename Fn>
+    size_t consume(Fn&& fn, size_t max_events) {
+        double now = 0.0;
+        return consume_raw([&](TypedEvent<T>& ev) {
+            if (now == 0.0) now = bus_now();  // One clock read per batch
+            lag_.record_ms((now - ev.timestamp) * 1000.0);
+            fn(ev);
+        }, max_events);
+    }
+    
+    size_t drain(std::vector<Event>& out) override {
+        return consume([&](TypedEvent<T>& ev) {
+            Event e;
+            e.topic = name_;
+            e.timestamp = ev.timestamp;
+            e.data = std::make_shared<T>(std::move(ev.data));
+            out.push_back(std::move(e));
+        }, SIZE_MAX);
+    }
+    
+    Event latest() override {
+        Event e;
+        while (latest_lock_.test_and_set(std::memory_order_acquire)) {}
+        if (has_latest_) {
+            e.topic = name_;
+            e.timestamp = latest_.timestamp;
+            e.data = std::make_shared<T>(latest_.data);
+        }
+        latest_lock_.clear(std::memory_order_release);
+        return e;
+    }
+    
+    size_t clear() override {
+        return consume_raw([](TypedEvent<T>&) {}, SIZE_MAX);
+    }
+    
+    size_t size() const override { return ring_.size_approx(); }
+    
+    void note_latest(double timestamp, const T& data) {
+        if (keep_latest_.load(std::memory_order_relaxed)) {
+            store_latest(timestamp, data);
+        }
+    }
+    
+    /**
+     * @brief Box a payload for push delivery
+     * 
+     * Boxes come from a small pool and are refilled in place once every
+     * subscriber queue has released them, so steady-state push delivery
+     * does not allocate. A box still held (lagging subscriber) or a slot
+     * taken by a concurrent publisher falls back to a fresh allocation.
+     */
+    std::shared_ptr<void> box(const T& data) {
+        BoxSlot& slot = boxes_[next_box_.fetch_add(1, std::memory_order_relaxed) % BOX_POOL_SIZE];
+        if (slot.lock.test_and_set(std::memory_order_acquire)) {
+            return std::make_shared<T>(data);
+        }
+        if (slot.box && slot.box.use_count() == 1) {
+            // Pairs with the last holder's release of its reference
+            std::atomic_thread_fence(std::memory_order_acquire);
+            *slot.box = data;
+        } else {
+            slot.box = std::make_shared<T>(data);
+        }
+        std::shared_ptr<void> boxed = slot.box;
+        slot.lock.clear(std::memory_order_release);
+        return boxed;
+    }
+    
+private:
+    static constexpr size_t BOX_POOL_SIZE = 64;
+    
+    struct BoxSlot {
+        std::atomic_flag lock = ATOMIC_FLAG_INIT;
+        std::shared_ptr<T> box;
+    };
+    
+    MPMCRing<TypedEvent<T>> ring_;
+    std::atomic_flag latest_lock_ = ATOMIC_FLAG_INIT;
+    TypedEvent<T> latest_;
+    bool has_latest_{false};
+    std::array<BoxSlot, BOX_POOL_SIZE> boxes_;
+    std::atomic<size_t> next_box_{0};
+    
+    template<typename Fn>
+    size_t consume_raw(Fn&& fn, size_t max_events) {
+        size_t n = 0;
+        while (n < max_events && ring_.try_consume(fn)) n++;
+        return n;
+    }
+    
+    void store_latest(double timestamp, const T& data) {
+        while (latest_lock_.test_and_set(std::memory_order_acquire)) {}
+        latest_.timestamp = timestamp;
+        latest_.data = data;
+        has_latest_ = true;
+        latest_lock_.clear(std::memory_order_release);
     }
 };
 
+} // namespace detail
+
 /**
  * @brief Lock-free event bus
  * 
- * SPSC ring buffers per topic, pub/sub pattern
+ * Topics are interned to small integer IDs. Each topic owns a bounded
+ * lock-free MPMC ring whose slots hold the payload type directly, so
+ * publish never allocates and never takes a lock once the topic exists.
+ * When a ring is full the oldest event is dropped in O(1). Subscribed
+ * topics fan out pooled payload boxes, which are reused once released.
  */
 class EventBus {
 public:
+    static constexpr size_t MAX_TOPICS = 64;
+    
     EventBus(size_t buffer_size = 1024);
-    ~EventBus() = default;
+    ~EventBus();
+    
+    EventBus(const EventBus&) = delete;
+    EventBus& operator=(const EventBus&) = delete;
+    
+    /**
+     * @brief Intern a topic name (registers it on first use)
+     * 
+     * @return Topic ID, or INVALID_TOPIC if the table is full
+     */
+    TopicId topic_id(const std::string& topic);
+    
+    /**
+     * @brief Get the name of an interned topic
+     */
+    std::string topic_name(TopicId id) const;
     
     /**
      * @brief Publish event to topic
+     * 
+     * The first publish fixes the payload type of a topic; publishing a
+     * different type to it is rejected and counted as dropped.
      */
     template<typename T>
-    void publish(const std::string& topic, const T& event_data) {
-        Event event;
-        event.topic = topic;
-        event.timestamp = get_timestamp();
-        event.data = std::make_shared<T>(event_data);
-        
-        std::lock_guard<std::mutex> lock(mutex_);
-        auto& buffer = buffers_[topic];
-        if (buffer.size() >= buffer_capacity_) {
-            buffer.erase(buffer.begin());  // Drop oldest
+    bool publish(TopicId id, const T& event_data) {
+        auto* channel = channel_for<T>(id);
+        if (!channel) {
             dropped_msgs_.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        double ts = get_timestamp();
+        if constexpr (EventCodec<T>::TYPE != PayloadType::UNKNOWN) {
+            if (recording_.load(std::memory_order_relaxed)) {
+                recorder_.record(id, channel->name(), ts, event_data);
+            }
+        }
+        if (subscriber_count_[id].load(std::memory_order_acquire) > 0) {
+            // Push delivery: box once, fan out to every subscriber queue
+            channel->note_latest(ts, event_data);
+            Event event;
+            event.topic = channel->name();
+            event.timestamp = ts;
+            event.data = channel->box(event_data);
+            dispatch(id, event);
+            return true;
+        }
+        size_t dropped = channel->push(ts, event_data);
+        if (dropped) {
+            dropped_msgs_.fetch_add(dropped, std::memory_order_relaxed);
+        }
+        // A first subscriber attaching concurrently drains the ring after
+        // publishing its count; whichever side runs second hands the event over
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (subscriber_count_[id].load(std::memory_order_relaxed) > 0) {
+            flush_ring(id);
         }
-        buffer.push_back(event);
+        return true;
+    }
+    
+    template<typename T>
+    bool publish(const std::string& topic, const T& event_data) {
+        return publish(topic_id(topic), event_data);
+    }
+    
+    /**
+     * @brief Zero-copy poll: hand each pending event to fn in place
+     * 
+     * fn receives a TypedEvent<T>& that lives in the ring slot; move out
+     * of it if the payload must outlive the call.
+     * 
+     * @return Number of events consumed
+     */
+    template<typename T, typename Fn>
+    size_t consume(TopicId id, Fn&& fn, size_t max_events = SIZE_MAX) {
+        auto* channel = channel_for<T>(id);
+        if (!channel) return 0;
+        return channel->consume(fn, max_events);
     }
     
     /**
      * @brief Subscribe to topic with callback
+     * 
+     * The callback runs on a dedicated delivery thread that sleeps on the
+     * subscriber's wakeup, so consumers no longer busy-poll; unsubscribe()
+     * joins it. Once a topic has subscribers its events are pushed to them
+     * instead of the ring (poll()/consume() on it return nothing;
+     * get_latest() still works). Events already in the ring go to the
+     * first subscriber.
      */
-    void subscribe(const std::string& topic, 
-                   std::function<void(const Event&)> callback);
+    std::shared_ptr<Subscription> subscribe(const std::string& topic, 
+                   std::function<void(const Event&)> callback,
+                   const SubscriptionOptions& options = SubscriptionOptions());
+    
+    /**
+     * @brief Open a pull-mode subscription owned by the caller's thread
+     * 
+     * Wait on it with Subscription::wait_for() or poll() its fd(), then
+     * drain(). Useful for loops that also wait on device fds.
+     */
+    std::shared_ptr<Subscription> open_subscription(const std::string& topic,
+                   const SubscriptionOptions& options = SubscriptionOptions());
+    
+    /**
+     * @brief Detach and close a subscription
+     */
+    void unsubscribe(const std::shared_ptr<Subscription>& subscription);
+    
+    /**
+     * @brief Delivery stats (lag, drops, queue depth) for every subscriber
+     */
+    std::vector<SubscriberStats> subscriber_stats() const;
     
     /**
      * @brief Poll for new events (non-blocking)
+     * 
+     * Type-erased path: each event is boxed into a shared_ptr. Prefer
+     * consume<T>() on hot paths.
      */
+    std::vector<Event> poll(TopicId id);
     std::vector<Event> poll(const std::string& topic);
     
     /**
      * @brief Get latest event from topic
+     * 
+     * Only topics with latest-tracking enabled keep a copy; the first
+     * call on any other topic enables it and returns an empty event.
      */
+    Event get_latest(TopicId id);
     Event get_latest(const std::string& topic);
     
     /**
      * @brief Clear all events from topic
      */
+    void clear(TopicId id);
     void clear(const std::string& topic);
     
     /**
@@ -200,13 +437,61 @@ public:
         return dropped_msgs_.load(std::memory_order_relaxed);
     }
     
+    /**
+     * @brief Capture every published event to a binary file
+     * 
+     * Events are encoded on the publishing thread and written by a
+     * background thread (see event_record.h). Replay with event_replay.
+     */
+    bool start_recording(const std::string& filepath);
+    void stop_recording();
+    bool is_recording() const { return recording_.load(std::memory_order_relaxed); }
+    const EventRecorder& recorder() const { return recorder_; }
+    
 private:
     size_t buffer_capacity_;
-    std::unordered_map<std::string, std::vector<Event>> buffers_;
-    std::unordered_map<std::string, std::vector<std::function<void(const Event&)>>> subscribers_;
-    std::mutex mutex_;
+    std::atomic<detail::TopicChannelBase*> channels_[MAX_TOPICS];
+    std::atomic<bool> keep_latest_[MAX_TOPICS];
+    
+    // Topic interning (cold path: registration and string lookups)
+    std::unordered_map<std::string, TopicId> topic_ids_;
+    std::vector<std::string> topic_names_;
+    mutable std::mutex registry_mutex_;
+    
+    // Subscribers: copy-on-write lists read lock-free by publishers
+    using SubscriberList = std::vector<std::shared_ptr<Subscription>>;
+    std::shared_ptr<const SubscriberList> subscribers_[MAX_TOPICS];
+    std::atomic<int> subscriber_count_[MAX_TOPICS];
+    std::unordered_map<const Subscription*, std::thread> delivery_threads_;
+    mutable std::mutex subscribers_mutex_;
     std::atomic<uint64_t> dropped_msgs_{0};
     
+    // Capture (record/replay)
+    EventRecorder recorder_;
+    std::atomic<bool> recording_{false};
+    
+    template<typename T>
+    detail::TopicChannel<T>* channel_for(TopicId id) {
+        if (id >= MAX_TOPICS) return nullptr;
+        auto* channel = channels_[id].load(std::memory_order_acquire);
+        if (!channel) {
+            channel = create_channel(id, [this](const std::string& name) -> detail::TopicChannelBase* {
+                return new detail::TopicChannel<T>(name, buffer_capacity_);
+            });
+        }
+        if (!channel || channel->tag() != detail::type_tag<T>()) return nullptr;
+        return static_cast<detail::TopicChannel<T>*>(channel);
+    }
+    
+    detail::TopicChannelBase* create_channel(
+        TopicId id, const std::function<detail::TopicChannelBase*(const std::string&)>& factory);
+    void dispatch(TopicId id, const Event& event);
+    void flush_ring(TopicId id);  // Hand ring events to the subscribers
+    
+    detail::TopicChannelBase* find_channel(TopicId id) const {
+        return id < MAX_TOPICS ? channels_[id].load(std::memory_order_acquire) : nullptr;
+    }
+    
     double get_timestamp() const;
 };
 
@@ -0,0 +1,234 @@
+/**
+ * @file event_record.cpp
+ * @brief Event capture writer, reader and replay publish
+ */
+
+#include "event_record.h"
+#include "event_bus.h"
+#include <chrono>
+
+namespace melvin {
+namespace cognitive_os {
+
+namespace {
+
+template<typename T>
+bool read_value(FILE* file, T& value) {
+    return std::fread(&value, sizeof(T), 1, file) == 1;
+}
+
+template<typename T>
+bool publish_decoded(EventBus& bus, const RecordedEvent& event) {
+    T data{};
+    ByteReader r(event.payload.data(), event.payload.size());
+    if (!EventCodec<T>::decode(r, data)) return false;
+    return bus.publish(event.topic_name, data);
+}
+
+} // namespace
+
+// ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
+// RECORDER
+// ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
+
+EventRecorder::~EventRecorder() {
+    close();
+}
+
+bool EventRecorder::open(const std::string& filepath) {
+    close();
+
+    file_ = std::fopen(filepath.c_str(), "wb");
+    if (!file_) return false;
+
+    uint16_t reserved = 0;
+    std::fwrite(&EVENT_LOG_MAGIC, sizeof(EVENT_LOG_MAGIC), 1, file_);
+    std::fwrite(&EVENT_LOG_VERSION, sizeof(EVENT_LOG_VERSION), 1, file_);
+    std::fwrite(&reserved, sizeof(reserved), 1, file_);
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        pending_.clear();
+        topic_defined_.assign(EventBus::MAX_TOPICS, false);
+    }
+    recorded_.store(0, std::memory_order_relaxed);
+    dropped_.store(0, std::memory_order_relaxed);
+
+    running_.store(true, std::memory_order_relaxed);
+    writer_ = std::thread([this]() { writer_loop(); });
+    open_.store(true, std::memory_order_release);
+    return true;
+}
+
+void EventRecorder::close() {
+    if (!file_) return;
+
+    open_.store(false, std::memory_order_release);
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        running_.store(false, std::memory_order_relaxed);
+    }
+    wake_cv_.notify_all();
+    if (writer_.joinable()) {
+        writer_.join();
+    }
+
+    write_pending();
+    std::fclose(file_);
+    file_ = nullptr;
+}
+
+void EventRecorder::append(uint32_t topic, const std::string& topic_name, PayloadType type,
+                           double timestamp, const std::vector<uint8_t>& payload) {
+    if (topic >= EventBus::MAX_TOPICS) {
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!open_.load(std::memory_order_relaxed)) return;
+
+    ByteWriter w(pending_);
+    if (!topic_defined_[topic]) {
+        // Topic records are tiny and are never dropped, so every later
+        // event of this topic stays decodable
+        w.put(static_cast<uint8_t>(RecordKind::TOPIC));
+        w.put(topic);
+        w.put(static_cast<uint8_t>(type));
+        w.put(static_cast<uint16_t>(topic_name.size()));
+        pending_.insert(pending_.end(), topic_name.begin(), topic_name.end());
+        topic_defined_[topic] = true;
+    }
+
+    if (pending_.size() + payload.size() > MAX_PENDING_BYTES) {
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    w.put(static_cast<uint8_t>(RecordKind::EVENT));
+    w.put(topic);
+    w.put(timestamp);
+    w.put(static_cast<uint32_t>(payload.size()));
+    pending_.insert(pending_.end(), payload.begin(), payload.end());
+    recorded_.fetch_add(1, std::memory_order_relaxed);
+}
+
+void EventRecorder::writer_loop() {
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    while (running_.load(std::memory_order_relaxed)) {
+        wake_cv_.wait_for(lock, std::chrono::milliseconds(WRITE_INTERVAL_MS));
+
+        lock.unlock();
+        write_pending();
+        lock.lock();
+    }
+}
+
+void EventRecorder::write_pending() {
+    // Swap so publishers only wait for the swap, never for the disk
+    thread_local std::vector<uint8_t> batch;
+    batch.clear();
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        batch.swap(pending_);
+    }
+    if (batch.empty()) return;
+
+    if (std::fwrite(batch.data(), 1, batch.size(), file_) != batch.size()) {
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+    }
+    std::fflush(file_);
+}
+
+// ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
+// READER
+// ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
+
+EventLogReader::~EventLogReader() {
+    if (file_) std::fclose(file_);
+}
+
+bool EventLogReader::open(const std::string& filepath) {
+    if (file_) std::fclose(file_);
+    topics_.clear();
+
+    file_ = std::fopen(filepath.c_str(), "rb");
+    if (!file_) return false;
+
+    uint32_t magic = 0;
+    uint16_t version = 0;
+    uint16_t reserved = 0;
+    if (!read_value(file_, magic) || !read_value(file_, version) || !read_value(file_, reserved) ||
+        magic != EVENT_LOG_MAGIC || version != EVENT_LOG_VERSION) {
+        std::fclose(file_);
+        file_ = nullptr;
+        return false;
+    }
+    return true;
+}
+
+bool EventLogReader::next(RecordedEvent& event) {
+    if (!file_) return false;
+
+    uint8_t kind = 0;
+    while (read_value(file_, kind)) {
+        uint32_t topic = 0;
+        if (!read_value(file_, topic)) return false;
+
+        if (kind == static_cast<uint8_t>(RecordKind::TOPIC)) {
+            uint8_t type = 0;
+            uint16_t name_len = 0;
+            if (!read_value(file_, type) || !read_value(file_, name_len)) return false;
+            std::string name(name_len, '\0');
+            if (name_len > 0 && std::fread(&name[0], 1, name_len, file_) != name_len) return false;
+            if (topic >= topics_.size()) topics_.resize(topic + 1);
+            topics_[topic].name = name;
+            topics_[topic].type = static_cast<PayloadType>(type);
+            continue;
+        }
+
+        if (kind != static_cast<uint8_t>(RecordKind::EVENT)) return false;
+
+        uint32_t len = 0;
+        if (!read_value(file_, event.timestamp) || !read_value(file_, len)) return false;
+        event.payload.resize(len);
+        if (len > 0 && std::fread(event.payload.data(), 1, len, file_) != len) return false;
+
+        event.topic = topic;
+        if (topic < topics_.size()) {
+            event.topic_name = topics_[topic].name;
+            event.type = topics_[topic].type;
+        } else {
+            event.topic_name.clear();
+            event.type = PayloadType::UNKNOWN;
+        }
+        return true;
+    }
+    return false;
+}
+
+// ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
+// REPLAY
+// ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
+
+bool publish_recorded(EventBus& bus, const RecordedEvent& event) {
+    if (event.topic_name.empty()) return false;
+
+    switch (event.type) {
+        case PayloadType::VISION:          return publish_decoded<VisionEvent>(bus, event);
+        case PayloadType::AUDIO:           return publish_decoded<AudioEvent>(bus, event);
+        case PayloadType::MOTOR_STATE:     return publish_decoded<MotorState>(bus, event);
+        case PayloadType::COG_QUERY:       return publish_decoded<CogQuery>(bus, event);
+        case PayloadType::COG_ANSWER:      return publish_decoded<CogAnswer>(bus, event);
+        case PayloadType::FIELD_METRICS:   return publish_decoded<FieldMetrics>(bus, event);
+        case PayloadType::WM_CONTEXT:      return publish_decoded<WMContext>(bus, event);
+        case PayloadType::REFLECT_COMMAND: return publish_decoded<ReflectCommand>(bus, event);
+        case PayloadType::SAFETY:          return publish_decoded<SafetyEvent>(bus, event);
+        case PayloadType::UNKNOWN:         break;
+    }
+    return false;
+}
+
+} // namespace cognitive_os
+} // namespace melvin
@@ -0,0 +1,434 @@
+/**
+ * @file event_record.h
+ * @brief Binary capture of published bus events (record / replay)
+ *
+ * While recording is enabled, EventBus::publish encodes every typed
+ * event into a memory buffer (one short lock); a background thread
+ * appends the buffer to disk. Recorded streams are read back with
+ * EventLogReader and re-published with publish_recorded().
+ *
+ * File format (host byte order):
+ *   Header:  u32 magic "MEVR", u16 version, u16 reserved
+ *   Records: u8 kind, then
+ *     TOPIC  u32 topic id, u8 payload type, u16 name length, name
+ *     EVENT  u32 topic id, f64 publish timestamp, u32 length, payload
+ * A TOPIC record precedes the first EVENT of each topic. A trailing
+ * record cut short by a crash is ignored on read.
+ */
+
+#ifndef MELVIN_EVENT_RECORD_H
+#define MELVIN_EVENT_RECORD_H
+
+#include <string>
+#include <vector>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include "event_types.h"
+
+namespace melvin {
+namespace cognitive_os {
+
+class EventBus;
+
+constexpr uint32_t EVENT_LOG_MAGIC = 0x5256454Du;  // "MEVR"
+constexpr uint16_t EVENT_LOG_VERSION = 1;
+
+enum class RecordKind : uint8_t {
+    TOPIC = 1,
+    EVENT = 2
+};
+
+/**
+ * @brief Recorded payload types (stable on disk; append only)
+ */
+enum class PayloadType : uint8_t {
+    UNKNOWN = 0,
+    VISION = 1,
+    AUDIO = 2,
+    MOTOR_STATE = 3,
+    COG_QUERY = 4,
+    COG_ANSWER = 5,
+    FIELD_METRICS = 6,
+    WM_CONTEXT = 7,
+    REFLECT_COMMAND = 8,
+    SAFETY = 9
+};
+
+// ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
+// PAYLOAD CODECS
+// ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
+
+class ByteWriter {
+public:
+    explicit ByteWriter(std::vector<uint8_t>& out) : out_(out) {}
+
+    template<typename T>
+    void put(const T& value) {
+        const uint8_t* p = reinterpret_cast<const uint8_t*>(&value);
+        out_.insert(out_.end(), p, p + sizeof(T));
+    }
+
+    void put_string(const std::string& s) {
+        put(static_cast<uint32_t>(s.size()));
+        out_.insert(out_.end(), s.begin(), s.end());
+    }
+
+    template<typename T>
+    void put_vector(const std::vector<T>& v) {
+        put(static_cast<uint32_t>(v.size()));
+        const uint8_t* p = reinterpret_cast<const uint8_t*>(v.data());
+        out_.insert(out_.end(), p, p + v.size() * sizeof(T));
+    }
+
+    void put_strings(const std::vector<std::string>& v) {
+        put(static_cast<uint32_t>(v.size()));
+        for (const auto& s : v) put_string(s);
+    }
+
+private:
+    std::vector<uint8_t>& out_;
+};
+
+/**
+ * @brief Bounds-checked reader; every getter returns false past the end
+ */
+class ByteReader {
+public:
+    ByteReader(const uint8_t* data, size_t size) : data_(data), size_(size) {}
+
+    size_t remaining() const { return size_ - pos_; }
+
+    template<typename T>
+    bool get(T& value) {
+        if (size_ - pos_ < sizeof(T)) return false;
+        std::memcpy(&value, data_ + pos_, sizeof(T));
+        pos_ += sizeof(T);
+        return true;
+    }
+
+    bool get_string(std::string& s) {
+        uint32_t n = 0;
+        if (!get(n) || size_ - pos_ < n) return false;
+        s.assign(reinterpret_cast<const char*>(data_ + pos_), n);
+        pos_ += n;
+        return true;
+    }
+
+    template<typename T>
+    bool get_vector(std::vector<T>& v) {
+        uint32_t n = 0;
+        if (!get(n) || (size_ - pos_) / sizeof(T) < n) return false;
+        v.resize(n);
+        std::memcpy(v.data(), data_ + pos_, n * sizeof(T));
+        pos_ += n * sizeof(T);
+        return true;
+    }
+
+    bool get_strings(std::vector<std::string>& v) {
+        uint32_t n = 0;
+        if (!get(n) || n > size_ - pos_) return false;
+        v.resize(n);
+        for (auto& s : v) {
+            if (!get_string(s)) return false;
+        }
+        return true;
+    }
+
+private:
+    const uint8_t* data_;
+    size_t size_;
+    size_t pos_ = 0;
+};
+
+/**
+ * @brief Per-type encode/decode; unsupported payloads are not recorded
+ */
+template<typename T>
+struct EventCodec {
+    static constexpr PayloadType TYPE = PayloadType::UNKNOWN;
+};
+
+template<>
+struct EventCodec<VisionEvent> {
+    static constexpr PayloadType TYPE = PayloadType::VISION;
+    static void encode(const VisionEvent& e, ByteWriter& w) {
+        w.put(e.timestamp);
+        w.put_vector(e.obj_ids);
+        w.put(static_cast<uint32_t>(e.embeddings.size()));
+        for (const auto& emb : e.embeddings) w.put_vector(emb);
+        w.put_vector(e.bbox);
+    }
+    static bool decode(ByteReader& r, VisionEvent& e) {
+        uint32_t n = 0;
+        if (!r.get(e.timestamp) || !r.get_vector(e.obj_ids) || !r.get(n)) return false;
+        // Each embedding needs at least its length word
+        if (n > r.remaining() / sizeof(uint32_t)) return false;
+        e.embeddings.resize(n);
+        for (auto& emb : e.embeddings) {
+            if (!r.get_vector(emb)) return false;
+        }
+        return r.get_vector(e.bbox);
+    }
+};
+
+template<>
+struct EventCodec<AudioEvent> {
+    static constexpr PayloadType TYPE = PayloadType::AUDIO;
+    static void encode(const AudioEvent& e, ByteWriter& w) {
+        w.put(e.timestamp);
+        w.put_strings(e.phonemes);
+        w.put(e.energy);
+        w.put_vector(e.embedding);
+    }
+    static bool decode(ByteReader& r, AudioEvent& e) {
+        return r.get(e.timestamp) && r.get_strings(e.phonemes) && r.get(e.energy) &&
+               r.get_vector(e.embedding);
+    }
+};
+
+template<>
+struct EventCodec<MotorState> {
+    static constexpr PayloadType TYPE = PayloadType::MOTOR_STATE;
+    static void encode(const MotorState& e, ByteWriter& w) {
+        w.put(e.timestamp);
+        w.put_vector(e.joint_pos);
+        w.put_vector(e.joint_vel);
+        w.put_vector(e.torque);
+    }
+    static bool decode(ByteReader& r, MotorState& e) {
+        return r.get(e.timestamp) && r.get_vector(e.joint_pos) && r.get_vector(e.joint_vel) &&
+               r.get_vector(e.torque);
+    }
+};
+
+template<>
+struct EventCodec<CogQuery> {
+    static constexpr PayloadType TYPE = PayloadType::COG_QUERY;
+    static void encode(const CogQuery& e, ByteWriter& w) {
+        w.put(e.timestamp);
+        w.put_string(e.text);
+        w.put_vector(e.embedding);
+        w.put(static_cast<int32_t>(e.intent));
+    }
+    static bool decode(ByteReader& r, CogQuery& e) {
+        int32_t intent = 0;
+        if (!r.get(e.timestamp) || !r.get_string(e.text) || !r.get_vector(e.embedding) ||
+            !r.get(intent)) return false;
+        e.intent = intent;
+        return true;
+    }
+};
+
+template<>
+struct EventCodec<CogAnswer> {
+    static constexpr PayloadType TYPE = PayloadType::COG_ANSWER;
+    static void encode(const CogAnswer& e, ByteWriter& w) {
+        w.put(e.timestamp);
+        w.put_string(e.text);
+        w.put_strings(e.reasoning_chain);
+        w.put(e.confidence);
+        w.put(static_cast<uint8_t>(e.truncated));
+    }
+    static bool decode(ByteReader& r, CogAnswer& e) {
+        uint8_t truncated = 0;
+        if (!r.get(e.timestamp) || !r.get_string(e.text) || !r.get_strings(e.reasoning_chain) ||
+            !r.get(e.confidence) || !r.get(truncated)) return false;
+        e.truncated = truncated != 0;
+        return true;
+    }
+};
+
+template<>
+struct EventCodec<FieldMetrics> {
+    static constexpr PayloadType TYPE = PayloadType::FIELD_METRICS;
+    static void encode(const FieldMetrics& e, ByteWriter& w) {
+        w.put(e.timestamp);
+        w.put(static_cast<int32_t>(e.active_nodes));
+        w.put(e.energy_variance);
+        w.put(e.sparsity);
+        w.put(e.entropy);
+        w.put(e.coherence);
+        w.put(e.confidence);
+    }
+    static bool decode(ByteReader& r, FieldMetrics& e) {
+        int32_t active = 0;
+        if (!r.get(e.timestamp) || !r.get(active) || !r.get(e.energy_variance) ||
+            !r.get(e.sparsity) || !r.get(e.entropy) || !r.get(e.coherence) ||
+            !r.get(e.confidence)) return false;
+        e.active_nodes = active;
+        return true;
+    }
+};
+
+template<>
+struct EventCodec<WMContext> {
+    static constexpr PayloadType TYPE = PayloadType::WM_CONTEXT;
+    static void encode(const WMContext& e, ByteWriter& w) {
+        w.put(e.timestamp);
+        w.put_vector(e.node_ids);
+        w.put_vector(e.strengths);
+    }
+    static bool decode(ByteReader& r, WMContext& e) {
+        return r.get(e.timestamp) && r.get_vector(e.node_ids) && r.get_vector(e.strengths);
+    }
+};
+
+template<>
+struct EventCodec<ReflectCommand> {
+    static constexpr PayloadType TYPE = PayloadType::REFLECT_COMMAND;
+    static void encode(const ReflectCommand& e, ByteWriter& w) {
+        w.put(e.timestamp);
+        w.put(static_cast<int32_t>(e.mode));
+        w.put(e.beta);
+        w.put(e.theta);
+        w.put_string(e.strategy);
+    }
+    static bool decode(ByteReader& r, ReflectCommand& e) {
+        int32_t mode = 0;
+        if (!r.get(e.timestamp) || !r.get(mode) || !r.get(e.beta) || !r.get(e.theta) ||
+            !r.get_string(e.strategy)) return false;
+        e.mode = mode;
+        return true;
+    }
+};
+
+template<>
+struct EventCodec<SafetyEvent> {
+    static constexpr PayloadType TYPE = PayloadType::SAFETY;
+    static void encode(const SafetyEvent& e, ByteWriter& w) {
+        w.put(e.timestamp);
+        w.put_string(e.event_type);
+        w.put(e.severity);
+        w.put_string(e.details);
+    }
+    static bool decode(ByteReader& r, SafetyEvent& e) {
+        return r.get(e.timestamp) && r.get_string(e.event_type) && r.get(e.severity) &&
+               r.get_string(e.details);
+    }
+};
+
+// ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
+// RECORDER
+// ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
+
+/**
+ * @brief Buffered writer of bus events (owned by EventBus)
+ */
+class EventRecorder {
+public:
+    static constexpr size_t MAX_PENDING_BYTES = 32u << 20;
+    static constexpr int WRITE_INTERVAL_MS = 50;
+
+    EventRecorder() = default;
+    ~EventRecorder();
+
+    EventRecorder(const EventRecorder&) = delete;
+    EventRecorder& operator=(const EventRecorder&) = delete;
+
+    /**
+     * @brief Start a new capture file (closes any current one)
+     */
+    bool open(const std::string& filepath);
+
+    /**
+     * @brief Write everything pending and stop the writer
+     */
+    void close();
+
+    bool is_open() const { return open_.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Encode and queue one event (called from EventBus::publish)
+     */
+    template<typename T>
+    void record(uint32_t topic, const std::string& topic_name, double timestamp, const T& data) {
+        thread_local std::vector<uint8_t> scratch;
+        scratch.clear();
+        ByteWriter w(scratch);
+        EventCodec<T>::encode(data, w);
+        append(topic, topic_name, EventCodec<T>::TYPE, timestamp, scratch);
+    }
+
+    uint64_t events_recorded() const { return recorded_.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Events lost because the writer fell behind (or a write failed)
+     */
+    uint64_t events_dropped() const { return dropped_.load(std::memory_order_relaxed); }
+
+private:
+    std::atomic<bool> open_{false};
+    FILE* file_{nullptr};
+
+    std::mutex mutex_;               // Guards pending_ and topic_defined_
+    std::vector<uint8_t> pending_;
+    std::vector<bool> topic_defined_;  // By topic id, EventBus::MAX_TOPICS entries
+
+    std::thread writer_;
+    std::atomic<bool> running_{false};
+    std::condition_variable wake_cv_;
+
+    std::atomic<uint64_t> recorded_{0};
+    std::atomic<uint64_t> dropped_{0};
+
+    void append(uint32_t topic, const std::string& topic_name, PayloadType type,
+                double timestamp, const std::vector<uint8_t>& payload);
+    void writer_loop();
+    void write_pending();
+};
+
+// ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
+// READER / REPLAY
+// ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
+
+struct RecordedEvent {
+    uint32_t topic = 0;
+    std::string topic_name;
+    PayloadType type = PayloadType::UNKNOWN;
+    double timestamp = 0.0;
+    std::vector<uint8_t> payload;
+};
+
+/**
+ * @brief Sequential reader for event capture files
+ */
+class EventLogReader {
+public:
+    EventLogReader() = default;
+    ~EventLogReader();
+
+    bool open(const std::string& filepath);
+
+    /**
+     * @brief Read the next event (topic records are consumed internally)
+     *
+     * @return false at end of file or on a truncated record
+     */
+    bool next(RecordedEvent& event);
+
+private:
+    struct TopicInfo {
+        std::string name;
+        PayloadType type = PayloadType::UNKNOWN;
+    };
+
+    FILE* file_{nullptr};
+    std::vector<TopicInfo> topics_;
+};
+
+/**
+ * @brief Decode a recorded event and publish it to the same topic name
+ *
+ * @return false if the payload does not decode or the bus rejects it
+ */
+bool publish_recorded(EventBus& bus, const RecordedEvent& event);
+
+} // namespace cognitive_os
+} // namespace melvin
+
+#endif // MELVIN_EVENT_RECORD_H
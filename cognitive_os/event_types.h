@@ -0,0 +1,112 @@
+/**
+ * @file event_types.h
+ * @brief Typed payloads carried on the event bus
+ */
+
+#ifndef MELVIN_EVENT_TYPES_H
+#define MELVIN_EVENT_TYPES_H
+
+#include <string>
+#include <vector>
+
+namespace melvin {
+namespace cognitive_os {
+
+/**
+ * @brief Vision event
+ */
+struct VisionEvent {
+    double timestamp;
+    std::vector<int> obj_ids;
+    std::vector<std::vector<float>> embeddings;
+    std::vector<float> bbox;  // [x, y, w, h]
+};
+
+/**
+ * @brief Audio event
+ */
+struct AudioEvent {
+    double timestamp;
+    std::vector<std::string> phonemes;
+    float energy;
+    std::vector<float> embedding;
+};
+
+/**
+ * @brief Motor state
+ */
+struct MotorState {
+    double timestamp;
+    std::vector<float> joint_pos;
+    std::vector<float> joint_vel;
+    std::vector<float> torque;
+};
+
+/**
+ * @brief Cognitive query
+ */
+struct CogQuery {
+    double timestamp;
+    std::string text;
+    std::vector<float> embedding;
+    int intent;  // 0=DEFINE, 1=LOCATE, etc.
+};
+
+/**
+ * @brief Cognitive answer
+ */
+struct CogAnswer {
+    double timestamp;
+    std::string text;
+    std::vector<std::string> reasoning_chain;
+    float confidence;
+    bool truncated = false;  // Reasoning hit its deadline (best answer so far)
+};
+
+/**
+ * @brief Field metrics
+ */
+struct FieldMetrics {
+    double timestamp;
+    int active_nodes;
+    float energy_variance;
+    float sparsity;
+    float entropy;
+    float coherence;
+    float confidence;
+};
+
+/**
+ * @brief Working memory context
+ */
+struct WMContext {
+    double timestamp;
+    std::vector<int> node_ids;  // Max 7
+    std::vector<float> strengths;
+};
+
+/**
+ * @brief Reflection command
+ */
+struct ReflectCommand {
+    double timestamp;
+    int mode;  // 0=EXPLORATORY, 1=EXPLOITATIVE, etc.
+    float beta;
+    float theta;
+    std::string strategy;
+};
+
+/**
+ * @brief Safety event
+ */
+struct SafetyEvent {
+    double timestamp;
+    std::string event_type;  // "BACKPRESSURE", "OVERHEAT", "QUEUE_OVERFLOW"
+    float severity;  // 0-1
+    std::string details;
+};
+
+} // namespace cognitive_os
+} // namespace melvin
+
+#endif // MELVIN_EVENT_TYPES_H
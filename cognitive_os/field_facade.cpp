@@ -10,112 +10,301 @@
 namespace melvin {
 namespace cognitive_os {
 
+namespace {
+
+constexpr float ACTIVATION_FLOOR = 0.001f;  // decay() drops entries below this
+constexpr double MIN_SCALE = 1e-12;         // Fold the decay scale in below this
+
+} // namespace
+
 FieldFacade::FieldFacade(
     const std::unordered_map<int, std::vector<std::pair<int, float>>>& graph,
     const std::unordered_map<int, std::vector<float>>& embeddings
-) : graph_(graph), embeddings_(embeddings) {}
+) : FieldFacade(std::make_shared<const SharedGraph>(SharedGraph{graph, embeddings})) {}
+
+FieldFacade::FieldFacade(std::shared_ptr<const SharedGraph> shared)
+    : shared_(shared ? std::move(shared) : std::make_shared<const SharedGraph>()) {
+    global_ = std::make_shared<Session>();
+    global_->state = std::make_shared<ActivationState>();
+    sessions_[static_cast<uint32_t>(SessionId::GLOBAL)] = global_;
+}
+
+// ============================================================================
+// Global field
+// ============================================================================
 
 void FieldFacade::activate(int node_id, float delta, const std::string& source) {
-    std::lock_guard<std::mutex> lock(mutex_);
-    activations_[node_id] += delta;
-    activation_count_.fetch_add(1, std::memory_order_relaxed);
+    activate(SessionId::GLOBAL, node_id, delta, source);
 }
 
 float FieldFacade::get_activation(int node_id) {
-    std::lock_guard<std::mutex> lock(mutex_);
-    auto it = activations_.find(node_id);
-    return (it != activations_.end()) ? it->second : 0.0f;
+    return get_activation(SessionId::GLOBAL, node_id);
 }
 
 std::vector<int> FieldFacade::get_active(float threshold) {
-    std::lock_guard<std::mutex> lock(mutex_);
+    return get_active(SessionId::GLOBAL, threshold);
+}
+
+std::unordered_map<int, float> FieldFacade::get_activations(const std::vector<int>& node_ids) {
+    return get_activations(SessionId::GLOBAL, node_ids);
+}
+
+void FieldFacade::decay(float decay_rate) {
+    decay(SessionId::GLOBAL, decay_rate);
+}
+
+void FieldFacade::normalize_degrees() {
+    normalize_degrees(SessionId::GLOBAL);
+}
+
+void FieldFacade::apply_kwta(int k) {
+    apply_kwta(SessionId::GLOBAL, k);
+}
+
+FieldFacade::Metrics FieldFacade::get_metrics() {
+    return get_metrics(SessionId::GLOBAL);
+}
+
+void FieldFacade::clear() {
+    clear(SessionId::GLOBAL);
+}
+
+// ============================================================================
+// Sessions
+// ============================================================================
+
+SessionId FieldFacade::create_session() {
+    auto session = std::make_shared<Session>();
+    session->state = std::make_shared<ActivationState>();
     
-    std::vector<int> active;
-    for (const auto& [node_id, activation] : activations_) {
-        if (activation >= threshold) {
-            active.push_back(node_id);
-        }
+    std::lock_guard<std::mutex> lock(sessions_mutex_);
+    uint32_t id = next_session_id_++;
+    sessions_[id] = std::move(session);
+    return static_cast<SessionId>(id);
+}
+
+SessionId FieldFacade::fork_session(SessionId from) {
+    auto parent = find_session(from);
+    if (!parent) parent = global_;
+    
+    // Shared read-only from here on: whichever side writes first copies
+    auto session = std::make_shared<Session>();
+    {
+        std::lock_guard<std::mutex> lock(parent->mutex);
+        session->state = parent->state;
+        parent->owns_state = false;
     }
+    session->owns_state = false;
     
-    return active;
+    std::lock_guard<std::mutex> lock(sessions_mutex_);
+    uint32_t id = next_session_id_++;
+    sessions_[id] = std::move(session);
+    return static_cast<SessionId>(id);
 }
 
-std::unordered_map<int, float> FieldFacade::get_activations(const std::vector<int>& node_ids) {
-    std::lock_guard<std::mutex> lock(mutex_);
+bool FieldFacade::destroy_session(SessionId session) {
+    if (session == SessionId::GLOBAL) return false;
+    std::lock_guard<std::mutex> lock(sessions_mutex_);
+    return sessions_.erase(static_cast<uint32_t>(session)) > 0;
+}
+
+size_t FieldFacade::session_count() {
+    std::lock_guard<std::mutex> lock(sessions_mutex_);
+    return sessions_.size();
+}
+
+std::shared_ptr<FieldFacade::Session> FieldFacade::find_session(SessionId session) {
+    if (session == SessionId::GLOBAL) return global_;
+    std::lock_guard<std::mutex> lock(sessions_mutex_);
+    auto it = sessions_.find(static_cast<uint32_t>(session));
+    return it != sessions_.end() ? it->second : nullptr;
+}
+
+FieldFacade::ActivationState& FieldFacade::Session::write() {
+    if (!owns_state) {
+        // Forks may still read the shared state: take a private copy
+        state = std::make_shared<ActivationState>(*state);
+        owns_state = true;
+    }
+    return *state;
+}
+
+void FieldFacade::activate(SessionId session, int node_id, float delta, const std::string& source) {
+    (void)source;
+    auto s = find_session(session);
+    if (!s) return;
     
+    std::lock_guard<std::mutex> lock(s->mutex);
+    s->write().activate(node_id, delta);
+    activation_count_.fetch_add(1, std::memory_order_relaxed);
+}
+
+float FieldFacade::get_activation(SessionId session, int node_id) {
+    auto s = find_session(session);
+    if (!s) return 0.0f;
+    
+    std::lock_guard<std::mutex> lock(s->mutex);
+    return s->read().get(node_id);
+}
+
+std::vector<int> FieldFacade::get_active(SessionId session, float threshold) {
+    auto s = find_session(session);
+    if (!s) return {};
+    
+    std::lock_guard<std::mutex> lock(s->mutex);
+    return s->read().active(threshold);
+}
+
+std::unordered_map<int, float> FieldFacade::get_activations(SessionId session,
+                                                            const std::vector<int>& node_ids) {
     std::unordered_map<int, float> result;
+    auto s = find_session(session);
+    if (!s) return result;
+    
+    std::lock_guard<std::mutex> lock(s->mutex);
+    const auto& state = s->read();
     for (int node_id : node_ids) {
-        auto it = activations_.find(node_id);
-        if (it != activations_.end()) {
-            result[node_id] = it->second;
+        if (state.contains(node_id)) {
+            result[node_id] = state.get(node_id);
         }
     }
     
     return result;
 }
 
-void FieldFacade::decay(float decay_rate) {
-    std::lock_guard<std::mutex> lock(mutex_);
+void FieldFacade::decay(SessionId session, float decay_rate) {
+    auto s = find_session(session);
+    if (!s) return;
     
-    std::vector<int> to_remove;
-    for (auto& [node_id, activation] : activations_) {
-        activation *= (1.0f - decay_rate);
-        if (activation < 0.001f) {
-            to_remove.push_back(node_id);
-        }
-    }
+    std::lock_guard<std::mutex> lock(s->mutex);
+    if (s->read().empty()) return;  // Nothing to copy-on-write for
+    s->write().decay(decay_rate);
+}
+
+void FieldFacade::normalize_degrees(SessionId session) {
+    auto s = find_session(session);
+    if (!s) return;
+    
+    std::lock_guard<std::mutex> lock(s->mutex);
+    if (s->read().empty()) return;
+    s->write().normalize_degrees(*shared_);
+}
+
+void FieldFacade::apply_kwta(SessionId session, int k) {
+    auto s = find_session(session);
+    if (!s) return;
+    
+    std::lock_guard<std::mutex> lock(s->mutex);
+    if (s->read().empty()) return;
+    s->write().apply_kwta(k);
+}
+
+FieldFacade::Metrics FieldFacade::get_metrics(SessionId session) {
+    static const ActivationState empty;
+    auto s = find_session(session);
+    if (!s) return empty.metrics(shared_->graph.size());
     
-    for (int node_id : to_remove) {
-        activations_.erase(node_id);
+    std::lock_guard<std::mutex> lock(s->mutex);
+    return s->read().metrics(shared_->graph.size());
+}
+
+void FieldFacade::clear(SessionId session) {
+    auto s = find_session(session);
+    if (!s) return;
+    
+    std::lock_guard<std::mutex> lock(s->mutex);
+    s->state = std::make_shared<ActivationState>();  // Forks keep the old one
+    s->owns_state = true;
+}
+
+// ============================================================================
+// ActivationState
+// ============================================================================
+
+void FieldFacade::ActivationState::activate(int node_id, float delta) {
+    auto [it, inserted] = raw_.try_emplace(node_id, 0.0f);
+    float raw = it->second;
+    if (!inserted) {
+        erase({raw, node_id});
     }
+    insert(node_id, raw + static_cast<float>(delta / scale_));
 }
 
-void FieldFacade::normalize_degrees() {
-    std::lock_guard<std::mutex> lock(mutex_);
+float FieldFacade::ActivationState::get(int node_id) const {
+    auto it = raw_.find(node_id);
+    return (it != raw_.end()) ? static_cast<float>(it->second * scale_) : 0.0f;
+}
+
+std::vector<int> FieldFacade::ActivationState::active(float threshold) const {
+    std::vector<int> result;
+    for (auto it = order_.rbegin(); it != order_.rend(); ++it) {
+        if (it->first * scale_ < threshold) break;
+        result.push_back(it->second);
+    }
     
-    for (auto& [node_id, activation] : activations_) {
-        auto it = graph_.find(node_id);
-        if (it != graph_.end()) {
+    return result;
+}
+
+void FieldFacade::ActivationState::decay(float decay_rate) {
+    scale_ *= (1.0f - decay_rate);
+    
+    // Drop what fell under the floor: the low end of the index
+    while (!order_.empty() && order_.begin()->first * scale_ < ACTIVATION_FLOOR) {
+        auto key = *order_.begin();
+        erase(key);
+        raw_.erase(key.second);
+    }
+    
+    if (scale_ < MIN_SCALE) {
+        // Fold the scale into the stored values (order is unchanged)
+        for (auto& [node_id, raw] : raw_) {
+            raw = static_cast<float>(raw * scale_);
+        }
+        scale_ = 1.0;
+        rebuild();
+    }
+}
+
+void FieldFacade::ActivationState::normalize_degrees(const SharedGraph& shared) {
+    // Per-node factors reorder the index: rebuild it
+    for (auto& [node_id, raw] : raw_) {
+        auto it = shared.graph.find(node_id);
+        if (it != shared.graph.end()) {
             size_t degree = it->second.size();
             if (degree > 0) {
-                activation /= std::sqrt(static_cast<float>(degree));
+                raw /= std::sqrt(static_cast<float>(degree));
             }
         }
     }
+    rebuild();
 }
 
-void FieldFacade::apply_kwta(int k) {
-    std::lock_guard<std::mutex> lock(mutex_);
-    
-    if (activations_.empty()) return;
-    
-    // Sort by activation
-    std::vector<std::pair<int, float>> sorted;
-    for (const auto& [node_id, activation] : activations_) {
-        sorted.push_back({node_id, activation});
+void FieldFacade::ActivationState::apply_kwta(int k) {
+    // Keep top k, inhibit rest (ties at the cut are arbitrary, as before)
+    size_t keep_count = static_cast<size_t>(k);
+    if (order_.size() > 2 * keep_count) {
+        // Mostly inhibited: re-insert the k survivors instead of erasing the rest
+        std::vector<std::pair<float, int>> kept(order_.rbegin(), std::next(order_.rbegin(), keep_count));
+        raw_.clear();
+        order_.clear();
+        sum_ = sum_sq_ = positive_sum_ = positive_sum_log_ = 0.0;
+        for (const auto& [raw, node_id] : kept) {
+            insert(node_id, raw);
+        }
+        return;
     }
-    
-    std::sort(sorted.begin(), sorted.end(),
-        [](const auto& a, const auto& b) { return a.second > b.second; });
-    
-    // Keep top k, inhibit rest
-    size_t keep_count = std::min(static_cast<size_t>(k), sorted.size());
-    
-    std::unordered_map<int, float> new_activations;
-    for (size_t i = 0; i < keep_count; i++) {
-        new_activations[sorted[i].first] = sorted[i].second;
+    while (order_.size() > keep_count) {
+        auto key = *order_.begin();
+        erase(key);
+        raw_.erase(key.second);
     }
-    
-    activations_ = new_activations;
 }
 
-FieldFacade::Metrics FieldFacade::get_metrics() {
-    std::lock_guard<std::mutex> lock(mutex_);
-    
+FieldFacade::Metrics FieldFacade::ActivationState::metrics(size_t total_nodes) const {
     Metrics m;
-    m.active_nodes = activations_.size();
+    m.active_nodes = raw_.size();
     
-    if (activations_.empty()) {
+    if (raw_.empty()) {
         m.energy_variance = 0.0f;
         m.sparsity = 1.0f;
         m.entropy = 0.0f;
@@ -124,49 +313,59 @@ FieldFacade::Metrics FieldFacade::get_metrics() {
         return m;
     }
     
-    // Compute statistics
-    float sum = 0.0f;
-    float max_act = 0.0f;
+    double n = static_cast<double>(raw_.size());
+    double mean_raw = sum_ / n;
     
-    for (const auto& [node_id, activation] : activations_) {
-        sum += activation;
-        if (activation > max_act) {
-            max_act = activation;
-        }
-    }
+    m.mean_activation = static_cast<float>(mean_raw * scale_);
+    m.max_activation = std::max(0.0f, static_cast<float>(order_.rbegin()->first * scale_));
     
-    m.mean_activation = sum / activations_.size();
-    m.max_activation = max_act;
-    
-    // Variance
-    float var_sum = 0.0f;
-    for (const auto& [node_id, activation] : activations_) {
-        float diff = activation - m.mean_activation;
-        var_sum += diff * diff;
-    }
-    m.energy_variance = std::sqrt(var_sum / activations_.size());
+    // Standard deviation from the running sums
+    double var_raw = std::max(0.0, sum_sq_ / n - mean_raw * mean_raw);
+    m.energy_variance = static_cast<float>(std::sqrt(var_raw) * scale_);
     
     // Sparsity (proportion inactive)
-    size_t total_nodes = graph_.size();
-    m.sparsity = 1.0f - (static_cast<float>(activations_.size()) / total_nodes);
+    m.sparsity = 1.0f - (static_cast<float>(raw_.size()) / total_nodes);
     
-    // Entropy
+    // Entropy of p = a / sum over positive activations. The scale cancels:
+    // H = (P log2 R - sum r log2 r) / R with R the raw sum, P its positive part
     m.entropy = 0.0f;
-    for (const auto& [node_id, activation] : activations_) {
-        if (activation > 0.001f && sum > 0.001f) {
-            float p = activation / sum;
-            m.entropy -= p * std::log2(p);
-        }
+    if (sum_ * scale_ > ACTIVATION_FLOOR && positive_sum_ > 0.0) {
+        m.entropy = static_cast<float>((positive_sum_ * std::log2(sum_) - positive_sum_log_) / sum_);
     }
     
     return m;
 }
 
-void FieldFacade::clear() {
-    std::lock_guard<std::mutex> lock(mutex_);
-    activations_.clear();
+void FieldFacade::ActivationState::insert(int node_id, float raw) {
+    raw_[node_id] = raw;
+    order_.emplace(raw, node_id);
+    add_stats(raw, 1.0);
+}
+
+void FieldFacade::ActivationState::erase(std::pair<float, int> key) {
+    order_.erase(key);
+    add_stats(key.first, -1.0);
+}
+
+void FieldFacade::ActivationState::add_stats(float raw, double sign) {
+    double r = raw;
+    sum_ += sign * r;
+    sum_sq_ += sign * r * r;
+    if (r > 0.0) {
+        positive_sum_ += sign * r;
+        positive_sum_log_ += sign * r * std::log2(r);
+    }
+}
+
+void FieldFacade::ActivationState::rebuild() {
+    // Recomputed exactly, which also drops accumulated rounding
+    order_.clear();
+    sum_ = sum_sq_ = positive_sum_ = positive_sum_log_ = 0.0;
+    for (const auto& [node_id, raw] : raw_) {
+        order_.emplace(raw, node_id);
+        add_stats(raw, 1.0);
+    }
 }
 
 } // namespace cognitive_os
 } // namespace melvin
-
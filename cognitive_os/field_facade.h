@@ -2,21 +2,39 @@
  * @file field_facade.h
  * @brief Thread-safe wrapper around global activation field
  * 
- * Shared by ALL services for reading/writing activations
+ * Shared by ALL services for reading/writing activations. Besides the
+ * global field, a facade serves any number of sessions (one per
+ * conversation): sparse activation states over the same immutable graph.
  */
 
 #ifndef MELVIN_FIELD_FACADE_H
 #define MELVIN_FIELD_FACADE_H
 
 #include <unordered_map>
+#include <set>
 #include <vector>
 #include <string>
 #include <mutex>
 #include <atomic>
+#include <memory>
+#include <cstdint>
 
 namespace melvin {
 namespace cognitive_os {
 
+/**
+ * @brief Immutable graph + embeddings, shared by facades and sessions
+ */
+struct SharedGraph {
+    std::unordered_map<int, std::vector<std::pair<int, float>>> graph;
+    std::unordered_map<int, std::vector<float>> embeddings;
+};
+
+/**
+ * @brief Handle of an activation session (GLOBAL = the facade's own field)
+ */
+enum class SessionId : uint32_t { GLOBAL = 0 };
+
 /**
  * @brief Thread-safe activation field
  * 
@@ -29,6 +47,11 @@ public:
         const std::unordered_map<int, std::vector<float>>& embeddings
     );
     
+    /**
+     * @brief Share an existing graph (no copy)
+     */
+    explicit FieldFacade(std::shared_ptr<const SharedGraph> shared);
+    
     ~FieldFacade() = default;
     
     /**
@@ -89,24 +112,121 @@ public:
      */
     void clear();
     
+    // ========================================================================
+    // Sessions
+    // ========================================================================
+    
+    /**
+     * @brief New session with an empty field
+     */
+    SessionId create_session();
+    
+    /**
+     * @brief New session starting from a copy of another's field
+     * 
+     * Copy-on-write: both share the state until either one writes.
+     * Returns GLOBAL's fork when `from` is unknown.
+     */
+    SessionId fork_session(SessionId from = SessionId::GLOBAL);
+    
+    /**
+     * @brief Drop a session (GLOBAL cannot be destroyed)
+     */
+    bool destroy_session(SessionId session);
+    
+    size_t session_count();
+    
+    // Session-scoped field operations; unknown sessions read as empty and
+    // ignore writes
+    void activate(SessionId session, int node_id, float delta, const std::string& source = "");
+    float get_activation(SessionId session, int node_id);
+    std::vector<int> get_active(SessionId session, float threshold = 0.01f);
+    std::unordered_map<int, float> get_activations(SessionId session, const std::vector<int>& node_ids);
+    void decay(SessionId session, float decay_rate);
+    void normalize_degrees(SessionId session);
+    void apply_kwta(SessionId session, int k);
+    Metrics get_metrics(SessionId session);
+    void clear(SessionId session);
+    
     /**
      * @brief Get graph reference
      */
     const std::unordered_map<int, std::vector<std::pair<int, float>>>& graph() const {
-        return graph_;
+        return shared_->graph;
     }
     
     const std::unordered_map<int, std::vector<float>>& embeddings() const {
-        return embeddings_;
+        return shared_->embeddings;
     }
     
+    std::shared_ptr<const SharedGraph> shared_graph() const { return shared_; }
+    
 private:
-    std::unordered_map<int, std::vector<std::pair<int, float>>> graph_;
-    std::unordered_map<int, std::vector<float>> embeddings_;
-    std::unordered_map<int, float> activations_;
-    std::mutex mutex_;
+    /**
+     * @brief One field's activations (sparse: only nodes above the decay floor)
+     * 
+     * Values are stored raw with activation = raw * scale, so decay() is
+     * O(1) plus the entries it drops: it shrinks the scale, then pops the
+     * entries under the floor off the low end of the ordered index. Once
+     * the scale gets tiny it is folded back into the raw values. Running
+     * sums over raw values give every metric without a pass, and k-WTA
+     * trims the index from below.
+     */
+    class ActivationState {
+    public:
+        void activate(int node_id, float delta);
+        bool contains(int node_id) const { return raw_.count(node_id) > 0; }
+        float get(int node_id) const;
+        bool empty() const { return raw_.empty(); }
+        std::vector<int> active(float threshold) const;  // Most active first
+        void decay(float decay_rate);
+        void normalize_degrees(const SharedGraph& shared);
+        void apply_kwta(int k);
+        Metrics metrics(size_t total_nodes) const;
+        
+    private:
+        std::unordered_map<int, float> raw_;
+        std::set<std::pair<float, int>> order_;  // (raw, node_id) ascending
+        double scale_ = 1.0;
+        
+        // Running aggregates over raw values
+        double sum_ = 0.0;
+        double sum_sq_ = 0.0;
+        double positive_sum_ = 0.0;      // Sum of r > 0
+        double positive_sum_log_ = 0.0;  // Sum of r * log2(r), r > 0
+        
+        void insert(int node_id, float raw);
+        void erase(std::pair<float, int> key);
+        void add_stats(float raw, double sign);
+        void rebuild();  // Index and aggregates from raw_
+    };
+    
+    /**
+     * @brief A session's state; shared with forks until one of them writes
+     * 
+     * A shared state is never mutated: forking clears owns_state on both
+     * sides, and write() copies first.
+     */
+    struct Session {
+        std::mutex mutex;
+        std::shared_ptr<ActivationState> state;
+        bool owns_state = true;
+        
+        // Caller holds mutex
+        const ActivationState& read() const { return *state; }
+        ActivationState& write();
+    };
+    
+    std::shared_ptr<const SharedGraph> shared_;
+    
+    std::unordered_map<uint32_t, std::shared_ptr<Session>> sessions_;
+    std::mutex sessions_mutex_;
+    std::shared_ptr<Session> global_;  // sessions_[GLOBAL], never removed
+    uint32_t next_session_id_ = 1;
     
     std::atomic<uint64_t> activation_count_{0};
+    
+    std::shared_ptr<Session> find_session(SessionId session);
 };
 
 } // namespace cognitive_os
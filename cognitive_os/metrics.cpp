@@ -6,32 +6,167 @@
 #include "metrics.h"
 #include <sstream>
 #include <iomanip>
+#include <cstring>
+#include <chrono>
 #include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
 
 namespace melvin {
 namespace cognitive_os {
 
-MetricsLogger::MetricsLogger(const std::string& filepath) {
-    // Create logs directory if needed
-    mkdir("logs", 0755);
-    
-    file_.open(filepath, std::ios::out | std::ios::app);
-    if (!file_.is_open()) {
-        // Fallback to current directory
-        file_.open("kpis.jsonl", std::ios::out | std::ios::app);
+namespace {
+
+constexpr size_t HEADER_SIZE = 16;
+
+template<typename T>
+void put(uint8_t*& p, T value) {
+    std::memcpy(p, &value, sizeof(T));
+    p += sizeof(T);
+}
+
+template<typename T>
+void get(const uint8_t*& p, T& value) {
+    std::memcpy(&value, p, sizeof(T));
+    p += sizeof(T);
+}
+
+/**
+ * @brief True if a session header matches this build's record layout
+ */
+bool header_matches(const uint8_t* header) {
+    uint32_t magic, record_size;
+    uint16_t version, services;
+    get(header, magic);
+    get(header, version);
+    get(header, services);
+    get(header, record_size);
+    return magic == KPI_LOG_MAGIC && version == KPI_LOG_VERSION &&
+           services == BUILTIN_SERVICE_COUNT && record_size == kpi_record_size();
+}
+
+/**
+ * @brief Length of the readable prefix of an existing log: matching
+ *        session headers and complete blocks
+ */
+off_t readable_prefix(int fd, off_t size) {
+    const off_t record_size = static_cast<off_t>(kpi_record_size());
+    off_t pos = 0;
+    while (pos + static_cast<off_t>(sizeof(uint32_t)) <= size) {
+        uint32_t word;
+        if (::pread(fd, &word, sizeof(word), pos) != sizeof(word)) break;
+        if (word == KPI_LOG_MAGIC) {
+            uint8_t header[HEADER_SIZE];
+            if (::pread(fd, header, HEADER_SIZE, pos) != static_cast<ssize_t>(HEADER_SIZE) ||
+                !header_matches(header)) {
+                break;
+            }
+            pos += HEADER_SIZE;
+            continue;
+        }
+        off_t end = pos + static_cast<off_t>(sizeof(word)) + static_cast<off_t>(word) * record_size;
+        if (pos == 0 || word == 0 || end > size) break;
+        pos = end;
     }
+    return pos;
 }
 
-MetricsLogger::~MetricsLogger() {
-    if (file_.is_open()) {
-        file_.close();
+/**
+ * @brief Open a log for appending, dropping what a reader could not parse
+ *
+ * A block cut short by a crash is truncated so the next session header
+ * lands on a block boundary. A file this build cannot read at all is
+ * moved aside to <path>.old.
+ */
+int open_log(const std::string& path) {
+    int fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_APPEND, 0644);
+    if (fd < 0) return fd;
+
+    struct stat st;
+    if (::fstat(fd, &st) != 0 || st.st_size == 0) return fd;
+
+    off_t keep = readable_prefix(fd, st.st_size);
+    if (keep == 0) {
+        ::close(fd);
+        std::rename(path.c_str(), (path + ".old").c_str());
+        return ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_APPEND, 0644);
     }
+    if (keep < st.st_size && ::ftruncate(fd, keep) != 0) {
+        ::close(fd);
+        return -1;
+    }
+    return fd;
 }
 
-void MetricsLogger::log(const SystemKPIs& kpis) {
-    if (!file_.is_open()) return;
-    
-    // Write as JSON line
+bool write_all(int fd, const uint8_t* data, size_t size) {
+    while (size > 0) {
+        ssize_t n = ::write(fd, data, size);
+        if (n <= 0) return false;
+        data += n;
+        size -= static_cast<size_t>(n);
+    }
+    return true;
+}
+
+} // namespace
+
+// ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
+// RECORD ENCODING
+// ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
+
+size_t kpi_record_size() {
+    return sizeof(double)                              // timestamp
+         + sizeof(int32_t) + 6 * sizeof(float)         // field metrics
+         + 3 * sizeof(float) + sizeof(uint64_t)        // performance
+         + sizeof(int32_t) + sizeof(float)             // services
+         + BUILTIN_SERVICE_COUNT * sizeof(float)
+         + sizeof(uint64_t) + sizeof(int32_t);         // deadlines
+}
+
+void encode_kpis(const SystemKPIs& kpis, uint8_t* out) {
+    put(out, kpis.timestamp);
+    put(out, static_cast<int32_t>(kpis.active_nodes));
+    put(out, kpis.energy_variance);
+    put(out, kpis.sparsity);
+    put(out, kpis.entropy);
+    put(out, kpis.coherence);
+    put(out, kpis.confidence);
+    put(out, kpis.fps);
+    put(out, kpis.cpu_usage);
+    put(out, kpis.gpu_usage);
+    put(out, kpis.dropped_msgs);
+    put(out, static_cast<int32_t>(kpis.services_active));
+    put(out, kpis.avg_service_load);
+    for (int i = 0; i < BUILTIN_SERVICE_COUNT; i++) put(out, kpis.service_load[i]);
+    put(out, kpis.deadline_misses);
+    put(out, static_cast<int32_t>(kpis.degrade_level));
+}
+
+void decode_kpis(const uint8_t* in, SystemKPIs& kpis) {
+    int32_t i32;
+    get(in, kpis.timestamp);
+    get(in, i32); kpis.active_nodes = i32;
+    get(in, kpis.energy_variance);
+    get(in, kpis.sparsity);
+    get(in, kpis.entropy);
+    get(in, kpis.coherence);
+    get(in, kpis.confidence);
+    get(in, kpis.fps);
+    get(in, kpis.cpu_usage);
+    get(in, kpis.gpu_usage);
+    get(in, kpis.dropped_msgs);
+    get(in, i32); kpis.services_active = i32;
+    get(in, kpis.avg_service_load);
+    for (int i = 0; i < BUILTIN_SERVICE_COUNT; i++) get(in, kpis.service_load[i]);
+    get(in, kpis.deadline_misses);
+    get(in, i32); kpis.degrade_level = i32;
+}
+
+// ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
+// TEXT FORMATS
+// ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
+
+std::string kpis_to_json(const SystemKPIs& kpis) {
     std::ostringstream oss;
     oss << std::fixed << std::setprecision(6);
     oss << "{";
@@ -46,19 +181,237 @@ void MetricsLogger::log(const SystemKPIs& kpis) {
     oss << "\"cpu\":" << kpis.cpu_usage << ",";
     oss << "\"gpu\":" << kpis.gpu_usage << ",";
     oss << "\"dropped\":" << kpis.dropped_msgs << ",";
-    oss << "\"services\":" << kpis.services_active;
-    oss << "}\n";
-    
-    file_ << oss.str();
-    logs_written_.fetch_add(1, std::memory_order_relaxed);
+    oss << "\"services\":" << kpis.services_active << ",";
+    oss << "\"svc_load\":" << kpis.avg_service_load << ",";
+    oss << "\"misses\":" << kpis.deadline_misses << ",";
+    oss << "\"degrade\":" << kpis.degrade_level << ",";
+    oss << "\"svc\":{";
+    for (int i = 0; i < BUILTIN_SERVICE_COUNT; i++) {
+        if (i > 0) oss << ",";
+        oss << "\"" << builtin_service_name(i) << "\":" << kpis.service_load[i];
+    }
+    oss << "}";
+    oss << "}";
+    return oss.str();
+}
+
+std::string kpis_csv_header() {
+    std::ostringstream oss;
+    oss << "t,nodes,var,sparsity,entropy,coherence,confidence,fps,cpu,gpu,dropped,"
+           "services,svc_load,misses,degrade";
+    for (int i = 0; i < BUILTIN_SERVICE_COUNT; i++) {
+        oss << ",svc_" << builtin_service_name(i);
+    }
+    return oss.str();
+}
+
+std::string kpis_to_csv(const SystemKPIs& kpis) {
+    std::ostringstream oss;
+    oss << std::fixed << std::setprecision(6);
+    oss << kpis.timestamp << "," << kpis.active_nodes << "," << kpis.energy_variance << ","
+        << kpis.sparsity << "," << kpis.entropy << "," << kpis.coherence << ","
+        << kpis.confidence << "," << kpis.fps << "," << kpis.cpu_usage << ","
+        << kpis.gpu_usage << "," << kpis.dropped_msgs << "," << kpis.services_active << ","
+        << kpis.avg_service_load << "," << kpis.deadline_misses << "," << kpis.degrade_level;
+    for (int i = 0; i < BUILTIN_SERVICE_COUNT; i++) {
+        oss << "," << kpis.service_load[i];
+    }
+    return oss.str();
+}
+
+// ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
+// READER
+// ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
+
+KpiLogReader::~KpiLogReader() {
+    if (file_) std::fclose(file_);
+}
+
+bool KpiLogReader::open(const std::string& filepath) {
+    if (file_) std::fclose(file_);
+    file_ = std::fopen(filepath.c_str(), "rb");
+    if (!file_) return false;
+
+    uint8_t header[HEADER_SIZE];
+    if (std::fread(header, 1, HEADER_SIZE, file_) != HEADER_SIZE || !header_matches(header)) {
+        return false;
+    }
+
+    record_size_ = kpi_record_size();
+    record_.resize(record_size_);
+    block_remaining_ = 0;
+    return true;
+}
+
+bool KpiLogReader::next(SystemKPIs& kpis) {
+    if (!file_) return false;
+
+    while (block_remaining_ == 0) {
+        // Several loggers may have appended to the same file: skip their
+        // headers, but stop at one written with a different layout
+        uint32_t word;
+        if (std::fread(&word, sizeof(word), 1, file_) != 1) return false;
+        if (word == KPI_LOG_MAGIC) {
+            uint8_t header[HEADER_SIZE];
+            std::memcpy(header, &word, sizeof(word));
+            size_t rest = HEADER_SIZE - sizeof(word);
+            if (std::fread(header + sizeof(word), 1, rest, file_) != rest || !header_matches(header)) {
+                return false;
+            }
+            continue;
+        }
+        // A block cut short by a crash yields no records
+        struct stat st;
+        long pos = std::ftell(file_);
+        if (pos < 0 || ::fstat(fileno(file_), &st) != 0 ||
+            pos + static_cast<off_t>(word) * static_cast<off_t>(record_size_) > st.st_size) {
+            return false;
+        }
+        block_remaining_ = word;
+    }
+
+    if (std::fread(record_.data(), 1, record_size_, file_) != record_size_) return false;
+    block_remaining_--;
+    decode_kpis(record_.data(), kpis);
+    return true;
+}
+
+// ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
+// LOGGER
+// ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
+
+MetricsLogger::MetricsLogger(const std::string& filepath, size_t ring_capacity,
+                             const std::string& latency_filepath)
+    : ring_(ring_capacity) {
+    // Create logs directory if needed
+    mkdir("logs", 0755);
+
+    fd_ = open_log(filepath);
+    if (fd_ < 0) {
+        // Fallback to current directory
+        fd_ = open_log("kpis.bin");
+    }
+    if (fd_ < 0) return;
+
+    // Every session starts with a header so appended logs stay readable
+    uint8_t header[HEADER_SIZE] = {};
+    uint8_t* p = header;
+    put(p, KPI_LOG_MAGIC);
+    put(p, KPI_LOG_VERSION);
+    put(p, static_cast<uint16_t>(BUILTIN_SERVICE_COUNT));
+    put(p, static_cast<uint32_t>(kpi_record_size()));
+    write_all(fd_, header, HEADER_SIZE);
+
+    latency_fd_ = ::open(latency_filepath.c_str(), O_WRONLY | O_CREAT | O_APPEND, 0644);
+
+    last_fsync_ms_ = wall_time_ms();
+    last_latency_dump_ms_ = last_fsync_ms_;
+    running_.store(true, std::memory_order_relaxed);
+    writer_ = std::thread([this]() { writer_loop(); });
+}
+
+MetricsLogger::~MetricsLogger() {
+    {
+        std::lock_guard<std::mutex> lock(wake_mutex_);
+        running_.store(false, std::memory_order_relaxed);
+    }
+    wake_cv_.notify_all();
+    if (writer_.joinable()) {
+        writer_.join();
+    }
+
+    if (fd_ >= 0) {
+        std::lock_guard<std::mutex> lock(io_mutex_);
+        write_pending(true);
+        ::close(fd_);
+    }
+
+    if (latency_fd_ >= 0) {
+        dump_latencies();
+        ::close(latency_fd_);
+    }
+}
+
+void MetricsLogger::log(const SystemKPIs& kpis) {
+    if (fd_ < 0) return;
+
+    if (!ring_.try_push(kpis)) {
+        logs_dropped_.fetch_add(1, std::memory_order_relaxed);
+    }
 }
 
 void MetricsLogger::flush() {
-    if (file_.is_open()) {
-        file_.flush();
+    if (fd_ < 0) return;
+
+    std::lock_guard<std::mutex> lock(io_mutex_);
+    write_pending(true);
+}
+
+void MetricsLogger::writer_loop() {
+    std::unique_lock<std::mutex> wake_lock(wake_mutex_);
+
+    while (running_.load(std::memory_order_relaxed)) {
+        wake_cv_.wait_for(wake_lock, std::chrono::milliseconds(WRITE_INTERVAL_MS));
+
+        wake_lock.unlock();
+        {
+            std::lock_guard<std::mutex> lock(io_mutex_);
+            write_pending(false);
+        }
+        if (wall_time_ms() - last_latency_dump_ms_ >= LATENCY_DUMP_INTERVAL_MS) {
+            dump_latencies();
+        }
+        wake_lock.lock();
+    }
+}
+
+void MetricsLogger::write_pending(bool force_fsync) {
+    const size_t record_size = kpi_record_size();
+    uint32_t count = 0;
+
+    // Block header is patched in once the count is known
+    batch_.resize(sizeof(uint32_t));
+
+    SystemKPIs kpis;
+    while (ring_.try_pop(kpis)) {
+        size_t offset = batch_.size();
+        batch_.resize(offset + record_size);
+        encode_kpis(kpis, batch_.data() + offset);
+        count++;
+    }
+
+    if (count > 0) {
+        std::memcpy(batch_.data(), &count, sizeof(count));
+        if (write_all(fd_, batch_.data(), batch_.size())) {
+            logs_written_.fetch_add(count, std::memory_order_relaxed);
+        } else {
+            logs_dropped_.fetch_add(count, std::memory_order_relaxed);
+        }
+    }
+
+    double now = wall_time_ms();
+    if (force_fsync || (count > 0 && now - last_fsync_ms_ >= FSYNC_INTERVAL_MS)) {
+        ::fsync(fd_);
+        last_fsync_ms_ = now;
+    }
+}
+
+void MetricsLogger::dump_latencies() {
+    last_latency_dump_ms_ = wall_time_ms();
+    if (latency_fd_ < 0) return;
+
+    // Percentiles are cumulative since start; one line per metric
+    double timestamp = std::chrono::duration<double>(
+        std::chrono::high_resolution_clock::now().time_since_epoch()).count();
+    std::string out;
+    for (const auto& summary : metrics::LatencyRegistry::instance().snapshot()) {
+        out += metrics::to_json(summary, timestamp);
+        out += "\n";
+    }
+    if (!out.empty()) {
+        write_all(latency_fd_, reinterpret_cast<const uint8_t*>(out.data()), out.size());
     }
 }
 
 } // namespace cognitive_os
 } // namespace melvin
-
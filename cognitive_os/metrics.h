@@ -2,15 +2,29 @@
  * @file metrics.h
  * @brief KPI logging system
  * 
- * Logs per-tick metrics to JSONL
+ * Logs per-tick metrics to a compact binary log. The scheduler only
+ * copies a fixed-size sample into a lock-free ring; a background writer
+ * batches samples to disk with periodic fsync. Use kpi_convert to turn a
+ * log into JSONL or CSV offline.
+ * 
+ * The writer also dumps latency histogram percentiles (all registered
+ * metrics) to a JSONL side file every few seconds.
  */
 
 #ifndef MELVIN_METRICS_H
 #define MELVIN_METRICS_H
 
 #include <string>
-#include <fstream>
+#include <vector>
 #include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include "cpu_accounting.h"
+#include "mpmc_ring.h"
+#include "core/metrics/latency_histogram.h"
 
 namespace melvin {
 namespace cognitive_os {
@@ -38,6 +52,68 @@ struct SystemKPIs {
     // Services
     int services_active;
     float avg_service_load;
+    float service_load[BUILTIN_SERVICE_COUNT];  // Measured, fraction of one core
+    uint64_t deadline_misses;                   // Cumulative, all services
+    int degrade_level;                          // Executor overload level
+};
+
+// ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
+// BINARY LOG FORMAT
+// ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
+//
+// Header (16 bytes): magic "MKPI", u16 version, u16 service count,
+//                    u32 record size, u32 reserved
+// Blocks:            u32 record count, then count fixed-size records
+//
+// Records are packed field by field in host byte order. Each logger
+// session appends its own header. A trailing block cut short by a crash
+// is ignored on read, and truncated by the next logger before it appends,
+// so later sessions stay aligned. Readers stop at a session header with
+// a different version or record size.
+
+constexpr uint32_t KPI_LOG_MAGIC = 0x49504B4Du;  // "MKPI"
+constexpr uint16_t KPI_LOG_VERSION = 1;
+
+/**
+ * @brief Encoded size of one SystemKPIs record
+ */
+size_t kpi_record_size();
+
+void encode_kpis(const SystemKPIs& kpis, uint8_t* out);
+void decode_kpis(const uint8_t* in, SystemKPIs& kpis);
+
+/**
+ * @brief Text formats (used by the offline converter)
+ */
+std::string kpis_to_json(const SystemKPIs& kpis);
+std::string kpis_csv_header();
+std::string kpis_to_csv(const SystemKPIs& kpis);
+
+/**
+ * @brief Sequential reader for binary KPI logs
+ */
+class KpiLogReader {
+public:
+    KpiLogReader() = default;
+    ~KpiLogReader();
+    
+    /**
+     * @brief Open a log and validate its header
+     */
+    bool open(const std::string& filepath);
+    
+    /**
+     * @brief Read the next record
+     * 
+     * @return false at end of file or on a truncated block
+     */
+    bool next(SystemKPIs& kpis);
+    
+private:
+    FILE* file_{nullptr};
+    size_t record_size_{0};
+    uint32_t block_remaining_{0};
+    std::vector<uint8_t> record_;
 };
 
 /**
@@ -45,16 +121,20 @@ struct SystemKPIs {
  */
 class MetricsLogger {
 public:
-    MetricsLogger(const std::string& filepath = "logs/kpis.jsonl");
+    MetricsLogger(const std::string& filepath = "logs/kpis.bin", size_t ring_capacity = 4096,
+                  const std::string& latency_filepath = "logs/latency.jsonl");
     ~MetricsLogger();
     
     /**
      * @brief Log KPIs for this tick
+     * 
+     * Lock-free copy into the ring; never touches the disk. Counts a drop
+     * if the writer has fallen a full ring behind.
      */
     void log(const SystemKPIs& kpis);
     
     /**
-     * @brief Flush to disk
+     * @brief Write everything queued so far and fsync (blocking)
      */
     void flush();
     
@@ -65,9 +145,43 @@ public:
         return logs_written_.load(std::memory_order_relaxed);
     }
     
+    /**
+     * @brief Samples lost (ring full or disk write failed)
+     */
+    uint64_t logs_dropped() const {
+        return logs_dropped_.load(std::memory_order_relaxed);
+    }
+    
+    static constexpr int WRITE_INTERVAL_MS = 100;
+    static constexpr int FSYNC_INTERVAL_MS = 1000;
+    static constexpr int LATENCY_DUMP_INTERVAL_MS = 5000;
+    
 private:
-    std::ofstream file_;
+    MPMCRing<SystemKPIs> ring_;
+    int fd_{-1};
     std::atomic<uint64_t> logs_written_{0};
+    std::atomic<uint64_t> logs_dropped_{0};
+    
+    // Background writer
+    std::thread writer_;
+    std::atomic<bool> running_{false};
+    std::mutex wake_mutex_;
+    std::condition_variable wake_cv_;
+    std::mutex io_mutex_;          // Serializes writer and flush()
+    std::vector<uint8_t> batch_;   // Reused block buffer (guarded by io_mutex_)
+    double last_fsync_ms_{0.0};
+    
+    // Latency percentile dump (writer thread only)
+    int latency_fd_{-1};
+    double last_latency_dump_ms_{0.0};
+    
+    void writer_loop();
+    void dump_latencies();
+    
+    /**
+     * @brief Drain the ring into one block; caller holds io_mutex_
+     */
+    void write_pending(bool force_fsync);
 };
 
 } // namespace cognitive_os
@@ -0,0 +1,158 @@
+/**
+ * @file mpmc_ring.h
+ * @brief Bounded lock-free MPMC ring with preallocated typed slots
+ *
+ * Sequence-numbered cells (Vyukov style): producers and consumers claim
+ * positions with a single CAS and never take a lock. Slots are
+ * constructed once up front and reused, so a push is a move-assign into
+ * existing storage rather than a heap allocation.
+ */
+
+#ifndef MELVIN_MPMC_RING_H
+#define MELVIN_MPMC_RING_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <utility>
+
+namespace melvin {
+namespace cognitive_os {
+
+constexpr size_t CACHE_LINE_SIZE = 64;
+
+/**
+ * @brief Bounded multi-producer / multi-consumer ring buffer
+ *
+ * Capacity is rounded up to a power of two. T must be default
+ * constructible (slots are preallocated) and move assignable.
+ */
+template<typename T>
+class MPMCRing {
+public:
+    explicit MPMCRing(size_t capacity) {
+        size_t cap = 2;
+        while (cap < capacity) cap <<= 1;
+        mask_ = cap - 1;
+        cells_.reset(new Cell[cap]);
+        for (size_t i = 0; i < cap; i++) {
+            cells_[i].seq.store(i, std::memory_order_relaxed);
+        }
+        enqueue_pos_.store(0, std::memory_order_relaxed);
+        dequeue_pos_.store(0, std::memory_order_relaxed);
+    }
+
+    MPMCRing(const MPMCRing&) = delete;
+    MPMCRing& operator=(const MPMCRing&) = delete;
+
+    /**
+     * @brief Try to push; leaves value untouched when the ring is full
+     */
+    template<typename U>
+    bool try_push(U&& value) {
+        Cell* cell;
+        size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+        for (;;) {
+            cell = &cells_[pos & mask_];
+            size_t seq = cell->seq.load(std::memory_order_acquire);
+            intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+            if (diff == 0) {
+                if (enqueue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                return false;  // Full
+            } else {
+                pos = enqueue_pos_.load(std::memory_order_relaxed);
+            }
+        }
+        cell->value = std::forward<U>(value);
+        cell->seq.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Push, discarding the oldest element while the ring is full
+     *
+     * @return Number of elements dropped to make room (O(1) each)
+     */
+    template<typename U>
+    size_t push_overwrite(U&& value) {
+        size_t dropped = 0;
+        while (!try_push(std::forward<U>(value))) {  // Only moved from on success
+            if (try_consume([](T&) {})) {
+                dropped++;
+            } else {
+                // Every slot is claimed by an in-flight consumer
+                std::this_thread::yield();
+            }
+        }
+        return dropped;
+    }
+
+    /**
+     * @brief Pop the oldest element, handing it to fn in place
+     *
+     * The slot stays claimed while fn runs, so fn sees the payload
+     * without a copy. Keep fn short: producers cannot reuse that slot
+     * until it returns.
+     */
+    template<typename Fn>
+    bool try_consume(Fn&& fn) {
+        Cell* cell;
+        size_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+        for (;;) {
+            cell = &cells_[pos & mask_];
+            size_t seq = cell->seq.load(std::memory_order_acquire);
+            intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos + 1);
+            if (diff == 0) {
+                if (dequeue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                return false;  // Empty
+            } else {
+                pos = dequeue_pos_.load(std::memory_order_relaxed);
+            }
+        }
+        fn(cell->value);
+        cell->seq.store(pos + mask_ + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Pop the oldest element by move
+     */
+    bool try_pop(T& out) {
+        return try_consume([&out](T& v) { out = std::move(v); });
+    }
+
+    size_t capacity() const { return mask_ + 1; }
+
+    /**
+     * @brief Approximate element count (exact when quiescent)
+     */
+    size_t size_approx() const {
+        size_t head = dequeue_pos_.load(std::memory_order_relaxed);
+        size_t tail = enqueue_pos_.load(std::memory_order_relaxed);
+        return tail > head ? tail - head : 0;
+    }
+
+private:
+    struct alignas(CACHE_LINE_SIZE) Cell {
+        std::atomic<size_t> seq;
+        T value;
+    };
+
+    std::unique_ptr<Cell[]> cells_;
+    size_t mask_;
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> enqueue_pos_;
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> dequeue_pos_;
+};
+
+} // namespace cognitive_os
+} // namespace melvin
+
+#endif // MELVIN_MPMC_RING_H
@@ -9,6 +9,8 @@
 #define MELVIN_SERVICE_BASE_H
 
 #include "event_bus.h"
+#include "cpu_accounting.h"
+#include "core/metrics/latency_histogram.h"
 #include <string>
 #include <atomic>
 #include <chrono>
@@ -24,7 +26,10 @@ struct ServiceStats {
     uint64_t budget_overruns;
     double avg_tick_time_ms;
     double max_tick_time_ms;
-    double cpu_usage;
+    double avg_cpu_time_ms;
+    double p50_tick_time_ms;   // From the service's latency histogram
+    double p99_tick_time_ms;
+    double cpu_usage;          // % of one core over the service period (measured CPU time)
     bool is_running;
 };
 
@@ -39,9 +44,13 @@ public:
         period_ms_(1000.0f / frequency_hz),
         budget_ms_(period_ms_ * 0.8f),  // 80% of period by default
         bus_(bus),
+        latency_(metrics::latency_metric("service." + name)),
         running_(false),
         ticks_(0),
-        overruns_(0)
+        overruns_(0),
+        avg_tick_time_(0.0),
+        max_tick_time_(0.0),
+        avg_cpu_time_(0.0)
     {}
     
     virtual ~ServiceBase() = default;
@@ -59,6 +68,22 @@ public:
      */
     virtual double tick(float budget_ms) = 0;
     
+    /**
+     * @brief Run one tick with wall and thread-CPU time accounting
+     * 
+     * @return Wall time used in milliseconds
+     */
+    double run_tick(float budget_ms) {
+        double wall_start = wall_time_ms();
+        double cpu_start = thread_cpu_time_ms();
+        tick(budget_ms);
+        double cpu_ms = thread_cpu_time_ms() - cpu_start;
+        double wall_ms = wall_time_ms() - wall_start;
+        latency_.record_ms(wall_ms);
+        update_stats(wall_ms, cpu_ms);
+        return wall_ms;
+    }
+    
     /**
      * @brief Shutdown service (called once)
      */
@@ -101,7 +126,11 @@ public:
         s.budget_overruns = overruns_.load(std::memory_order_relaxed);
         s.avg_tick_time_ms = avg_tick_time_;
         s.max_tick_time_ms = max_tick_time_;
-        s.cpu_usage = (avg_tick_time_ / period_ms_) * 100.0f;
+        s.avg_cpu_time_ms = avg_cpu_time_;
+        auto latency = latency_.summary();
+        s.p50_tick_time_ms = latency.p50_ms;
+        s.p99_tick_time_ms = latency.p99_ms;
+        s.cpu_usage = (avg_cpu_time_ / period_ms_) * 100.0f;
         s.is_running = running_.load(std::memory_order_relaxed);
         return s;
     }
@@ -112,6 +141,7 @@ protected:
     float period_ms_;
     float budget_ms_;
     EventBus* bus_;
+    metrics::LatencyMetric& latency_;  // Tick wall-time histogram ("service.<name>")
     
     std::atomic<bool> running_;
     std::atomic<uint64_t> ticks_;
@@ -119,11 +149,15 @@ protected:
     
     double avg_tick_time_;
     double max_tick_time_;
+    double avg_cpu_time_;
     
     /**
      * @brief Update timing statistics
+     * 
+     * @param tick_time_ms Wall time of the tick
+     * @param cpu_time_ms Thread CPU time of the tick (< 0 if not measured)
      */
-    void update_stats(double tick_time_ms) {
+    void update_stats(double tick_time_ms, double cpu_time_ms = -1.0) {
         ticks_.fetch_add(1, std::memory_order_relaxed);
         
         if (tick_time_ms > budget_ms_) {
@@ -133,6 +167,9 @@ protected:
         // Exponential moving average
         const float alpha = 0.1f;
         avg_tick_time_ = alpha * tick_time_ms + (1.0f - alpha) * avg_tick_time_;
+        if (cpu_time_ms >= 0.0) {
+            avg_cpu_time_ = alpha * cpu_time_ms + (1.0f - alpha) * avg_cpu_time_;
+        }
         
         if (tick_time_ms > max_tick_time_) {
             max_tick_time_ = tick_time_ms;
@@ -0,0 +1,307 @@
+/**
+ * @file service_executor.cpp
+ * @brief Implementation of the EDF service executor
+ */
+
+#include "service_executor.h"
+#include <algorithm>
+
+namespace melvin {
+namespace cognitive_os {
+
+namespace {
+
+double ms_between(std::chrono::steady_clock::time_point a, std::chrono::steady_clock::time_point b) {
+    return std::chrono::duration<double, std::milli>(b - a).count();
+}
+
+std::chrono::steady_clock::duration to_duration(double ms) {
+    return std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+        std::chrono::duration<double, std::milli>(ms));
+}
+
+constexpr double STATS_ALPHA = 0.1;      // EMA weight for exec time / jitter
+constexpr double MISS_ALPHA = 0.05;      // EMA weight for overload detection
+constexpr double DEGRADE_UP_MS = 500.0;  // Min time between escalations
+constexpr double DEGRADE_DOWN_MS = 2000.0;
+
+} // namespace
+
+ServiceExecutor::ServiceExecutor(size_t workers, CpuAccountant* accountant)
+    : worker_count_(workers), accountant_(accountant) {
+    if (worker_count_ == 0) {
+        unsigned hw = std::thread::hardware_concurrency();
+        worker_count_ = std::max<size_t>(2, std::min<size_t>(4, hw));
+    }
+    last_degrade_change_ = Clock::now();
+}
+
+ServiceExecutor::~ServiceExecutor() {
+    stop();
+}
+
+int ServiceExecutor::add_task(const TaskSpec& spec) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto task = std::make_unique<Task>();
+    task->spec = spec;
+    if (task->spec.deadline_ms <= 0.0f) {
+        task->spec.deadline_ms = task->spec.period_ms;
+    }
+    task->budget_ms.store(spec.budget_ms, std::memory_order_relaxed);
+    task->latency = &metrics::latency_metric("service." + spec.name);
+    tasks_.push_back(std::move(task));
+    return static_cast<int>(tasks_.size()) - 1;
+}
+
+void ServiceExecutor::start() {
+    if (running_.load(std::memory_order_relaxed)) {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto now = Clock::now();
+        for (auto& task : tasks_) {
+            task->next_release = now;
+            task->deadline = now + to_duration(task->spec.deadline_ms);
+        }
+        last_degrade_change_ = now;
+        running_.store(true, std::memory_order_relaxed);
+    }
+
+    for (size_t i = 0; i < worker_count_; i++) {
+        workers_.emplace_back([this]() { worker_loop(); });
+    }
+}
+
+void ServiceExecutor::stop() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        running_.store(false, std::memory_order_relaxed);
+    }
+    cv_.notify_all();
+
+    for (auto& worker : workers_) {
+        if (worker.joinable()) worker.join();
+    }
+    workers_.clear();
+}
+
+void ServiceExecutor::join() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    cv_.wait(lock, [this]() { return !running_.load(std::memory_order_relaxed); });
+}
+
+void ServiceExecutor::set_budget(int task, float budget_ms) {
+    if (task < 0 || task >= static_cast<int>(tasks_.size())) return;
+    tasks_[task]->budget_ms.store(budget_ms, std::memory_order_relaxed);
+}
+
+// ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
+// WORKERS
+// ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
+
+void ServiceExecutor::worker_loop() {
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    while (running_.load(std::memory_order_relaxed)) {
+        auto now = Clock::now();
+        Clock::time_point next_wakeup = now + std::chrono::milliseconds(100);
+        int idx = pick_task(now, next_wakeup);
+
+        if (idx < 0) {
+            cv_.wait_until(lock, next_wakeup);
+            continue;
+        }
+
+        Task& task = *tasks_[idx];
+        Clock::time_point release = task.next_release;
+
+        // Claim the job and schedule the next release (overrun debt delays it)
+        task.running = true;
+        busy_groups_ |= task.spec.exclusion_group;
+        task.releases++;
+        task.deadline = release + to_duration(task.spec.deadline_ms);
+        task.next_release = release + to_duration(task.spec.period_ms * period_scale(task) + task.debt_ms);
+        task.debt_ms = 0.0;
+        float budget = task.budget_ms.load(std::memory_order_relaxed);
+
+        lock.unlock();
+
+        auto start = Clock::now();
+        double cpu_start = thread_cpu_time_ms();
+        task.spec.fn(budget);
+        double cpu_ms = thread_cpu_time_ms() - cpu_start;
+        auto end = Clock::now();
+
+        task.latency->record_ns(static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count()));
+
+        if (accountant_ && task.spec.account_slot >= 0) {
+            accountant_->record(task.spec.account_slot, cpu_ms);
+        }
+
+        lock.lock();
+
+        finish_task(task, release, start, end, cpu_ms);
+        task.running = false;
+        busy_groups_ &= ~task.spec.exclusion_group;
+        cv_.notify_all();
+    }
+}
+
+int ServiceExecutor::pick_task(Clock::time_point now, Clock::time_point& next_wakeup) {
+    int best = -1;
+    Clock::time_point best_deadline = Clock::time_point::max();
+
+    for (size_t i = 0; i < tasks_.size(); i++) {
+        Task& task = *tasks_[i];
+        auto period = to_duration(task.spec.period_ms * period_scale(task));
+
+        if (task.next_release > now) {
+            next_wakeup = std::min(next_wakeup, task.next_release);
+            continue;
+        }
+
+        // Paused tasks let their releases lapse
+        if (paused(task)) {
+            while (task.next_release <= now) {
+                task.next_release += period;
+                task.skipped++;
+            }
+            next_wakeup = std::min(next_wakeup, task.next_release);
+            continue;
+        }
+
+        // Late by whole periods: skip to the most recent release
+        while (now - task.next_release >= period) {
+            task.next_release += period;
+            task.skipped++;
+            task.deadline_misses++;
+        }
+
+        if (task.running || (task.spec.exclusion_group & busy_groups_)) {
+            continue;  // Woken again when the blocking job finishes
+        }
+
+        auto deadline = task.next_release + to_duration(task.spec.deadline_ms);
+        if (deadline < best_deadline) {
+            best_deadline = deadline;
+            best = static_cast<int>(i);
+        }
+    }
+
+    return best;
+}
+
+void ServiceExecutor::finish_task(Task& task, Clock::time_point release, Clock::time_point start,
+                                  Clock::time_point end, double cpu_ms) {
+    double exec_ms = ms_between(start, end);
+    double jitter_ms = std::max(0.0, ms_between(release, start));
+    bool missed = end > task.deadline;
+    float budget = task.budget_ms.load(std::memory_order_relaxed);
+
+    task.completions++;
+    task.avg_exec_ms = STATS_ALPHA * exec_ms + (1.0 - STATS_ALPHA) * task.avg_exec_ms;
+    task.max_exec_ms = std::max(task.max_exec_ms, exec_ms);
+    task.avg_jitter_ms = STATS_ALPHA * jitter_ms + (1.0 - STATS_ALPHA) * task.avg_jitter_ms;
+    task.max_jitter_ms = std::max(task.max_jitter_ms, jitter_ms);
+
+    if (missed) {
+        task.deadline_misses++;
+    }
+
+    // Budget enforcement: overrun CPU time is paid back by delaying the
+    // next release (capped at one period so a task is never starved)
+    if (cpu_ms > budget) {
+        task.budget_overruns++;
+        task.debt_ms = std::min<double>(cpu_ms - budget, task.spec.period_ms);
+    }
+
+    if (task.spec.criticality != Criticality::LOW) {
+        miss_rate_ema_ = MISS_ALPHA * (missed ? 1.0 : 0.0) + (1.0 - MISS_ALPHA) * miss_rate_ema_;
+    }
+
+    update_degrade_level(end);
+}
+
+// ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
+// OVERLOAD DEGRADATION
+// ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
+
+void ServiceExecutor::update_degrade_level(Clock::time_point now) {
+    int level = degrade_level_.load(std::memory_order_relaxed);
+    float load = load_.load(std::memory_order_relaxed);
+    double since_change = ms_between(last_degrade_change_, now);
+
+    if ((miss_rate_ema_ > 0.10 || load > 0.90f) && level < MAX_DEGRADE_LEVEL &&
+        since_change > DEGRADE_UP_MS) {
+        degrade_level_.store(level + 1, std::memory_order_relaxed);
+        last_degrade_change_ = now;
+    } else if (miss_rate_ema_ < 0.02 && load < 0.70f && level > 0 &&
+               since_change > DEGRADE_DOWN_MS) {
+        degrade_level_.store(level - 1, std::memory_order_relaxed);
+        last_degrade_change_ = now;
+    }
+}
+
+double ServiceExecutor::period_scale(const Task& task) const {
+    int level = degrade_level_.load(std::memory_order_relaxed);
+    switch (task.spec.criticality) {
+        case Criticality::LOW:
+            return level >= 2 ? 4.0 : (level >= 1 ? 2.0 : 1.0);
+        case Criticality::NORMAL:
+            return level >= MAX_DEGRADE_LEVEL ? 2.0 : 1.0;
+        case Criticality::HIGH:
+        default:
+            return 1.0;
+    }
+}
+
+bool ServiceExecutor::paused(const Task& task) const {
+    return task.spec.criticality == Criticality::LOW &&
+           degrade_level_.load(std::memory_order_relaxed) >= MAX_DEGRADE_LEVEL;
+}
+
+// ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
+// STATS
+// ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
+
+std::vector<TaskStats> ServiceExecutor::stats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::vector<TaskStats> result;
+    result.reserve(tasks_.size());
+
+    for (const auto& task : tasks_) {
+        TaskStats s;
+        s.name = task->spec.name;
+        s.releases = task->releases;
+        s.completions = task->completions;
+        s.deadline_misses = task->deadline_misses;
+        s.skipped = task->skipped;
+        s.budget_overruns = task->budget_overruns;
+        s.avg_exec_ms = task->avg_exec_ms;
+        s.max_exec_ms = task->max_exec_ms;
+        auto latency = task->latency->summary();
+        s.p50_exec_ms = latency.p50_ms;
+        s.p99_exec_ms = latency.p99_ms;
+        s.p999_exec_ms = latency.p999_ms;
+        s.avg_jitter_ms = task->avg_jitter_ms;
+        s.max_jitter_ms = task->max_jitter_ms;
+        s.budget_ms = task->budget_ms.load(std::memory_order_relaxed);
+        s.effective_period_ms = static_cast<float>(task->spec.period_ms * period_scale(*task));
+        result.push_back(s);
+    }
+
+    return result;
+}
+
+uint64_t ServiceExecutor::total_deadline_misses() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    uint64_t total = 0;
+    for (const auto& task : tasks_) total += task->deadline_misses;
+    return total;
+}
+
+} // namespace cognitive_os
+} // namespace melvin
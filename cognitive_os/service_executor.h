@@ -0,0 +1,181 @@
+/**
+ * @file service_executor.h
+ * @brief Deadline-aware multi-threaded executor for periodic services
+ *
+ * Services are periodic tasks dispatched to a worker pool in
+ * earliest-deadline-first order. Tasks in the same exclusion group never
+ * run concurrently (they share state), and each task has at most one job
+ * in flight. Budgets are enforced by debiting overruns from the next
+ * release, and low-criticality tasks are slowed down first when the
+ * system starts missing deadlines.
+ */
+
+#ifndef MELVIN_SERVICE_EXECUTOR_H
+#define MELVIN_SERVICE_EXECUTOR_H
+
+#include "cpu_accounting.h"
+#include "core/metrics/latency_histogram.h"
+#include <vector>
+#include <string>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <cstdint>
+
+namespace melvin {
+namespace cognitive_os {
+
+/**
+ * @brief How important a task is when the system is overloaded
+ */
+enum class Criticality {
+    HIGH,    // Never degraded
+    NORMAL,  // Slowed only at the highest degrade level
+    LOW      // Slowed first, paused under heavy overload
+};
+
+/**
+ * @brief Periodic task description
+ */
+struct TaskSpec {
+    std::string name;
+    float period_ms = 20.0f;
+    float deadline_ms = 0.0f;       // Relative deadline (0 = period)
+    float budget_ms = 1.0f;         // CPU budget per job (updatable)
+    Criticality criticality = Criticality::NORMAL;
+    uint32_t exclusion_group = 0;   // Tasks sharing a group are serialized
+    int account_slot = -1;          // CpuAccountant slot (-1 = none)
+    std::function<void(float budget_ms)> fn;
+};
+
+/**
+ * @brief Per-task execution statistics
+ */
+struct TaskStats {
+    std::string name;
+    uint64_t releases;
+    uint64_t completions;
+    uint64_t deadline_misses;
+    uint64_t skipped;           // Releases dropped (late by a full period or paused)
+    uint64_t budget_overruns;
+    double avg_exec_ms;
+    double max_exec_ms;
+    double p50_exec_ms;         // From the task's latency histogram
+    double p99_exec_ms;
+    double p999_exec_ms;
+    double avg_jitter_ms;       // Start time - release time (EMA)
+    double max_jitter_ms;
+    float budget_ms;
+    float effective_period_ms;  // After degradation
+};
+
+/**
+ * @brief EDF executor over a fixed worker pool
+ */
+class ServiceExecutor {
+public:
+    /**
+     * @param workers Worker thread count (0 = min(4, hardware threads), at least 2)
+     * @param accountant Optional CPU accountant for per-task attribution
+     */
+    explicit ServiceExecutor(size_t workers = 0, CpuAccountant* accountant = nullptr);
+    ~ServiceExecutor();
+
+    /**
+     * @brief Register a task (before start())
+     *
+     * @return Task index
+     */
+    int add_task(const TaskSpec& spec);
+
+    void start();
+    void stop();
+
+    /**
+     * @brief Block until stop() has been called and workers have exited
+     */
+    void join();
+
+    bool is_running() const { return running_.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Update a task's CPU budget (thread-safe)
+     */
+    void set_budget(int task, float budget_ms);
+
+    /**
+     * @brief Feed the measured process load into overload detection (0-1)
+     */
+    void set_load(float load) { load_.store(load, std::memory_order_relaxed); }
+
+    /**
+     * @brief Current degrade level (0 = nominal, 3 = heavy overload)
+     */
+    int degrade_level() const { return degrade_level_.load(std::memory_order_relaxed); }
+
+    std::vector<TaskStats> stats() const;
+
+    /**
+     * @brief Total deadline misses across all tasks
+     */
+    uint64_t total_deadline_misses() const;
+
+    static constexpr int MAX_DEGRADE_LEVEL = 3;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct Task {
+        TaskSpec spec;
+        metrics::LatencyMetric* latency = nullptr;  // "service.<name>" exec time
+        std::atomic<float> budget_ms{0.0f};
+        Clock::time_point next_release;
+        Clock::time_point deadline;
+        bool running = false;
+        double debt_ms = 0.0;   // Budget overrun carried into the next release
+
+        // Stats (guarded by mutex_)
+        uint64_t releases = 0;
+        uint64_t completions = 0;
+        uint64_t deadline_misses = 0;
+        uint64_t skipped = 0;
+        uint64_t budget_overruns = 0;
+        double avg_exec_ms = 0.0;
+        double max_exec_ms = 0.0;
+        double avg_jitter_ms = 0.0;
+        double max_jitter_ms = 0.0;
+    };
+
+    std::vector<std::unique_ptr<Task>> tasks_;
+    std::vector<std::thread> workers_;
+    size_t worker_count_;
+    CpuAccountant* accountant_;
+
+    mutable std::mutex mutex_;
+    std::condition_variable cv_;
+    std::atomic<bool> running_{false};
+    uint32_t busy_groups_ = 0;
+
+    // Overload detection
+    std::atomic<float> load_{0.0f};
+    std::atomic<int> degrade_level_{0};
+    double miss_rate_ema_ = 0.0;
+    Clock::time_point last_degrade_change_;
+
+    void worker_loop();
+    int pick_task(Clock::time_point now, Clock::time_point& next_wakeup);
+    void finish_task(Task& task, Clock::time_point release, Clock::time_point start,
+                     Clock::time_point end, double cpu_ms);
+    void update_degrade_level(Clock::time_point now);
+    double period_scale(const Task& task) const;
+    bool paused(const Task& task) const;
+};
+
+} // namespace cognitive_os
+} // namespace melvin
+
+#endif // MELVIN_SERVICE_EXECUTOR_H
@@ -0,0 +1,232 @@
+/**
+ * @file subscription.cpp
+ * @brief Implementation of per-subscriber queues and wakeups
+ */
+
+#include "subscription.h"
+#include "event_bus.h"
+#include <algorithm>
+
+#ifdef __linux__
+#include <sys/eventfd.h>
+#include <poll.h>
+#include <unistd.h>
+#endif
+
+namespace melvin {
+namespace cognitive_os {
+
+namespace {
+
+double now_seconds() {
+    auto now = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration<double>(now.time_since_epoch()).count();
+}
+
+} // namespace
+
+// ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
+// WAKEUP
+// ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
+
+Wakeup::Wakeup() {
+#ifdef __linux__
+    fd_ = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+#endif
+}
+
+Wakeup::~Wakeup() {
+#ifdef __linux__
+    if (fd_ >= 0) close(fd_);
+#endif
+}
+
+void Wakeup::signal() {
+#ifdef __linux__
+    if (fd_ >= 0) {
+        uint64_t one = 1;
+        ssize_t n = write(fd_, &one, sizeof(one));
+        (void)n;  // EAGAIN only when the counter saturates: already signaled
+        return;
+    }
+#endif
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        signaled_ = true;
+    }
+    cv_.notify_one();
+}
+
+bool Wakeup::wait_for(double timeout_ms) {
+#ifdef __linux__
+    if (fd_ >= 0) {
+        struct pollfd pfd;
+        pfd.fd = fd_;
+        pfd.events = POLLIN;
+        pfd.revents = 0;
+        int ret = poll(&pfd, 1, std::max(0, static_cast<int>(timeout_ms)));
+        if (ret > 0 && (pfd.revents & POLLIN)) {
+            consume();
+            return true;
+        }
+        return false;
+    }
+#endif
+    std::unique_lock<std::mutex> lock(mutex_);
+    bool ok = cv_.wait_for(lock, std::chrono::duration<double, std::milli>(timeout_ms),
+                           [this]() { return signaled_; });
+    signaled_ = false;
+    return ok;
+}
+
+void Wakeup::consume() {
+#ifdef __linux__
+    if (fd_ >= 0) {
+        uint64_t value;
+        ssize_t n = read(fd_, &value, sizeof(value));
+        (void)n;
+        return;
+    }
+#endif
+    std::lock_guard<std::mutex> lock(mutex_);
+    signaled_ = false;
+}
+
+// ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
+// SUBSCRIPTION
+// ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
+
+Subscription::Subscription(const std::string& topic, const SubscriptionOptions& options)
+    : topic_(topic), options_(options), lag_(metrics::latency_metric(detail::lag_metric_name(topic))) {
+    if (options_.policy == DeliveryPolicy::COALESCE_LATEST) {
+        options_.queue_capacity = 1;
+    }
+    options_.queue_capacity = std::max<size_t>(1, options_.queue_capacity);
+    slots_.resize(options_.queue_capacity);
+    scratch_.reserve(options_.queue_capacity);
+}
+
+Subscription::~Subscription() = default;
+
+size_t Subscription::deliver(const Event& event) {
+    if (closed()) return 0;
+    
+    size_t dropped = 0;
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        const size_t capacity = slots_.size();
+        
+        if (count_ == capacity && options_.policy == DeliveryPolicy::BLOCK) {
+            blocked_++;
+            space_cv_.wait_for(lock, std::chrono::duration<double, std::milli>(options_.block_timeout_ms),
+                               [this, capacity]() { return count_ < capacity || closed(); });
+            if (closed()) return 0;
+        }
+        
+        if (count_ == capacity) {
+            // Overwrite the oldest slot
+            head_ = (head_ + 1) % capacity;
+            count_--;
+            if (options_.policy == DeliveryPolicy::COALESCE_LATEST) {
+                coalesced_++;
+            } else {
+                dropped_++;
+                dropped++;
+            }
+        }
+        
+        slots_[(head_ + count_) % capacity] = event;
+        count_++;
+        max_queue_depth_ = std::max(max_queue_depth_, count_);
+    }
+    
+    wakeup_.signal();
+    return dropped;
+}
+
+bool Subscription::wait_for(double timeout_ms) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (count_ > 0) return true;
+    }
+    if (closed()) return false;
+    
+    wakeup_.wait_for(timeout_ms);
+    
+    std::lock_guard<std::mutex> lock(mutex_);
+    return count_ > 0;
+}
+
+size_t Subscription::drain(const std::function<void(const Event&)>& fn) {
+    // Reset the wakeup first so a deliver() racing with us stays signaled
+    wakeup_.consume();
+    scratch_.clear();
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        const size_t capacity = slots_.size();
+        for (size_t i = 0; i < count_; i++) {
+            scratch_.push_back(std::move(slots_[(head_ + i) % capacity]));
+        }
+        head_ = 0;
+        count_ = 0;
+    }
+    space_cv_.notify_all();
+    
+    if (scratch_.empty()) return 0;
+    
+    // Lag is measured at hand-off, before the callback runs
+    double now = now_seconds();
+    double max_lag = 0.0;
+    double sum_lag = 0.0;
+    for (const auto& event : scratch_) {
+        double lag_ms = (now - event.timestamp) * 1000.0;
+        lag_.record_ms(lag_ms);
+        sum_lag += lag_ms;
+        max_lag = std::max(max_lag, lag_ms);
+    }
+    
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        delivered_ += scratch_.size();
+        const double alpha = 0.1;
+        avg_lag_ms_ = alpha * (sum_lag / scratch_.size()) + (1.0 - alpha) * avg_lag_ms_;
+        max_lag_ms_ = std::max(max_lag_ms_, max_lag);
+    }
+    
+    for (const auto& event : scratch_) {
+        fn(event);
+    }
+    
+    size_t n = scratch_.size();
+    scratch_.clear();
+    return n;
+}
+
+void Subscription::close() {
+    closed_.store(true, std::memory_order_relaxed);
+    {
+        // Pair with the predicate check in deliver()
+        std::lock_guard<std::mutex> lock(mutex_);
+    }
+    space_cv_.notify_all();
+    wakeup_.signal();
+}
+
+SubscriberStats Subscription::stats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    SubscriberStats s;
+    s.name = options_.name;
+    s.topic = topic_;
+    s.delivered = delivered_;
+    s.dropped = dropped_;
+    s.coalesced = coalesced_;
+    s.blocked = blocked_;
+    s.queue_depth = count_;
+    s.max_queue_depth = max_queue_depth_;
+    s.avg_lag_ms = avg_lag_ms_;
+    s.max_lag_ms = max_lag_ms_;
+    return s;
+}
+
+} // namespace cognitive_os
+} // namespace melvin
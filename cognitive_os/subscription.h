@@ -0,0 +1,182 @@
+/**
+ * @file subscription.h
+ * @brief Push-based event delivery: per-subscriber queues with wakeups
+ *
+ * Each subscriber owns a bounded queue and a wakeup handle (eventfd on
+ * Linux, so hardware loops can poll() it alongside device fds). The
+ * EventBus fans published events out to subscriber queues according to
+ * each subscriber's delivery policy.
+ */
+
+#ifndef MELVIN_SUBSCRIPTION_H
+#define MELVIN_SUBSCRIPTION_H
+
+#include <string>
+#include <vector>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <functional>
+#include "core/metrics/latency_histogram.h"
+
+namespace melvin {
+namespace cognitive_os {
+
+struct Event;
+
+/**
+ * @brief What to do when a subscriber queue is full
+ */
+enum class DeliveryPolicy {
+    DROP_OLDEST,      // Discard the oldest queued event (default)
+    BLOCK,            // Block the publisher until space (bounded by block_timeout_ms)
+    COALESCE_LATEST   // Keep only the newest event (state-like topics)
+};
+
+/**
+ * @brief Subscriber configuration
+ */
+struct SubscriptionOptions {
+    std::string name = "subscriber";
+    DeliveryPolicy policy = DeliveryPolicy::DROP_OLDEST;
+    size_t queue_capacity = 256;
+    float block_timeout_ms = 50.0f;  // BLOCK falls back to DROP_OLDEST after this
+};
+
+/**
+ * @brief Per-subscriber delivery statistics
+ */
+struct SubscriberStats {
+    std::string name;
+    std::string topic;
+    uint64_t delivered;
+    uint64_t dropped;
+    uint64_t coalesced;
+    uint64_t blocked;          // Publishes that had to wait for space
+    size_t queue_depth;
+    size_t max_queue_depth;
+    double avg_lag_ms;         // Publish -> delivery latency (EMA)
+    double max_lag_ms;
+};
+
+/**
+ * @brief Wakeup handle (eventfd on Linux, condition variable elsewhere)
+ */
+class Wakeup {
+public:
+    Wakeup();
+    ~Wakeup();
+
+    Wakeup(const Wakeup&) = delete;
+    Wakeup& operator=(const Wakeup&) = delete;
+
+    /**
+     * @brief Wake one waiter (idempotent until consumed)
+     */
+    void signal();
+
+    /**
+     * @brief Wait until signaled or timeout
+     *
+     * @return true if signaled
+     */
+    bool wait_for(double timeout_ms);
+
+    /**
+     * @brief Pollable file descriptor, -1 if unavailable
+     */
+    int fd() const { return fd_; }
+
+    /**
+     * @brief Reset after the fd was reported readable by an external poll()
+     */
+    void consume();
+
+private:
+    int fd_{-1};
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    bool signaled_{false};
+};
+
+/**
+ * @brief One subscriber's queue
+ */
+class Subscription {
+public:
+    Subscription(const std::string& topic, const SubscriptionOptions& options);
+    ~Subscription();
+
+    /**
+     * @brief Enqueue an event according to the delivery policy
+     *
+     * Called by the EventBus on the publishing thread.
+     *
+     * @return Number of events dropped to make room (coalescing is not a drop)
+     */
+    size_t deliver(const Event& event);
+
+    /**
+     * @brief Wait until events are pending, the subscription closes or timeout
+     *
+     * @return true if events are pending
+     */
+    bool wait_for(double timeout_ms);
+
+    /**
+     * @brief Pop all pending events and hand them to fn (outside the lock)
+     *
+     * Single consumer: only the owning loop or delivery thread may drain.
+     *
+     * @return Number of events delivered
+     */
+    size_t drain(const std::function<void(const Event&)>& fn);
+
+    /**
+     * @brief Close: wakes waiters and releases blocked publishers
+     */
+    void close();
+    bool closed() const { return closed_.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Pollable wakeup fd (call drain() when readable; it resets the fd)
+     */
+    int fd() const { return wakeup_.fd(); }
+
+    const std::string& topic() const { return topic_; }
+    const SubscriptionOptions& options() const { return options_; }
+
+    SubscriberStats stats() const;
+
+private:
+    std::string topic_;
+    SubscriptionOptions options_;
+
+    // Fixed-capacity circular queue (drop-oldest is O(1))
+    std::vector<Event> slots_;
+    size_t head_{0};
+    size_t count_{0};
+    std::vector<Event> scratch_;  // Reused by drain() to move events out of the lock
+    mutable std::mutex mutex_;
+    std::condition_variable space_cv_;
+    Wakeup wakeup_;
+    std::atomic<bool> closed_{false};
+    metrics::LatencyMetric& lag_;  // Shared with the topic's poll/consume lag
+
+    // Stats (guarded by mutex_)
+    uint64_t delivered_{0};
+    uint64_t dropped_{0};
+    uint64_t coalesced_{0};
+    uint64_t blocked_{0};
+    size_t max_queue_depth_{0};
+    double avg_lag_ms_{0.0};
+    double max_lag_ms_{0.0};
+};
+
+} // namespace cognitive_os
+} // namespace melvin
+
+#endif // MELVIN_SUBSCRIPTION_H
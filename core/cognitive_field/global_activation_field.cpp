@@ -3,10 +3,52 @@
 #include <cmath>
 #include <numeric>
 #include <chrono>
+#include <thread>
 
 namespace melvin {
 namespace cognitive_field {
 
+namespace {
+
+// Re-linking one node scans every node; past this share of dirty nodes a
+// full parallel rebuild is cheaper
+constexpr size_t KNN_REBUILD_MIN = 64;
+constexpr size_t KNN_REBUILD_FRACTION = 8;  // dirty > nodes / 8
+
+float dot_product(const float* a, const float* b, size_t n) {
+    float sum = 0.0f;
+    for (size_t i = 0; i < n; ++i) sum += a[i] * b[i];
+    return sum;
+}
+
+bool more_similar(const std::pair<int, float>& a, const std::pair<int, float>& b) {
+    return a.second > b.second;
+}
+
+/**
+ * Insert, move or drop a neighbor in a sorted row capped at KNN_K
+ */
+void offer_neighbor(std::vector<std::pair<int, float>>& row, int node_id, float similarity,
+                    size_t capacity) {
+    auto existing = std::find_if(row.begin(), row.end(),
+                                 [&](const auto& entry) { return entry.first == node_id; });
+    if (existing != row.end()) row.erase(existing);
+    
+    if (similarity <= 0.0f) return;
+    if (row.size() >= capacity && similarity <= row.back().second) return;
+    
+    std::pair<int, float> entry(node_id, similarity);
+    row.insert(std::upper_bound(row.begin(), row.end(), entry, more_similar), entry);
+    if (row.size() > capacity) row.pop_back();
+}
+
+template<typename T>
+size_t column_bytes(const std::vector<T>& column) {
+    return column.capacity() * sizeof(T);
+}
+
+} // namespace
+
 GlobalActivationField::GlobalActivationField(size_t embedding_dim)
     : embedding_dim_(embedding_dim) {
     working_buffer_.reserve(WORKING_BUFFER_SIZE);
@@ -21,43 +63,52 @@ void GlobalActivationField::inject_energy(int node_id, float energy,
                                          int modality) {
     std::lock_guard<std::mutex> lock(nodes_mutex_);
     
-    auto& node = nodes_[node_id];
-    node.energy += energy;
-    node.activation = std::tanh(node.energy / 10.0f);  // Sigmoid-like
-    node.modality = modality;
-    node.last_active = std::chrono::high_resolution_clock::now();
-    
-    // Initialize or update embedding
-    if (node.embedding.empty()) {
-        node.embedding = embedding;
-        node.history_index = 0;
-        for (int i = 0; i < 10; ++i) node.activation_history[i] = 0.0f;
+    uint32_t slot = slot_for(node_id);
+    energy_[slot] += energy;
+    activation_[slot] = std::tanh(energy_[slot] / 10.0f);  // Sigmoid-like
+    modality_[slot] = static_cast<int8_t>(modality);
+    last_active_[slot] = std::chrono::high_resolution_clock::now();
+    
+    // Initialize or update embedding; either way its similarity row is stale
+    if (!embedding.empty()) {
+        knn_dirty_.insert(node_id);
+    }
+    if (embedding_size_[slot] == 0) {
+        set_embedding(slot, embedding.data(), embedding.size());
+        history_index_[slot] = 0;
+        std::fill_n(&history_[slot * HISTORY_LENGTH], HISTORY_LENGTH, 0.0f);
     } else {
         // Blend embeddings (moving average)
-        for (size_t i = 0; i < std::min(embedding.size(), node.embedding.size()); ++i) {
-            node.embedding[i] = node.embedding[i] * 0.9f + embedding[i] * 0.1f;
+        float* row = &embeddings_[slot * embedding_dim_];
+        size_t n = std::min<size_t>(embedding.size(), embedding_size_[slot]);
+        for (size_t i = 0; i < n; ++i) {
+            row[i] = row[i] * 0.9f + embedding[i] * 0.1f;
         }
+        float sq = dot_product(row, row, embedding_size_[slot]);
+        inv_norm_[slot] = sq > 0.0f ? 1.0f / std::sqrt(sq) : 0.0f;
     }
     
-    update_activation_history(node);
+    update_activation_history(slot);
 }
 
 float GlobalActivationField::get_activation(int node_id) const {
     std::lock_guard<std::mutex> lock(nodes_mutex_);
-    auto it = nodes_.find(node_id);
-    return (it != nodes_.end()) ? it->second.activation : 0.0f;
+    int64_t slot = find_slot(node_id);
+    return slot >= 0 ? activation_[slot] : 0.0f;
 }
 
 float GlobalActivationField::get_energy(int node_id) const {
     std::lock_guard<std::mutex> lock(nodes_mutex_);
-    auto it = nodes_.find(node_id);
-    return (it != nodes_.end()) ? it->second.energy : 0.0f;
+    int64_t slot = find_slot(node_id);
+    return slot >= 0 ? energy_[slot] : 0.0f;
 }
 
 std::vector<float> GlobalActivationField::get_embedding(int node_id) const {
     std::lock_guard<std::mutex> lock(nodes_mutex_);
-    auto it = nodes_.find(node_id);
-    return (it != nodes_.end()) ? it->second.embedding : std::vector<float>();
+    int64_t slot = find_slot(node_id);
+    if (slot < 0) return std::vector<float>();
+    const float* row = embedding_row(static_cast<uint32_t>(slot));
+    return std::vector<float>(row, row + embedding_size_[slot]);
 }
 
 // ============================================================================
@@ -67,21 +118,24 @@ std::vector<float> GlobalActivationField::get_embedding(int node_id) const {
 void GlobalActivationField::update(float dt) {
     std::lock_guard<std::mutex> lock(nodes_mutex_);
     
-    // Decay all activations
-    for (auto& pair : nodes_) {
-        auto& node = pair.second;
-        node.energy *= std::pow(decay_rate_, dt * 30.0f);  // Scale by frame rate
-        node.activation = std::tanh(node.energy / 10.0f);
-        
+    // Decay all activations: one pass over two contiguous columns
+    float decay = std::pow(decay_rate_, dt * 30.0f);  // Scale by frame rate
+    float* energy = energy_.data();
+    float* activation = activation_.data();
+    const size_t n = energy_.size();
+    for (size_t i = 0; i < n; ++i) {
+        energy[i] *= decay;
+        activation[i] = std::tanh(energy[i] / 10.0f);
+    
         // Remove dead nodes
-        if (node.activation < min_activation_) {
-            node.energy = 0.0f;
-            node.activation = 0.0f;
+        if (activation[i] < min_activation_) {
+            energy[i] = 0.0f;
+            activation[i] = 0.0f;
         }
     }
     
     // Update working buffer
-    update_working_buffer();
+    update_working_buffer_locked();
 }
 
 void GlobalActivationField::spread_activation(int source_id,
@@ -90,31 +144,31 @@ void GlobalActivationField::spread_activation(int source_id,
                                              float spread_rate) {
     std::lock_guard<std::mutex> lock(nodes_mutex_);
     
-    auto it = nodes_.find(source_id);
-    if (it == nodes_.end() || it->second.activation < min_activation_) {
+    int64_t source = find_slot(source_id);
+    if (source < 0 || activation_[source] < min_activation_) {
         return;
     }
     
-    float source_energy = it->second.energy;
+    float source_energy = energy_[source];
     float energy_to_spread = source_energy * spread_rate;
+    auto now = std::chrono::high_resolution_clock::now();
     
     for (size_t i = 0; i < neighbor_ids.size(); ++i) {
-        int neighbor_id = neighbor_ids[i];
+        uint32_t neighbor = slot_for(neighbor_ids[i]);
         float weight = edge_weights[i];
-        
+    
         // Energy flows proportional to edge weight
         float transferred_energy = energy_to_spread * weight;
-        
-        auto& neighbor = nodes_[neighbor_id];
-        neighbor.energy += transferred_energy;
-        neighbor.activation = std::tanh(neighbor.energy / 10.0f);
-        neighbor.last_active = std::chrono::high_resolution_clock::now();
-        
+    
+        energy_[neighbor] += transferred_energy;
+        activation_[neighbor] = std::tanh(energy_[neighbor] / 10.0f);
+        last_active_[neighbor] = now;
+    
         update_activation_history(neighbor);
     }
     
     // Source loses energy
-    it->second.energy -= energy_to_spread;
+    energy_[source] -= energy_to_spread;
 }
 
 // ============================================================================
@@ -124,34 +178,33 @@ void GlobalActivationField::spread_activation(int source_id,
 float GlobalActivationField::compute_binding_strength(int node_a, int node_b) const {
     std::lock_guard<std::mutex> lock(nodes_mutex_);
     
-    auto it_a = nodes_.find(node_a);
-    auto it_b = nodes_.find(node_b);
+    int64_t a = find_slot(node_a);
+    int64_t b = find_slot(node_b);
     
-    if (it_a == nodes_.end() || it_b == nodes_.end()) {
+    if (a < 0 || b < 0) {
         return 0.0f;
     }
     
-    const auto& a = it_a->second;
-    const auto& b = it_b->second;
+    // 3. Embedding similarity
+    float embedding_sim = slot_cosine(static_cast<uint32_t>(a), static_cast<uint32_t>(b));
     
+    // Combined binding strength
+    return activity_binding(static_cast<uint32_t>(a), static_cast<uint32_t>(b)) + embedding_sim * 0.3f;
+}
+
+float GlobalActivationField::activity_binding(uint32_t a, uint32_t b) const {
     // 1. Co-activation strength (from history)
-    float co_activation = 0.0f;
-    for (int i = 0; i < 10; ++i) {
-        co_activation += a.activation_history[i] * b.activation_history[i];
-    }
+    float co_activation = dot_product(&history_[a * HISTORY_LENGTH],
+                                      &history_[b * HISTORY_LENGTH], HISTORY_LENGTH);
     co_activation /= 10.0f;
     
     // 2. Temporal overlap
     auto time_diff = std::chrono::duration_cast<std::chrono::milliseconds>(
-        a.last_active - b.last_active
+        last_active_[a] - last_active_[b]
     ).count();
     float temporal_overlap = std::exp(-std::abs(time_diff) / 200.0f);  // 200ms window
     
-    // 3. Embedding similarity
-    float embedding_sim = compute_cosine_similarity(a.embedding, b.embedding);
-    
-    // Combined binding strength
-    return co_activation * 0.4f + temporal_overlap * 0.3f + embedding_sim * 0.3f;
+    return co_activation * 0.4f + temporal_overlap * 0.3f;
 }
 
 std::vector<std::pair<int, float>> GlobalActivationField::find_resonant_nodes(
@@ -160,15 +213,44 @@ std::vector<std::pair<int, float>> GlobalActivationField::find_resonant_nodes(
     std::lock_guard<std::mutex> lock(nodes_mutex_);
     
     std::vector<std::pair<int, float>> resonant;
+    int64_t found = find_slot(query_node);
+    if (found < 0) {
+        return resonant;
+    }
+    uint32_t query = static_cast<uint32_t>(found);
+    
+    // Embedding similarity comes from the query's neighbor row. Any node
+    // outside a full row is at most as similar as its last entry, which
+    // bounds the binding before any cosine is computed. A partial row is
+    // complete (nothing outside it is similar at all) once refreshed; a
+    // node without a row gets no bound and exact cosines.
+    refresh_similarity_graph_locked();
+    static const NeighborRow no_neighbors;
+    auto it_row = knn_graph_.find(query_node);
+    const NeighborRow& row = it_row != knn_graph_.end() ? it_row->second : no_neighbors;
+    float similarity_bound = 1.0f;
+    if (it_row != knn_graph_.end()) {
+        similarity_bound = row.size() >= KNN_K ? row.back().second : 0.0f;
+    }
     
-    for (const auto& pair : nodes_) {
-        int node_id = pair.first;
-        if (node_id == query_node) continue;
-        
-        const auto& node = pair.second;
-        if (node.activation < threshold) continue;
-        
-        float binding = compute_binding_strength(query_node, node_id);
+    const uint32_t n = static_cast<uint32_t>(node_ids_.size());
+    for (uint32_t slot = 0; slot < n; ++slot) {
+        if (slot == query || activation_[slot] < threshold) continue;
+        int node_id = node_ids_[slot];
+    
+        float partial = activity_binding(query, slot);
+    
+        float embedding_sim;
+        auto cached = std::find_if(row.begin(), row.end(),
+                                   [&](const auto& entry) { return entry.first == node_id; });
+        if (cached != row.end()) {
+            embedding_sim = cached->second;
+        } else {
+            if (partial + similarity_bound * 0.3f <= resonance_threshold_) continue;
+            embedding_sim = slot_cosine(query, slot);
+        }
+    
+        float binding = partial + embedding_sim * 0.3f;
         if (binding > resonance_threshold_) {
             resonant.emplace_back(node_id, binding);
         }
@@ -188,17 +270,22 @@ std::vector<std::pair<int, float>> GlobalActivationField::find_resonant_nodes(
 std::vector<float> GlobalActivationField::compute_context_vector() const {
     std::lock_guard<std::mutex> lock(nodes_mutex_);
     
+    // Activation-weighted sum of embedding rows (matrix-vector product
+    // restricted to active slots)
     std::vector<float> context(embedding_dim_, 0.0f);
+    float* out = context.data();
     float total_activation = 0.0f;
     
-    for (const auto& pair : nodes_) {
-        const auto& node = pair.second;
-        if (node.activation < min_activation_) continue;
-        
+    const size_t n = activation_.size();
+    for (size_t slot = 0; slot < n; ++slot) {
+        float weight = activation_[slot];
+        if (weight < min_activation_) continue;
+    
+        const float* row = &embeddings_[slot * embedding_dim_];
         for (size_t i = 0; i < embedding_dim_; ++i) {
-            context[i] += node.embedding[i] * node.activation;
+            out[i] += row[i] * weight;
         }
-        total_activation += node.activation;
+        total_activation += weight;
     }
     
     // Normalize
@@ -213,19 +300,26 @@ std::vector<float> GlobalActivationField::compute_context_vector() const {
 
 std::vector<int> GlobalActivationField::get_top_active_nodes(size_t k) const {
     std::lock_guard<std::mutex> lock(nodes_mutex_);
-    
+    return get_top_active_nodes_locked(k);
+}
+
+std::vector<int> GlobalActivationField::get_top_active_nodes_locked(size_t k) const {
     std::vector<std::pair<int, float>> node_activations;
-    for (const auto& pair : nodes_) {
-        if (pair.second.activation > min_activation_) {
-            node_activations.emplace_back(pair.first, pair.second.activation);
+    const size_t n = activation_.size();
+    for (size_t slot = 0; slot < n; ++slot) {
+        if (activation_[slot] > min_activation_) {
+            node_activations.emplace_back(node_ids_[slot], activation_[slot]);
         }
     }
     
-    std::sort(node_activations.begin(), node_activations.end(),
-             [](const auto& a, const auto& b) { return a.second > b.second; });
+    // Only the first k need ordering
+    size_t count = std::min(k, node_activations.size());
+    std::partial_sort(node_activations.begin(), node_activations.begin() + count,
+                      node_activations.end(), more_similar);
     
     std::vector<int> top_nodes;
-    for (size_t i = 0; i < std::min(k, node_activations.size()); ++i) {
+    top_nodes.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
         top_nodes.push_back(node_activations[i].first);
     }
     
@@ -235,6 +329,9 @@ std::vector<int> GlobalActivationField::get_top_active_nodes(size_t k) const {
 std::unordered_map<int, float> GlobalActivationField::propagate_context(
     int seed_node, int hops) const {
     
+    std::lock_guard<std::mutex> lock(nodes_mutex_);
+    refresh_similarity_graph_locked();
+    
     // Multi-hop context propagation
     std::unordered_map<int, float> context_activations;
     context_activations[seed_node] = 1.0f;
@@ -247,16 +344,19 @@ std::unordered_map<int, float> GlobalActivationField::propagate_context(
     
     for (int hop = 0; hop < hops; ++hop) {
         std::vector<int> next_frontier;
-        
+    
         for (int node_id : current_frontier) {
             float current_activation = context_activations[node_id];
             float decayed_activation = current_activation * 0.7f;  // Decay per hop
-            
-            // Find neighbors (would need edge data structure here)
-            // For now, use similarity-based neighbors
-            auto similar = find_similar_nodes(node_id, 10, 0.3f);
-            
-            for (const auto& [neighbor_id, similarity] : similar) {
+    
+            // Similarity-graph neighbors: the 10 most similar at >= 0.3
+            auto it_row = knn_graph_.find(node_id);
+            if (it_row == knn_graph_.end()) continue;
+            const auto& row = it_row->second;
+            size_t limit = std::min<size_t>(10, row.size());
+    
+            for (size_t i = 0; i < limit && row[i].second >= 0.3f; ++i) {
+                auto [neighbor_id, similarity] = row[i];
                 if (visited.find(neighbor_id) == visited.end()) {
                     visited[neighbor_id] = hop + 1;
                     context_activations[neighbor_id] = decayed_activation * similarity;
@@ -264,7 +364,7 @@ std::unordered_map<int, float> GlobalActivationField::propagate_context(
                 }
             }
         }
-        
+    
         current_frontier = std::move(next_frontier);
     }
     
@@ -275,30 +375,35 @@ std::unordered_map<int, float> GlobalActivationField::propagate_context(
 // Working Context Buffer
 // ============================================================================
 
-std::vector<GlobalActivationField::WorkingConcept> 
+std::vector<GlobalActivationField::WorkingConcept>
 GlobalActivationField::get_working_buffer() const {
     return working_buffer_;
 }
 
 void GlobalActivationField::update_working_buffer() {
+    std::lock_guard<std::mutex> lock(nodes_mutex_);
+    update_working_buffer_locked();
+}
+
+void GlobalActivationField::update_working_buffer_locked() {
     // Get top active nodes
-    auto top_nodes = get_top_active_nodes(WORKING_BUFFER_SIZE * 2);
+    auto top_nodes = get_top_active_nodes_locked(WORKING_BUFFER_SIZE * 2);
     
     working_buffer_.clear();
     auto now = std::chrono::high_resolution_clock::now();
     
     for (int node_id : top_nodes) {
         if (working_buffer_.size() >= WORKING_BUFFER_SIZE) break;
-        
-        auto it = nodes_.find(node_id);
-        if (it == nodes_.end()) continue;
-        
+    
+        int64_t slot = find_slot(node_id);
+        if (slot < 0) continue;
+    
         WorkingConcept concept;
         concept.node_id = node_id;
-        concept.activation = it->second.activation;
+        concept.activation = activation_[slot];
         concept.decay_rate = 0.9f;
         concept.last_update = now;
-        
+    
         working_buffer_.push_back(concept);
     }
 }
@@ -310,14 +415,14 @@ void GlobalActivationField::update_working_buffer() {
 float GlobalActivationField::cosine_similarity(int node_a, int node_b) const {
     std::lock_guard<std::mutex> lock(nodes_mutex_);
     
-    auto it_a = nodes_.find(node_a);
-    auto it_b = nodes_.find(node_b);
+    int64_t a = find_slot(node_a);
+    int64_t b = find_slot(node_b);
     
-    if (it_a == nodes_.end() || it_b == nodes_.end()) {
+    if (a < 0 || b < 0) {
         return 0.0f;
     }
     
-    return compute_cosine_similarity(it_a->second.embedding, it_b->second.embedding);
+    return slot_cosine(static_cast<uint32_t>(a), static_cast<uint32_t>(b));
 }
 
 std::vector<std::pair<int, float>> GlobalActivationField::find_similar_nodes(
@@ -325,20 +430,34 @@ std::vector<std::pair<int, float>> GlobalActivationField::find_similar_nodes(
     
     std::lock_guard<std::mutex> lock(nodes_mutex_);
     
-    auto it_query = nodes_.find(query_node);
-    if (it_query == nodes_.end()) {
+    int64_t found = find_slot(query_node);
+    if (found < 0) {
         return {};
     }
+    uint32_t query = static_cast<uint32_t>(found);
+    
+    // Rows hold every neighbor with similarity > 0 up to KNN_K
+    if (k <= KNN_K && min_similarity > 0.0f) {
+        refresh_similarity_graph_locked();
+        std::vector<std::pair<int, float>> similarities;
+        auto it_row = knn_graph_.find(query_node);
+        if (it_row != knn_graph_.end()) {
+            for (const auto& entry : it_row->second) {
+                if (similarities.size() >= k || entry.second < min_similarity) break;
+                similarities.push_back(entry);
+            }
+        }
+        return similarities;
+    }
     
-    const auto& query_emb = it_query->second.embedding;
     std::vector<std::pair<int, float>> similarities;
+    const uint32_t n = static_cast<uint32_t>(node_ids_.size());
+    for (uint32_t slot = 0; slot < n; ++slot) {
+        if (slot == query) continue;
     
-    for (const auto& pair : nodes_) {
-        if (pair.first == query_node) continue;
-        
-        float sim = compute_cosine_similarity(query_emb, pair.second.embedding);
+        float sim = slot_cosine(query, slot);
         if (sim >= min_similarity) {
-            similarities.emplace_back(pair.first, sim);
+            similarities.emplace_back(node_ids_[slot], sim);
         }
     }
     
@@ -352,6 +471,132 @@ std::vector<std::pair<int, float>> GlobalActivationField::find_similar_nodes(
     return similarities;
 }
 
+// ============================================================================
+// Similarity Graph
+// ============================================================================
+
+void GlobalActivationField::build_similarity_graph(size_t threads) {
+    std::lock_guard<std::mutex> lock(nodes_mutex_);
+    build_similarity_graph_locked(threads);
+}
+
+std::vector<std::pair<int, float>> GlobalActivationField::get_similarity_neighbors(int node_id) const {
+    std::lock_guard<std::mutex> lock(nodes_mutex_);
+    refresh_similarity_graph_locked();
+    auto it = knn_graph_.find(node_id);
+    return it != knn_graph_.end() ? it->second : NeighborRow();
+}
+
+void GlobalActivationField::refresh_similarity_graph_locked() const {
+    if (knn_dirty_.empty()) return;
+    
+    if (knn_dirty_.size() >= KNN_REBUILD_MIN &&
+        knn_dirty_.size() * KNN_REBUILD_FRACTION > node_ids_.size()) {
+        build_similarity_graph_locked(0);
+        return;
+    }
+    
+    while (!knn_dirty_.empty()) {
+        int node_id = *knn_dirty_.begin();
+        knn_dirty_.erase(knn_dirty_.begin());
+        relink_node_locked(node_id);
+    }
+}
+
+void GlobalActivationField::relink_node_locked(int node_id) const {
+    int64_t found = find_slot(node_id);
+    if (found < 0) return;
+    uint32_t query = static_cast<uint32_t>(found);
+    
+    // One scan recomputes this node's row and re-offers it to every other
+    // row, so neighbors that now rank it higher (or lower) pick that up.
+    // A full row whose entry for it fell below the row's old last entry
+    // may now miss a closer node, so it is refilled from scratch.
+    fill_row_locked(query, knn_graph_[node_id]);
+    std::vector<uint32_t> refill;
+    const uint32_t n = static_cast<uint32_t>(node_ids_.size());
+    for (uint32_t slot = 0; slot < n; ++slot) {
+        if (slot == query) continue;
+        int other_id = node_ids_[slot];
+    
+        auto it_other = knn_graph_.find(other_id);
+        if (it_other == knn_graph_.end() || knn_dirty_.count(other_id)) continue;
+        NeighborRow& other = it_other->second;
+    
+        bool full = other.size() >= KNN_K;
+        float bound = full ? other.back().second : 0.0f;
+        bool member = std::any_of(other.begin(), other.end(),
+                                  [&](const auto& entry) { return entry.first == node_id; });
+        float similarity = slot_cosine(query, slot);
+        offer_neighbor(other, node_id, similarity, KNN_K);
+        if (full && member && similarity < bound) refill.push_back(slot);
+    }
+    
+    for (uint32_t slot : refill) {
+        fill_row_locked(slot, knn_graph_[node_ids_[slot]]);
+    }
+}
+
+void GlobalActivationField::fill_row_locked(uint32_t query, NeighborRow& row) const {
+    row.clear();
+    const uint32_t n = static_cast<uint32_t>(node_ids_.size());
+    for (uint32_t slot = 0; slot < n; ++slot) {
+        if (slot == query) continue;
+        offer_neighbor(row, node_ids_[slot], slot_cosine(query, slot), KNN_K);
+    }
+}
+
+void GlobalActivationField::build_similarity_graph_locked(size_t threads) const {
+    size_t n = node_ids_.size();
+    if (threads == 0) {
+        unsigned hw = std::thread::hardware_concurrency();
+        threads = hw ? hw : 4;
+    }
+    threads = std::max<size_t>(1, std::min(threads, n));
+    
+    // Each worker owns a contiguous range of rows; the embedding matrix and
+    // norms are shared read-only
+    std::vector<NeighborRow> rows(n);
+    auto build_rows = [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            if (inv_norm_[i] == 0.0f) continue;
+            const float* query = embedding_row(static_cast<uint32_t>(i));
+            size_t size = embedding_size_[i];
+            NeighborRow& row = rows[i];
+            row.reserve(KNN_K + 1);
+            for (size_t j = 0; j < n; ++j) {
+                if (j == i || inv_norm_[j] == 0.0f || embedding_size_[j] != size) continue;
+                float similarity = dot_product(query, embedding_row(static_cast<uint32_t>(j)), size) *
+                                   inv_norm_[i] * inv_norm_[j];
+                if (similarity <= 0.0f) continue;
+                if (row.size() >= KNN_K && similarity <= row.back().second) continue;
+                std::pair<int, float> entry(node_ids_[j], similarity);
+                row.insert(std::upper_bound(row.begin(), row.end(), entry, more_similar), entry);
+                if (row.size() > KNN_K) row.pop_back();
+            }
+        }
+    };
+    
+    std::vector<std::thread> workers;
+    size_t chunk = n > 0 ? (n + threads - 1) / threads : 0;
+    for (size_t t = 1; t < threads; ++t) {
+        size_t begin = t * chunk;
+        size_t end = std::min(n, begin + chunk);
+        if (begin >= end) break;
+        workers.emplace_back(build_rows, begin, end);
+    }
+    build_rows(0, std::min(n, chunk));
+    for (auto& worker : workers) worker.join();
+    
+    knn_graph_.clear();
+    knn_graph_.reserve(n);
+    for (size_t i = 0; i < n; ++i) {
+        // Empty rows are kept: later relinks offer changed nodes to every row
+        knn_graph_.emplace(node_ids_[i], std::move(rows[i]));
+    }
+    knn_dirty_.clear();
+}
+
 // ============================================================================
 // Statistics
 // ============================================================================
@@ -360,16 +605,18 @@ GlobalActivationField::Stats GlobalActivationField::get_stats() const {
     std::lock_guard<std::mutex> lock(nodes_mutex_);
     
     Stats stats = {0, 0, 0.0f, 0.0f, 0.0f, 0.0f};
-    stats.total_nodes = nodes_.size();
+    stats.total_nodes = node_ids_.size();
     
-    for (const auto& pair : nodes_) {
-        const auto& node = pair.second;
-        stats.total_energy += node.energy;
-        
-        if (node.activation > min_activation_) {
+    const size_t n = activation_.size();
+    for (size_t slot = 0; slot < n; ++slot) {
+        stats.total_energy += energy_[slot];
+    }
+    for (size_t slot = 0; slot < n; ++slot) {
+        float activation = activation_[slot];
+        if (activation > min_activation_) {
             stats.active_nodes++;
-            stats.avg_activation += node.activation;
-            stats.max_activation = std::max(stats.max_activation, node.activation);
+            stats.avg_activation += activation;
+            stats.max_activation = std::max(stats.max_activation, activation);
         }
     }
     
@@ -380,9 +627,33 @@ GlobalActivationField::Stats GlobalActivationField::get_stats() const {
     return stats;
 }
 
+size_t GlobalActivationField::memory_bytes() const {
+    std::lock_guard<std::mutex> lock(nodes_mutex_);
+    
+    // Hash index: one heap node (next pointer + hash + pair) per entry plus buckets
+    size_t index_bytes = slot_of_.size() * (sizeof(std::pair<const int, uint32_t>) + 2 * sizeof(void*)) +
+                         slot_of_.bucket_count() * sizeof(void*);
+    return index_bytes + column_bytes(node_ids_) + column_bytes(activation_) +
+           column_bytes(energy_) + column_bytes(embeddings_) + column_bytes(embedding_size_) +
+           column_bytes(inv_norm_) + column_bytes(modality_) + column_bytes(last_active_) +
+           column_bytes(history_) + column_bytes(history_index_);
+}
+
 void GlobalActivationField::reset() {
     std::lock_guard<std::mutex> lock(nodes_mutex_);
-    nodes_.clear();
+    slot_of_.clear();
+    node_ids_.clear();
+    activation_.clear();
+    energy_.clear();
+    embeddings_.clear();
+    embedding_size_.clear();
+    inv_norm_.clear();
+    modality_.clear();
+    last_active_.clear();
+    history_.clear();
+    history_index_.clear();
+    knn_graph_.clear();
+    knn_dirty_.clear();
     working_buffer_.clear();
 }
 
@@ -390,33 +661,53 @@ void GlobalActivationField::reset() {
 // Helper Functions
 // ============================================================================
 
-float GlobalActivationField::compute_cosine_similarity(
-    const std::vector<float>& a, const std::vector<float>& b) const {
-    
-    if (a.size() != b.size() || a.empty()) {
-        return 0.0f;
-    }
-    
-    float dot = 0.0f, norm_a = 0.0f, norm_b = 0.0f;
-    
-    for (size_t i = 0; i < a.size(); ++i) {
-        dot += a[i] * b[i];
-        norm_a += a[i] * a[i];
-        norm_b += b[i] * b[i];
+uint32_t GlobalActivationField::slot_for(int node_id) {
+    auto [it, inserted] = slot_of_.try_emplace(node_id, static_cast<uint32_t>(node_ids_.size()));
+    if (inserted) {
+        node_ids_.push_back(node_id);
+        activation_.push_back(0.0f);
+        energy_.push_back(0.0f);
+        embeddings_.resize(embeddings_.size() + embedding_dim_, 0.0f);
+        embedding_size_.push_back(0);
+        inv_norm_.push_back(0.0f);
+        modality_.push_back(0);
+        last_active_.emplace_back();
+        history_.resize(history_.size() + HISTORY_LENGTH, 0.0f);
+        history_index_.push_back(0);
     }
-    
-    if (norm_a == 0.0f || norm_b == 0.0f) {
+    return it->second;
+}
+
+int64_t GlobalActivationField::find_slot(int node_id) const {
+    auto it = slot_of_.find(node_id);
+    return it != slot_of_.end() ? static_cast<int64_t>(it->second) : -1;
+}
+
+void GlobalActivationField::set_embedding(uint32_t slot, const float* data, size_t size) {
+    size_t n = std::min(size, embedding_dim_);
+    float* row = &embeddings_[slot * embedding_dim_];
+    std::copy(data, data + n, row);
+    std::fill(row + n, row + embedding_dim_, 0.0f);
+    embedding_size_[slot] = static_cast<uint32_t>(n);
+    float sq = dot_product(row, row, n);
+    inv_norm_[slot] = sq > 0.0f ? 1.0f / std::sqrt(sq) : 0.0f;
+}
+
+float GlobalActivationField::slot_cosine(uint32_t a, uint32_t b) const {
+    size_t size = embedding_size_[a];
+    if (size != embedding_size_[b] || size == 0) {
         return 0.0f;
     }
     
-    return dot / (std::sqrt(norm_a) * std::sqrt(norm_b));
+    // Zero norms give 0 through the cached inverse
+    return dot_product(embedding_row(a), embedding_row(b), size) * inv_norm_[a] * inv_norm_[b];
 }
 
-void GlobalActivationField::update_activation_history(NodeState& node) {
-    node.activation_history[node.history_index] = node.activation;
-    node.history_index = (node.history_index + 1) % 10;
+void GlobalActivationField::update_activation_history(uint32_t slot) {
+    uint8_t& index = history_index_[slot];
+    history_[slot * HISTORY_LENGTH + index] = activation_[slot];
+    index = static_cast<uint8_t>((index + 1) % HISTORY_LENGTH);
 }
 
 } // namespace cognitive_field
 } // namespace melvin
-
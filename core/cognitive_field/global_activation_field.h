@@ -3,8 +3,11 @@
 
 #include <vector>
 #include <unordered_map>
+#include <unordered_set>
 #include <mutex>
 #include <cmath>
+#include <chrono>
+#include <cstdint>
 
 namespace melvin {
 namespace cognitive_field {
@@ -147,10 +150,31 @@ public:
     
     /**
      * Find nearest neighbors by embedding similarity
+     * Served from the similarity graph when k <= KNN_K and min_similarity > 0
      */
     std::vector<std::pair<int, float>> find_similar_nodes(
         int query_node, size_t k, float min_similarity = 0.5f) const;
     
+    // ========================================================================
+    // Similarity Graph (k nearest neighbors by embedding)
+    // ========================================================================
+    
+    static constexpr size_t KNN_K = 16;
+    
+    /**
+     * Rebuild the similarity graph from scratch, rows computed in parallel
+     * Nodes whose embedding changes afterwards are re-linked incrementally
+     * on the next similarity query.
+     * @param threads - Worker threads (0 = hardware concurrency)
+     */
+    void build_similarity_graph(size_t threads = 0);
+    
+    /**
+     * Cached neighbors of a node: up to KNN_K (node_id, similarity > 0),
+     * most similar first
+     */
+    std::vector<std::pair<int, float>> get_similarity_neighbors(int node_id) const;
+    
     // ========================================================================
     // Statistics
     // ========================================================================
@@ -165,27 +189,44 @@ public:
     };
     Stats get_stats() const;
     
+    /**
+     * Bytes held by node state (columns, embedding matrix, history, index)
+     */
+    size_t memory_bytes() const;
+    
     void reset();
     
 private:
     size_t embedding_dim_;
     
-    // Node state
-    struct NodeState {
-        float activation;
-        float energy;
-        std::vector<float> embedding;
-        int modality;  // Source modality
-        std::chrono::high_resolution_clock::time_point last_active;
-        
-        // For resonance detection
-        float activation_history[10];  // Ring buffer
-        int history_index;
-    };
+    // Node state, structure-of-arrays: one slot per node (kept until
+    // reset). Per-tick columns are contiguous; embeddings form a row-major
+    // slot x embedding_dim_ matrix (zero padded, longer inputs truncated)
+    // and the resonance history ring buffers a separate block.
+    static constexpr size_t HISTORY_LENGTH = 10;
     
-    std::unordered_map<int, NodeState> nodes_;
+    std::unordered_map<int, uint32_t> slot_of_;
+    std::vector<int> node_ids_;
+    std::vector<float> activation_;
+    std::vector<float> energy_;
+    std::vector<float> embeddings_;          // slot * embedding_dim_
+    std::vector<uint32_t> embedding_size_;  // 0 = no embedding yet
+    std::vector<float> inv_norm_;           // 1 / |embedding|, 0 when none
+    std::vector<int8_t> modality_;          // Source modality
+    std::vector<std::chrono::high_resolution_clock::time_point> last_active_;
+    std::vector<float> history_;            // slot * HISTORY_LENGTH
+    std::vector<uint8_t> history_index_;
     mutable std::mutex nodes_mutex_;
     
+    // Similarity graph rows (sorted, similarity > 0) and nodes whose
+    // embedding changed since their row was computed. Maintained lazily
+    // from const queries, always under nodes_mutex_. Once refreshed, every
+    // node with an embedding has a row holding exactly its KNN_K most
+    // similar nodes (all of them when fewer are similar at all).
+    using NeighborRow = std::vector<std::pair<int, float>>;
+    mutable std::unordered_map<int, NeighborRow> knn_graph_;
+    mutable std::unordered_set<int> knn_dirty_;
+    
     // Working buffer
     static constexpr size_t WORKING_BUFFER_SIZE = 7;
     std::vector<WorkingConcept> working_buffer_;
@@ -196,10 +237,26 @@ private:
     float min_activation_ = 0.01f;
     float resonance_threshold_ = 0.5f;
     
-    // Helper functions
-    float compute_cosine_similarity(const std::vector<float>& a, 
-                                   const std::vector<float>& b) const;
-    void update_activation_history(NodeState& node);
+    // Slot helpers; caller holds nodes_mutex_
+    uint32_t slot_for(int node_id);           // Created on first use
+    int64_t find_slot(int node_id) const;     // -1 when unknown
+    const float* embedding_row(uint32_t slot) const { return &embeddings_[slot * embedding_dim_]; }
+    void set_embedding(uint32_t slot, const float* data, size_t size);
+    float slot_cosine(uint32_t a, uint32_t b) const;
+    void update_activation_history(uint32_t slot);
+    
+    // Co-activation + temporal overlap terms of compute_binding_strength
+    float activity_binding(uint32_t a, uint32_t b) const;
+    
+    // Bodies of the public queries; caller holds nodes_mutex_
+    std::vector<int> get_top_active_nodes_locked(size_t k) const;
+    void update_working_buffer_locked();
+    
+    // Similarity graph maintenance; caller holds nodes_mutex_
+    void refresh_similarity_graph_locked() const;
+    void relink_node_locked(int node_id) const;
+    void fill_row_locked(uint32_t query, NeighborRow& row) const;
+    void build_similarity_graph_locked(size_t threads) const;
 };
 
 } // namespace cognitive_field
@@ -1,6 +1,11 @@
 #include "activation_field_unified.h"
+#include "core/metrics/latency_histogram.h"
+#include "core/metrics/trace.h"
 #include <algorithm>
 #include <cmath>
+#include <cstring>
+#include <functional>
+#include <new>
 #include <numeric>
 #include <set>
 
@@ -113,15 +118,16 @@ std::vector<float> WorkingContext::get_context_vector() {
 // ContextHorizon Implementation
 // ============================================================================
 
-std::vector<ContextHorizon::HopNode> ContextHorizon::propagate(
-    int origin_node,
-    const std::unordered_map<int, std::vector<std::pair<int, float>>>& graph,
-    int max_hops,
-    float threshold) {
+namespace {
+
+// Best-first k-hop walk shared by both adjacency shapes; for_each_neighbor
+// calls visit(neighbor_id, edge_weight) for every out-edge of a node
+template<typename ForEachNeighbor>
+std::vector<ContextHorizon::HopNode> propagate_hops(
+    int origin_node, int max_hops, float threshold, ForEachNeighbor&& for_each_neighbor) {
     
-    std::vector<HopNode> result;
+    std::vector<ContextHorizon::HopNode> result;
     std::unordered_map<int, float> best_activation;
-    std::unordered_map<int, int> best_distance;
     
     // BFS with priority queue
     struct QueueItem {
@@ -138,7 +144,6 @@ std::vector<ContextHorizon::HopNode> ContextHorizon::propagate(
     std::priority_queue<QueueItem> queue;
     queue.push({origin_node, 1.0f, 0, 1.0f});
     best_activation[origin_node] = 1.0f;
-    best_distance[origin_node] = 0;
     
     while (!queue.empty()) {
         auto current = queue.top();
@@ -148,8 +153,8 @@ std::vector<ContextHorizon::HopNode> ContextHorizon::propagate(
         if (current.activation < threshold) continue;
         
         // Skip if we found a better path already
-        if (best_activation.count(current.node_id) && 
-            best_activation[current.node_id] > current.activation) {
+        auto best = best_activation.find(current.node_id);
+        if (best != best_activation.end() && best->second > current.activation) {
             continue;
         }
         
@@ -158,30 +163,56 @@ std::vector<ContextHorizon::HopNode> ContextHorizon::propagate(
                          current.distance, current.path_strength});
         
         // Propagate to neighbors
-        auto it = graph.find(current.node_id);
-        if (it != graph.end()) {
-            for (const auto& [neighbor_id, edge_weight] : it->second) {
-                float new_activation = current.activation * edge_weight * 0.8f;  // Decay
-                float new_path_strength = current.path_strength * edge_weight;
-                
-                if (new_activation >= threshold) {
-                    if (!best_activation.count(neighbor_id) || 
-                        best_activation[neighbor_id] < new_activation) {
-                        
-                        best_activation[neighbor_id] = new_activation;
-                        best_distance[neighbor_id] = current.distance + 1;
-                        
-                        queue.push({neighbor_id, new_activation, 
-                                   current.distance + 1, new_path_strength});
-                    }
-                }
+        for_each_neighbor(current.node_id, [&](int neighbor_id, float edge_weight) {
+            float new_activation = current.activation * edge_weight * 0.8f;  // Decay
+            if (new_activation < threshold) return;
+            
+            auto [it, inserted] = best_activation.try_emplace(neighbor_id, new_activation);
+            if (!inserted) {
+                if (it->second >= new_activation) return;
+                it->second = new_activation;
             }
-        }
+            queue.push({neighbor_id, new_activation, 
+                       current.distance + 1, current.path_strength * edge_weight});
+        });
     }
     
     return result;
 }
 
+} // namespace
+
+std::vector<ContextHorizon::HopNode> ContextHorizon::propagate(
+    int origin_node,
+    const std::unordered_map<int, std::vector<std::pair<int, float>>>& graph,
+    int max_hops,
+    float threshold) {
+    
+    return propagate_hops(origin_node, max_hops, threshold, [&](int node_id, auto&& visit) {
+        auto it = graph.find(node_id);
+        if (it == graph.end()) return;
+        for (const auto& [neighbor_id, edge_weight] : it->second) {
+            visit(neighbor_id, edge_weight);
+        }
+    });
+}
+
+std::vector<ContextHorizon::HopNode> ContextHorizon::propagate(
+    int origin_node,
+    const HybridEdgeTable& edges,
+    int max_hops,
+    float threshold,
+    float symbolic_bias) {
+    
+    return propagate_hops(origin_node, max_hops, threshold, [&](int node_id, auto&& visit) {
+        int64_t u = edges.find(node_id);
+        if (u < 0 || edges.dirty) return;
+        for (uint32_t e = edges.out_offsets[u]; e < edges.out_offsets[u + 1]; ++e) {
+            visit(edges.node_ids[edges.to[e]], edges.weight(e, symbolic_bias));
+        }
+    });
+}
+
 std::vector<float> ContextHorizon::compute_context_vector(
     const std::vector<HopNode>& neighborhood,
     const std::unordered_map<int, std::vector<float>>& embeddings) {
@@ -223,17 +254,172 @@ std::vector<float> ContextHorizon::compute_context_vector(
     return context;
 }
 
+// ============================================================================
+// HybridEdgeTable Implementation
+// ============================================================================
+
+uint32_t HybridEdgeTable::intern(int node_id) {
+    auto [it, inserted] = node_index.try_emplace(node_id, static_cast<uint32_t>(node_ids.size()));
+    if (inserted) {
+        node_ids.push_back(node_id);
+        if (!dirty) {
+            // A new node has no edges yet: extend both indices with an empty range
+            if (out_offsets.empty()) {
+                out_offsets.push_back(0);
+                in_offsets.push_back(0);
+            }
+            out_offsets.push_back(out_offsets.back());
+            in_offsets.push_back(in_offsets.back());
+        }
+    }
+    return it->second;
+}
+
+int64_t HybridEdgeTable::find(int node_id) const {
+    auto it = node_index.find(node_id);
+    return it != node_index.end() ? static_cast<int64_t>(it->second) : -1;
+}
+
+void HybridEdgeTable::add(uint32_t from_index, uint32_t to_index, HybridEdge::Type edge_type,
+                          float symbolic, float similarity) {
+    from.push_back(from_index);
+    to.push_back(to_index);
+    type.push_back(static_cast<uint8_t>(edge_type));
+    symbolic_weight.push_back(symbolic);
+    embedding_similarity.push_back(similarity);
+    dirty = true;
+}
+
+void HybridEdgeTable::reindex() {
+    const size_t n = node_ids.size();
+    const size_t m = from.size();
+    
+    // Counting sort by source (stable, so per-node edge order is kept)
+    out_offsets.assign(n + 1, 0);
+    for (size_t e = 0; e < m; ++e) out_offsets[from[e] + 1]++;
+    for (size_t u = 0; u < n; ++u) out_offsets[u + 1] += out_offsets[u];
+    
+    std::vector<uint32_t> order(m);
+    {
+        std::vector<uint32_t> cursor(out_offsets.begin(), out_offsets.end() - 1);
+        for (size_t e = 0; e < m; ++e) order[cursor[from[e]]++] = static_cast<uint32_t>(e);
+    }
+    auto permute = [&](auto& column) {
+        std::remove_reference_t<decltype(column)> sorted(m);
+        for (size_t i = 0; i < m; ++i) sorted[i] = column[order[i]];
+        column.swap(sorted);
+    };
+    permute(from);
+    permute(to);
+    permute(type);
+    permute(symbolic_weight);
+    permute(embedding_similarity);
+    
+    // In-index: edge ids grouped by target
+    in_offsets.assign(n + 1, 0);
+    for (size_t e = 0; e < m; ++e) in_offsets[to[e] + 1]++;
+    for (size_t v = 0; v < n; ++v) in_offsets[v + 1] += in_offsets[v];
+    in_edges.resize(m);
+    {
+        std::vector<uint32_t> cursor(in_offsets.begin(), in_offsets.end() - 1);
+        for (size_t e = 0; e < m; ++e) in_edges[cursor[to[e]]++] = static_cast<uint32_t>(e);
+    }
+    
+    dirty = false;
+}
+
+size_t HybridEdgeTable::memory_bytes() const {
+    size_t per_edge = sizeof(uint32_t) * 2 + sizeof(uint8_t) + sizeof(float) * 2 + sizeof(uint32_t);
+    return from.size() * per_edge + (out_offsets.size() + in_offsets.size()) * sizeof(uint32_t);
+}
+
 // ============================================================================
 // TemporalHierarchy Implementation
 // ============================================================================
 
+namespace {
+
+int64_t to_ticks(TemporalHierarchy::Clock::time_point t) {
+    return static_cast<int64_t>(t.time_since_epoch().count());
+}
+
+float ticks_to_seconds(int64_t ticks) {
+    using Ticks = TemporalHierarchy::Clock::duration;
+    return std::chrono::duration<float>(Ticks(ticks)).count();
+}
+
+// Running mean and resultant length of the constituent embeddings
+struct SummaryAccumulator {
+    std::vector<float> sum;
+    std::vector<float> unit_sum;
+    size_t count = 0;
+    
+    void add(const std::vector<float>& v) {
+        if (v.empty()) return;
+        if (v.size() > sum.size()) {
+            sum.resize(v.size(), 0.0f);
+            unit_sum.resize(v.size(), 0.0f);
+        }
+        float norm_sq = 0.0f;
+        for (size_t i = 0; i < v.size(); ++i) {
+            sum[i] += v[i];
+            norm_sq += v[i] * v[i];
+        }
+        if (norm_sq > 0.0f) {
+            float inv_norm = 1.0f / std::sqrt(norm_sq);
+            for (size_t i = 0; i < v.size(); ++i) {
+                unit_sum[i] += v[i] * inv_norm;
+            }
+        }
+        ++count;
+    }
+    
+    std::vector<float> mean() const {
+        std::vector<float> result = sum;
+        for (float& x : result) x /= static_cast<float>(count);
+        return result;
+    }
+    
+    // |sum of unit vectors| / n: 1 when all point the same way
+    float coherence() const {
+        if (count == 0) return 1.0f;
+        float norm_sq = 0.0f;
+        for (float x : unit_sum) norm_sq += x * x;
+        return std::min(1.0f, std::sqrt(norm_sq) / static_cast<float>(count));
+    }
+};
+
+} // namespace
+
+std::vector<float> TemporalHierarchy::TemporalNode::summary_embedding() const {
+    std::vector<float> result(summary_q.size());
+    for (size_t i = 0; i < summary_q.size(); ++i) {
+        result[i] = summary_q[i] * summary_scale;
+    }
+    return result;
+}
+
 int TemporalHierarchy::compress_sequence(const std::vector<int>& node_ids, Level from_level) {
+    static const std::unordered_map<int, std::vector<float>> no_embeddings;
+    auto now = Clock::now();
+    return compress_sequence(node_ids, from_level, now, now, no_embeddings);
+}
+
+int TemporalHierarchy::compress_sequence(const std::vector<int>& node_ids, Level from_level,
+                                         Clock::time_point start, Clock::time_point end,
+                                         const std::unordered_map<int, std::vector<float>>& embeddings) {
+    int id = summarize(node_ids, from_level, start, end, embeddings);
+    if (id >= 0 && memory_budget_ > 0 && memory_bytes() > memory_budget_) {
+        compact();
+    }
+    return id;
+}
+
+int TemporalHierarchy::summarize(const std::vector<int>& node_ids, Level from_level,
+                                 Clock::time_point start, Clock::time_point end,
+                                 const std::unordered_map<int, std::vector<float>>& embeddings) {
     if (node_ids.empty()) return -1;
     
-    // Generate new ID for compressed node
-    static int next_temporal_id = 1000000;  // Start from high number
-    int new_id = next_temporal_id++;
-    
     // Determine target level
     Level to_level;
     switch (from_level) {
@@ -247,12 +433,58 @@ int TemporalHierarchy::compress_sequence(const std::vector<int>& node_ids, Level
     TemporalNode tnode;
     tnode.level = to_level;
     tnode.constituent_nodes = node_ids;
-    tnode.start_time = std::chrono::high_resolution_clock::now();
-    tnode.end_time = tnode.start_time;  // Will be updated
-    tnode.coherence = 1.0f;  // TODO: Compute based on constituent similarity
-    tnode.summary_embedding = std::vector<float>(128, 0.0f);  // TODO: Compute
+    tnode.start_time = start;
+    tnode.end_time = std::max(start, end);
+    
+    SummaryAccumulator acc;
+    std::vector<TemporalNode*> children;
+    if (from_level == Level::FRAMES) {
+        for (int node_id : node_ids) {
+            auto it = embeddings.find(node_id);
+            if (it != embeddings.end()) acc.add(it->second);
+        }
+    } else {
+        // Constituents are temporal nodes: merge their spans and summaries
+        for (int node_id : node_ids) {
+            auto it = temporal_nodes.find(node_id);
+            if (it == temporal_nodes.end() || it->second.level != from_level) continue;
+            TemporalNode& child = it->second;
+            if (children.empty()) {
+                tnode.start_time = child.start_time;
+                tnode.end_time = child.end_time;
+            } else {
+                tnode.start_time = std::min(tnode.start_time, child.start_time);
+                tnode.end_time = std::max(tnode.end_time, child.end_time);
+            }
+            acc.add(child.summary_embedding());
+            children.push_back(&child);
+        }
+    }
+    tnode.coherence = acc.coherence();
+    
+    // Symmetric int8 quantization, one scale per vector
+    if (acc.count > 0) {
+        std::vector<float> summary = acc.mean();
+        float max_abs = 0.0f;
+        for (float x : summary) max_abs = std::max(max_abs, std::abs(x));
+        tnode.summary_scale = max_abs > 0.0f ? max_abs / 127.0f : 0.0f;
+        tnode.summary_q.resize(summary.size(), 0);
+        if (max_abs > 0.0f) {
+            for (size_t i = 0; i < summary.size(); ++i) {
+                tnode.summary_q[i] = static_cast<int8_t>(std::lround(summary[i] / tnode.summary_scale));
+            }
+        }
+    }
+    
+    int new_id = next_id_++;
+    for (TemporalNode* child : children) {
+        child->parent = new_id;
+    }
     
-    temporal_nodes[new_id] = tnode;
+    node_bytes_ += node_bytes(tnode);
+    index_[static_cast<size_t>(to_level)].insert(new_id, to_ticks(tnode.start_time),
+                                                 to_ticks(tnode.end_time));
+    temporal_nodes.emplace(new_id, std::move(tnode));
     return new_id;
 }
 
@@ -261,31 +493,264 @@ std::vector<int> TemporalHierarchy::retrieve_temporal_context(
     Level level,
     int max_results) {
     
-    std::vector<std::pair<int, float>> candidates;  // (node_id, relevance)
+    const TimeIndex& index = index_[static_cast<size_t>(level)];
+    if (max_results <= 0 || index.size() == 0) return {};
+    size_t k = static_cast<size_t>(max_results);
+    
+    // Walk outwards from query_time in start order. Coherence is at most 1,
+    // so exp(-dt / 60) bounds every node further away: stop once it cannot
+    // beat the current k-th best.
+    using Candidate = std::pair<float, int>;  // (relevance, node_id)
+    std::priority_queue<Candidate, std::vector<Candidate>, std::greater<Candidate>> best;
+    int64_t t = to_ticks(query_time);
+    size_t right = index.upper_bound(t);
+    size_t left = right;  // Next on the left is left - 1
     
-    for (const auto& [id, tnode] : temporal_nodes) {
-        if (tnode.level != level) continue;
+    while (left > 0 || right < index.size()) {
+        int64_t left_gap = left > 0 ? t - index.start_at(left - 1) : INT64_MAX;
+        int64_t right_gap = right < index.size() ? index.start_at(right) - t : INT64_MAX;
+        size_t pos = left_gap <= right_gap ? --left : right++;
         
         // Compute temporal relevance
-        auto time_diff = std::abs(std::chrono::duration<float>(
-            query_time - tnode.start_time).count());
+        float time_diff = ticks_to_seconds(std::min(left_gap, right_gap));
+        float bound = std::exp(-time_diff / 60.0f);  // 1-min decay
+        if (best.size() == k && bound <= best.top().first) break;
         
-        float relevance = tnode.coherence * std::exp(-time_diff / 60.0f);  // 1-min decay
-        candidates.push_back({id, relevance});
+        int id = index.id_at(pos);
+        auto it = temporal_nodes.find(id);
+        if (it == temporal_nodes.end()) continue;
+        
+        float relevance = it->second.coherence * bound;
+        if (best.size() < k) {
+            best.emplace(relevance, id);
+        } else if (relevance > best.top().first) {
+            best.pop();
+            best.emplace(relevance, id);
+        }
     }
     
-    // Sort by relevance
-    std::sort(candidates.begin(), candidates.end(),
-             [](const auto& a, const auto& b) { return a.second > b.second; });
-    
-    // Return top results
-    std::vector<int> result;
-    for (size_t i = 0; i < std::min((size_t)max_results, candidates.size()); ++i) {
-        result.push_back(candidates[i].first);
+    // Return top results, most relevant first
+    std::vector<int> result(best.size());
+    for (size_t i = result.size(); i-- > 0; best.pop()) {
+        result[i] = best.top().second;
     }
     return result;
 }
 
+std::vector<int> TemporalHierarchy::retrieve_range(Level level, Clock::time_point from,
+                                                   Clock::time_point to) const {
+    std::vector<int> result;
+    if (to < from) return result;
+    index_[static_cast<size_t>(level)].overlapping(to_ticks(from), to_ticks(to), result);
+    return result;
+}
+
+int TemporalHierarchy::retrieve_nearest(Level level, Clock::time_point t) const {
+    return index_[static_cast<size_t>(level)].nearest(to_ticks(t));
+}
+
+void TemporalHierarchy::set_memory_budget(size_t bytes) {
+    memory_budget_ = bytes;
+    if (memory_budget_ > 0 && memory_bytes() > memory_budget_) {
+        compact();
+    }
+}
+
+size_t TemporalHierarchy::memory_bytes() const {
+    size_t bytes = node_bytes_;
+    for (const auto& index : index_) {
+        bytes += index.memory_bytes();
+    }
+    return bytes;
+}
+
+void TemporalHierarchy::compact() {
+    // Compact down to 7/8 of the budget so the next insert does not retrigger
+    size_t target = memory_budget_ - memory_budget_ / 8;
+    while (memory_bytes() > target) {
+        bool compacted = false;
+        for (size_t level = 0; level + 1 < LEVEL_COUNT && !compacted; ++level) {
+            compacted = compact_level(level);
+        }
+        if (compacted) continue;
+        
+        // Only narratives left to give: drop the oldest, keep the latest
+        TimeIndex& top = index_[LEVEL_COUNT - 1];
+        if (top.size() <= 1) break;
+        erase_oldest(LEVEL_COUNT - 1, std::max<size_t>(1, (top.size() - 1) / 4));
+    }
+}
+
+bool TemporalHierarchy::compact_level(size_t level) {
+    TimeIndex& index = index_[level];
+    if (index.size() <= MIN_RETAINED) return false;
+    size_t count = std::max<size_t>(1, (index.size() - MIN_RETAINED) / 2);
+    
+    // Roll runs of nodes nothing summarizes yet into the level above
+    static const std::unordered_map<int, std::vector<float>> no_embeddings;
+    std::vector<int> run;
+    auto flush = [&]() {
+        if (run.empty()) return;
+        summarize(run, static_cast<Level>(level), Clock::time_point(), Clock::time_point(),
+                  no_embeddings);
+        run.clear();
+    };
+    for (size_t i = 0; i < count; ++i) {
+        int id = index.id_at(i);
+        auto it = temporal_nodes.find(id);
+        if (it == temporal_nodes.end() || it->second.parent >= 0) {
+            flush();
+            continue;
+        }
+        run.push_back(id);
+        if (run.size() == COMPACTION_FANOUT) flush();
+    }
+    flush();
+    
+    erase_oldest(level, count);
+    return true;
+}
+
+void TemporalHierarchy::erase_oldest(size_t level, size_t count) {
+    TimeIndex& index = index_[level];
+    for (size_t i = 0; i < count; ++i) {
+        auto it = temporal_nodes.find(index.id_at(i));
+        if (it == temporal_nodes.end()) continue;
+        node_bytes_ -= std::min(node_bytes_, node_bytes(it->second));
+        temporal_nodes.erase(it);
+    }
+    index.erase_oldest(count);
+}
+
+size_t TemporalHierarchy::node_bytes(const TemporalNode& node) const {
+    // Map entry (node + bucket slot) and the payload vectors
+    return sizeof(std::pair<const int, TemporalNode>) + 2 * sizeof(void*) +
+           node.constituent_nodes.size() * sizeof(int) + node.summary_q.size();
+}
+
+// ----------------------------------------------------------------------------
+// TemporalHierarchy::TimeIndex
+// ----------------------------------------------------------------------------
+
+void TemporalHierarchy::TimeIndex::insert(int id, int64_t start, int64_t end) {
+    if (entries_.empty() || start >= entries_.back().start) {
+        entries_.push_back({start, end, id});
+        size_t pos = entries_.size() - 1;
+        if (dirty_ || pos >= leaves_) {
+            dirty_ = true;
+            return;
+        }
+        // In-order append (the common case): refresh one leaf-to-root path
+        size_t node = leaves_ + pos;
+        max_end_[node] = end;
+        for (node /= 2; node >= 1; node /= 2) {
+            max_end_[node] = std::max(max_end_[2 * node], max_end_[2 * node + 1]);
+        }
+        return;
+    }
+    
+    auto it = std::upper_bound(entries_.begin(), entries_.end(), start,
+                               [](int64_t t, const Entry& e) { return t < e.start; });
+    entries_.insert(it, {start, end, id});
+    dirty_ = true;
+}
+
+void TemporalHierarchy::TimeIndex::erase_oldest(size_t count) {
+    count = std::min(count, entries_.size());
+    entries_.erase(entries_.begin(), entries_.begin() + count);
+    dirty_ = true;
+}
+
+size_t TemporalHierarchy::TimeIndex::upper_bound(int64_t t) const {
+    auto it = std::upper_bound(entries_.begin(), entries_.end(), t,
+                               [](int64_t value, const Entry& e) { return value < e.start; });
+    return static_cast<size_t>(it - entries_.begin());
+}
+
+void TemporalHierarchy::TimeIndex::overlapping(int64_t t0, int64_t t1, std::vector<int>& out) const {
+    if (entries_.empty()) return;
+    if (dirty_) rebuild();
+    
+    // Spans starting by t1 are a prefix; of those, report the ones ending at
+    // or after t0, skipping subtrees whose max end is earlier
+    size_t limit = upper_bound(t1);
+    if (limit > 0) collect(1, 0, leaves_, limit, t0, out);
+}
+
+void TemporalHierarchy::TimeIndex::collect(size_t node, size_t lo, size_t hi, size_t limit,
+                                           int64_t t0, std::vector<int>& out) const {
+    if (lo >= limit || max_end_[node] < t0) return;
+    if (hi - lo == 1) {
+        out.push_back(entries_[lo].id);
+        return;
+    }
+    size_t mid = lo + (hi - lo) / 2;
+    collect(2 * node, lo, mid, limit, t0, out);
+    collect(2 * node + 1, mid, hi, limit, t0, out);
+}
+
+int TemporalHierarchy::TimeIndex::nearest(int64_t t) const {
+    if (entries_.empty()) return -1;
+    if (dirty_) rebuild();
+    
+    // Right candidate: first span starting after t
+    size_t limit = upper_bound(t);
+    int best = -1;
+    int64_t best_gap = INT64_MAX;
+    if (limit < entries_.size()) {
+        best = entries_[limit].id;
+        best_gap = entries_[limit].start - t;
+    }
+    if (limit == 0) return best;
+    
+    // Left candidate: the latest-ending span among those starting by t,
+    // the max over the canonical subtrees covering the prefix
+    size_t best_node = 0;
+    auto consider = [&](size_t node) {
+        if (best_node == 0 || max_end_[node] > max_end_[best_node]) best_node = node;
+    };
+    for (size_t node = 1, lo = 0, span = leaves_; ; span /= 2) {
+        if (lo + span <= limit) {
+            consider(node);
+            break;
+        }
+        size_t half = span / 2;
+        if (lo + half <= limit) {
+            consider(2 * node);
+            if (lo + half == limit) break;
+            node = 2 * node + 1;
+            lo += half;
+        } else {
+            node = 2 * node;
+        }
+    }
+    while (best_node < leaves_) {
+        best_node = max_end_[2 * best_node] >= max_end_[2 * best_node + 1] ? 2 * best_node
+                                                                          : 2 * best_node + 1;
+    }
+    const Entry& left = entries_[best_node - leaves_];
+    int64_t left_gap = left.end >= t ? 0 : t - left.end;
+    return left_gap <= best_gap ? left.id : best;
+}
+
+void TemporalHierarchy::TimeIndex::rebuild() const {
+    // Room to grow so in-order appends keep the tree valid
+    leaves_ = 16;
+    while (leaves_ < entries_.size() + entries_.size() / 2) leaves_ *= 2;
+    max_end_.assign(2 * leaves_, INT64_MIN);
+    for (size_t i = 0; i < entries_.size(); ++i) {
+        max_end_[leaves_ + i] = entries_[i].end;
+    }
+    for (size_t node = leaves_ - 1; node >= 1; --node) {
+        max_end_[node] = std::max(max_end_[2 * node], max_end_[2 * node + 1]);
+    }
+    dirty_ = false;
+}
+
+size_t TemporalHierarchy::TimeIndex::memory_bytes() const {
+    return entries_.capacity() * sizeof(Entry) + max_end_.capacity() * sizeof(int64_t);
+}
+
 // ============================================================================
 // UnifiedActivationField Implementation
 // ============================================================================
@@ -296,88 +761,119 @@ UnifiedActivationField::UnifiedActivationField()
 }
 
 UnifiedActivationField::~UnifiedActivationField() {
+    // Return pending payloads (heap-class ones would otherwise leak)
+    for (auto& queue : message_queues_) {
+        while (MessageNode* node = queue.pop()) {
+            message_pool_.release(node);
+        }
+    }
 }
 
 void UnifiedActivationField::inject_energy(int node_id, float energy, 
                                            const std::vector<float>& embedding) {
+    inject_energy_raw(node_id, energy, embedding.data(), embedding.size());
+}
+
+void UnifiedActivationField::inject_energy_raw(int node_id, float energy,
+                                               const float* embedding, size_t dim) {
     std::lock_guard<std::mutex> lock(field_mutex_);
     
-    activations_[node_id] += energy;
-    embeddings_[node_id] = embedding;
+    float& activation = activations_[node_slot(node_id)];
+    activation += energy;
+    auto& stored = embeddings_[node_id];
+    stored.assign(embedding, embedding + dim);
     atomic_float_add(total_energy_, energy);
     
     // Update working context
     float salience = energy / max_total_energy_;  // Normalize
-    working_context_.update_concept(node_id, activations_[node_id], salience, embedding);
+    working_context_.update_concept(node_id, activation, salience, stored);
 }
 
 float UnifiedActivationField::get_activation(int node_id) const {
     std::lock_guard<std::mutex> lock(field_mutex_);
-    auto it = activations_.find(node_id);
-    return (it != activations_.end()) ? it->second : 0.0f;
+    int64_t slot = edges_.find(node_id);
+    return slot >= 0 ? activations_[slot] : 0.0f;
 }
 
 void UnifiedActivationField::set_activation(int node_id, float activation) {
     std::lock_guard<std::mutex> lock(field_mutex_);
-    float old_activation = activations_[node_id];
-    activations_[node_id] = activation;
+    float& slot = activations_[node_slot(node_id)];
+    float old_activation = slot;
+    slot = activation;
     atomic_float_add(total_energy_, activation - old_activation);
 }
 
+uint32_t UnifiedActivationField::node_slot(int node_id) {
+    uint32_t slot = edges_.intern(node_id);
+    if (slot >= activations_.size()) {
+        activations_.resize(slot + 1, 0.0f);
+    }
+    return slot;
+}
+
 void UnifiedActivationField::tick(float dt) {
+    static auto& tick_latency = metrics::latency_metric("field.unified_tick");
+    metrics::ScopedLatency timer(tick_latency);
+    MELVIN_TRACE_SCOPE("field.unified_tick");
+    
     auto now = std::chrono::high_resolution_clock::now();
     float actual_dt = std::chrono::duration<float>(now - last_tick_).count();
     last_tick_ = now;
     
     // Run all field dynamics in parallel (conceptually)
-    decay_activations(actual_dt);
-    spread_activation(actual_dt);
     update_working_context(actual_dt);
-    hopfield_update(actual_dt);
+    field_dynamics(actual_dt);
     process_messages();
 }
 
-void UnifiedActivationField::decay_activations(float dt) {
+void UnifiedActivationField::field_dynamics(float dt) {
     std::lock_guard<std::mutex> lock(field_mutex_);
-    
-    float decay_rate = 0.1f;  // TODO: Get from genome
-    float decay_factor = std::exp(-decay_rate * dt);
-    
-    for (auto& [node_id, activation] : activations_) {
-        float old_val = activation;
-        activation *= decay_factor;
-        atomic_float_add(total_energy_, activation - old_val);
-        
-        if (activation < 0.001f) {
-            activation = 0.0f;
-        }
+    if (edges_.dirty) {
+        edges_.reindex();
     }
+    decay_and_spread(dt);
+    hopfield_update(dt);
 }
 
-void UnifiedActivationField::spread_activation(float dt) {
-    std::lock_guard<std::mutex> lock(field_mutex_);
-    
-    std::unordered_map<int, float> spread_delta;
+void UnifiedActivationField::decay_and_spread(float dt) {
+    // Caller holds field_mutex_ and the edge index is current
+    float decay_rate = 0.1f;  // TODO: Get from genome
+    float decay_factor = std::exp(-decay_rate * dt);
     float spread_rate = 0.3f;  // TODO: Get from genome
+    float spread_scale = spread_rate * dt;
     
-    for (const auto& [from_node, activation] : activations_) {
+    const size_t n = activations_.size();
+    spread_delta_.assign(n, 0.0f);
+    const uint32_t* offsets = edges_.out_offsets.data();
+    const uint32_t* to = edges_.to.data();
+    const float* symbolic = edges_.symbolic_weight.data();
+    const float* similarity = edges_.embedding_similarity.data();
+    const float bias = symbolic_bias_;
+    float* delta = spread_delta_.data();
+    double energy_change = 0.0;
+    
+    // One sweep: decay each node, then spread from it over its out-edge row
+    // (rows are contiguous, so the weight blend streams both weight columns)
+    for (size_t u = 0; u < n; ++u) {
+        float old_val = activations_[u];
+        float activation = old_val * decay_factor;
+        energy_change += activation - old_val;
+        if (activation < 0.001f) activation = 0.0f;
+        activations_[u] = activation;
+        
         if (activation < 0.01f) continue;
         
-        auto it = edges_out_.find(from_node);
-        if (it != edges_out_.end()) {
-            for (const auto& edge : it->second) {
-                float transfer = activation * edge.get_effective_weight() * spread_rate * dt;
-                spread_delta[edge.to_node] += transfer;
-                spread_delta[from_node] -= transfer;
-            }
+        float scale = activation * spread_scale;
+        float outgoing = 0.0f;
+        for (uint32_t e = offsets[u]; e < offsets[u + 1]; ++e) {
+            float transfer = scale * (bias * symbolic[e] + (1.0f - bias) * similarity[e]);
+            delta[to[e]] += transfer;
+            outgoing += transfer;
         }
+        delta[u] -= outgoing;
     }
     
-    // Apply spread
-    for (const auto& [node_id, delta] : spread_delta) {
-        activations_[node_id] += delta;
-        atomic_float_add(total_energy_, delta);
-    }
+    atomic_float_add(total_energy_, static_cast<float>(energy_change));
 }
 
 void UnifiedActivationField::update_working_context(float dt) {
@@ -385,53 +881,68 @@ void UnifiedActivationField::update_working_context(float dt) {
 }
 
 void UnifiedActivationField::hopfield_update(float dt) {
-    // Simple attractor dynamics - nodes with strong mutual connections stabilize
-    std::lock_guard<std::mutex> lock(field_mutex_);
+    // Simple attractor dynamics - nodes with strong mutual connections stabilize.
+    // Caller holds field_mutex_; spread_delta_ holds the pending spread.
+    const size_t n = activations_.size();
+    float* activation = activations_.data();
+    const float* delta = spread_delta_.data();
+    double energy_change = 0.0;
+    
+    // Apply spread (dense, vectorizable)
+    for (size_t u = 0; u < n; ++u) {
+        activation[u] += delta[u];
+        energy_change += delta[u];
+    }
     
-    std::unordered_map<int, float> hopfield_delta;
+    // Hopfield deltas are computed from the post-spread field, then applied
+    const uint32_t* offsets = edges_.in_offsets.data();
+    const uint32_t* in_edges = edges_.in_edges.data();
+    const uint32_t* from = edges_.from.data();
+    const float* symbolic = edges_.symbolic_weight.data();
+    const float* similarity = edges_.embedding_similarity.data();
+    const float bias = symbolic_bias_;
+    float* hopfield_delta = spread_delta_.data();  // Reuse: the spread is applied
     
-    for (const auto& [node_id, activation] : activations_) {
-        if (activation < 0.01f) continue;
+    for (size_t v = 0; v < n; ++v) {
+        hopfield_delta[v] = 0.0f;
+        if (activation[v] < 0.01f) continue;
         
         // Sum incoming activation
         float incoming = 0.0f;
-        auto it_in = edges_in_.find(node_id);
-        if (it_in != edges_in_.end()) {
-            for (const auto& edge : it_in->second) {
-                auto it_act = activations_.find(edge.from_node);
-                if (it_act != activations_.end()) {
-                    incoming += it_act->second * edge.get_effective_weight();
-                }
-            }
+        for (uint32_t i = offsets[v]; i < offsets[v + 1]; ++i) {
+            uint32_t e = in_edges[i];
+            incoming += activation[from[e]] * (bias * symbolic[e] + (1.0f - bias) * similarity[e]);
         }
         
         // Hopfield update rule: Δa = tanh(incoming) - a
         float target = std::tanh(incoming * 0.1f);
-        hopfield_delta[node_id] = (target - activation) * 0.1f * dt;
+        hopfield_delta[v] = (target - activation[v]) * 0.1f * dt;
     }
     
     // Apply updates
-    for (const auto& [node_id, delta] : hopfield_delta) {
-        activations_[node_id] += delta;
-        atomic_float_add(total_energy_, delta);
+    for (size_t v = 0; v < n; ++v) {
+        activation[v] += hopfield_delta[v];
+        energy_change += hopfield_delta[v];
     }
+    
+    atomic_float_add(total_energy_, static_cast<float>(energy_change));
 }
 
 void UnifiedActivationField::process_messages() {
-    std::vector<FieldMessage> messages;
-    {
-        std::lock_guard<std::mutex> lock(queue_mutex_);
-        while (!message_queue_.empty()) {
-            messages.push_back(message_queue_.front());
-            message_queue_.pop();
-        }
-    }
-    
-    // Process each message type
-    for (const auto& msg : messages) {
-        switch (msg.type) {
+    // Drain every type each tick so queues without an external consumer
+    // stay bounded; only sensory input has a handler so far
+    for (size_t t = 0; t < MESSAGE_TYPE_COUNT; ++t) {
+        MessageType type = static_cast<MessageType>(t);
+        tick_batch_.clear();
+        if (drain_messages(type, tick_batch_) == 0) continue;
+        
+        switch (type) {
             case MessageType::SENSORY_INPUT:
-                inject_energy(msg.target_node_id, msg.energy, msg.data);
+                for (size_t i = 0; i < tick_batch_.size(); ++i) {
+                    const auto& msg = tick_batch_.messages[i];
+                    inject_energy_raw(msg.target_node_id, msg.energy,
+                                      tick_batch_.data(i), msg.payload_size);
+                }
                 break;
                 
             case MessageType::PREDICTION_ERROR:
@@ -466,46 +977,100 @@ void UnifiedActivationField::process_messages() {
 }
 
 void UnifiedActivationField::post_message(const FieldMessage& msg) {
-    std::lock_guard<std::mutex> lock(queue_mutex_);
-    message_queue_.push(msg);
+    enqueue_message(msg.type, msg.source_node_id, msg.target_node_id, msg.energy, msg.confidence,
+                    msg.timestamp, msg.data.data(), msg.data.size());
+}
+
+bool UnifiedActivationField::post_message(MessageType type, int source, int target, float energy,
+                                          float confidence, const float* data, size_t data_size) {
+    return enqueue_message(type, source, target, energy, confidence,
+                           std::chrono::high_resolution_clock::now(), data, data_size);
+}
+
+bool UnifiedActivationField::enqueue_message(MessageType type, int source, int target, float energy,
+                                             float confidence,
+                                             std::chrono::high_resolution_clock::time_point timestamp,
+                                             const float* data, size_t data_size) {
+    size_t t = static_cast<size_t>(type);
+    MessageNode* node = t < MESSAGE_TYPE_COUNT ? message_pool_.acquire(data_size) : nullptr;
+    if (!node) {
+        dropped_messages_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    
+    node->source_node_id = source;
+    node->target_node_id = target;
+    node->energy = energy;
+    node->confidence = confidence;
+    node->timestamp = timestamp;
+    if (data_size > 0) {
+        std::memcpy(node->payload(), data, data_size * sizeof(float));
+    }
+    
+    message_queues_[t].push(node);
+    return true;
 }
 
 std::vector<FieldMessage> UnifiedActivationField::drain_messages(MessageType type) {
     std::vector<FieldMessage> result;
-    std::vector<FieldMessage> remaining;
+    size_t t = static_cast<size_t>(type);
+    if (t >= MESSAGE_TYPE_COUNT) return result;
     
-    std::lock_guard<std::mutex> lock(queue_mutex_);
-    while (!message_queue_.empty()) {
-        auto msg = message_queue_.front();
-        message_queue_.pop();
-        
-        if (msg.type == type) {
-            result.push_back(msg);
-        } else {
-            remaining.push_back(msg);
-        }
+    std::lock_guard<std::mutex> lock(drain_mutex_[t]);
+    MessagePool::ReleaseBatch released(message_pool_);
+    while (MessageNode* node = message_queues_[t].pop()) {
+        result.emplace_back(type, node->source_node_id, node->target_node_id,
+                            node->energy, node->confidence);
+        auto& msg = result.back();
+        msg.timestamp = node->timestamp;
+        msg.data.assign(node->payload(), node->payload() + node->payload_size);
+        released.add(node);
     }
+    return result;
+}
+
+size_t UnifiedActivationField::drain_messages(MessageType type, FieldMessageBatch& batch,
+                                              size_t max_messages) {
+    size_t t = static_cast<size_t>(type);
+    if (t >= MESSAGE_TYPE_COUNT) return 0;
     
-    // Put remaining messages back
-    for (const auto& msg : remaining) {
-        message_queue_.push(msg);
+    std::lock_guard<std::mutex> lock(drain_mutex_[t]);
+    MessagePool::ReleaseBatch released(message_pool_);
+    size_t drained = 0;
+    while (drained < max_messages) {
+        MessageNode* node = message_queues_[t].pop();
+        if (!node) break;
+        
+        FieldMessageBatch::Entry entry;
+        entry.source_node_id = node->source_node_id;
+        entry.target_node_id = node->target_node_id;
+        entry.energy = node->energy;
+        entry.confidence = node->confidence;
+        entry.payload_offset = static_cast<uint32_t>(batch.payload.size());
+        entry.payload_size = node->payload_size;
+        entry.timestamp = node->timestamp;
+        batch.messages.push_back(entry);
+        batch.payload.insert(batch.payload.end(), node->payload(), node->payload() + node->payload_size);
+        
+        released.add(node);
+        drained++;
     }
-    
-    return result;
+    return drained;
+}
+
+size_t UnifiedActivationField::pending_messages(MessageType type) const {
+    size_t t = static_cast<size_t>(type);
+    return t < MESSAGE_TYPE_COUNT ? message_queues_[t].size_approx() : 0;
 }
 
 std::vector<float> UnifiedActivationField::compute_global_context(int origin_node, int max_hops) {
     std::lock_guard<std::mutex> lock(field_mutex_);
     
-    // Convert edges to graph format for propagation
-    std::unordered_map<int, std::vector<std::pair<int, float>>> graph;
-    for (const auto& [from_node, edges] : edges_out_) {
-        for (const auto& edge : edges) {
-            graph[from_node].push_back({edge.to_node, edge.get_effective_weight()});
-        }
+    // Walk the edge table in place: no per-call copy of the graph
+    if (edges_.dirty) {
+        edges_.reindex();
     }
-    
-    auto neighborhood = context_horizon_.propagate(origin_node, graph, max_hops);
+    auto neighborhood = context_horizon_.propagate(origin_node, edges_, max_hops, 0.01f, symbolic_bias_);
     return context_horizon_.compute_context_vector(neighborhood, embeddings_);
 }
 
@@ -513,7 +1078,12 @@ void UnifiedActivationField::add_edge(int from, int to, HybridEdge::Type type, f
                                       const std::vector<float>& from_emb,
                                       const std::vector<float>& to_emb) {
     std::lock_guard<std::mutex> lock(field_mutex_);
-    
+    add_edge_locked(from, to, type, weight, from_emb, to_emb);
+}
+
+void UnifiedActivationField::add_edge_locked(int from, int to, HybridEdge::Type type, float weight,
+                                             const std::vector<float>& from_emb,
+                                             const std::vector<float>& to_emb) {
     // Compute embedding similarity (cosine)
     float dot = 0.0f, norm_a = 0.0f, norm_b = 0.0f;
     size_t dim = std::min(from_emb.size(), to_emb.size());
@@ -525,42 +1095,65 @@ void UnifiedActivationField::add_edge(int from, int to, HybridEdge::Type type, f
     float embedding_sim = (norm_a > 0 && norm_b > 0) ? 
         dot / (std::sqrt(norm_a) * std::sqrt(norm_b)) : 0.0f;
     
-    HybridEdge edge(from, to, type, weight, embedding_sim);
-    edges_out_[from].push_back(edge);
-    edges_in_[to].push_back(edge);
+    // Indexed lazily on the next tick or context query
+    uint32_t from_slot = node_slot(from);
+    uint32_t to_slot = node_slot(to);
+    edges_.add(from_slot, to_slot, type, weight, embedding_sim);
+}
+
+std::vector<HybridEdge> UnifiedActivationField::get_edges_from(int node_id) const {
+    std::lock_guard<std::mutex> lock(field_mutex_);
+    std::vector<HybridEdge> result;
+    int64_t u = edges_.find(node_id);
+    if (u < 0) return result;
+    
+    if (!edges_.dirty) {
+        for (uint32_t e = edges_.out_offsets[u]; e < edges_.out_offsets[u + 1]; ++e) {
+            result.push_back(edges_.edge(e));
+        }
+    } else {
+        // Not indexed yet (const: no reindex here)
+        for (uint32_t e = 0; e < edges_.edge_count(); ++e) {
+            if (edges_.from[e] == u) result.push_back(edges_.edge(e));
+        }
+    }
+    return result;
+}
+
+size_t UnifiedActivationField::get_edge_count() const {
+    std::lock_guard<std::mutex> lock(field_mutex_);
+    return edges_.edge_count();
 }
 
-const std::vector<HybridEdge>& UnifiedActivationField::get_edges_from(int node_id) const {
-    static std::vector<HybridEdge> empty;
+size_t UnifiedActivationField::get_edge_memory_bytes() const {
     std::lock_guard<std::mutex> lock(field_mutex_);
-    auto it = edges_out_.find(node_id);
-    return (it != edges_out_.end()) ? it->second : empty;
+    return edges_.memory_bytes();
 }
 
 void UnifiedActivationField::bind_cross_modal(int text_node, int vision_node, int motor_node,
                                                float temporal_overlap) {
     std::lock_guard<std::mutex> lock(field_mutex_);
     
-    float text_act = activations_[text_node];
-    float vision_act = activations_[vision_node];
-    float motor_act = activations_[motor_node];
+    float text_act = activations_[node_slot(text_node)];
+    float vision_act = activations_[node_slot(vision_node)];
+    float motor_act = activations_[node_slot(motor_node)];
     
     // Δw = η × activation_text × activation_vision × temporal_overlap
     float binding_strength = 0.1f * text_act * vision_act * temporal_overlap;
     
-    // Create bidirectional cross-modal edges
+    // Create bidirectional cross-modal edges (field_mutex_ is held: use the locked variant)
     if (embeddings_.count(text_node) && embeddings_.count(vision_node)) {
-        add_edge(text_node, vision_node, HybridEdge::Type::EXACT, binding_strength,
-                embeddings_[text_node], embeddings_[vision_node]);
-        add_edge(vision_node, text_node, HybridEdge::Type::EXACT, binding_strength,
-                embeddings_[vision_node], embeddings_[text_node]);
+        add_edge_locked(text_node, vision_node, HybridEdge::Type::EXACT, binding_strength,
+                       embeddings_[text_node], embeddings_[vision_node]);
+        add_edge_locked(vision_node, text_node, HybridEdge::Type::EXACT, binding_strength,
+                       embeddings_[vision_node], embeddings_[text_node]);
     }
     
     if (motor_node >= 0 && embeddings_.count(motor_node)) {
         float motor_binding = 0.1f * vision_act * motor_act * temporal_overlap;
         if (embeddings_.count(vision_node)) {
-            add_edge(vision_node, motor_node, HybridEdge::Type::VISUOMOTOR, motor_binding,
-                    embeddings_[vision_node], embeddings_[motor_node]);
+            add_edge_locked(vision_node, motor_node, HybridEdge::Type::VISUOMOTOR, motor_binding,
+                           embeddings_[vision_node], embeddings_[motor_node]);
         }
     }
 }
@@ -579,7 +1172,7 @@ std::vector<std::string> UnifiedActivationField::get_reflections() {
 size_t UnifiedActivationField::get_active_node_count() const {
     std::lock_guard<std::mutex> lock(field_mutex_);
     return std::count_if(activations_.begin(), activations_.end(),
-                        [](const auto& p) { return p.second >= 0.01f; });
+                        [](float act) { return act >= 0.01f; });
 }
 
 float UnifiedActivationField::get_total_energy() const {
@@ -595,7 +1188,7 @@ float UnifiedActivationField::compute_field_coherence() const {
     
     // Coherence = variance of activation magnitudes (low = stable)
     std::vector<float> activations;
-    for (const auto& [node_id, act] : activations_) {
+    for (float act : activations_) {
         if (act >= 0.01f) {
             activations.push_back(act);
         }
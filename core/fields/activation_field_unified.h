@@ -3,11 +3,14 @@
 
 #include <unordered_map>
 #include <vector>
+#include <array>
+#include <cstdint>
 #include <queue>
 #include <mutex>
 #include <atomic>
 #include <chrono>
 #include <memory>
+#include "field_message_queue.h"
 
 namespace melvin {
 namespace fields {
@@ -32,6 +35,8 @@ enum class MessageType {
     REFLECTION          // Meta-cognitive query
 };
 
+constexpr size_t MESSAGE_TYPE_COUNT = 8;
+
 // Message payload for inter-field communication
 struct FieldMessage {
     MessageType type;
@@ -48,6 +53,28 @@ struct FieldMessage {
           timestamp(std::chrono::high_resolution_clock::now()) {}
 };
 
+// Caller-owned drain buffer: reuse it across drains and steady-state
+// draining never allocates. Payloads are packed back to back.
+struct FieldMessageBatch {
+    struct Entry {
+        int source_node_id;
+        int target_node_id;
+        float energy;
+        float confidence;
+        uint32_t payload_offset;
+        uint32_t payload_size;
+        std::chrono::high_resolution_clock::time_point timestamp;
+    };
+    
+    std::vector<Entry> messages;
+    std::vector<float> payload;
+    
+    void clear() { messages.clear(); payload.clear(); }
+    size_t size() const { return messages.size(); }
+    bool empty() const { return messages.empty(); }
+    const float* data(size_t i) const { return payload.data() + messages[i].payload_offset; }
+};
+
 // Working memory buffer - maintains 4-7 active concepts
 struct WorkingContext {
     struct ActiveConcept {
@@ -80,6 +107,74 @@ struct WorkingContext {
     std::vector<float> get_context_vector();
 };
 
+// Hybrid edge system - symbolic + embedding-based
+struct HybridEdge {
+    int from_node;
+    int to_node;
+    
+    // Symbolic component
+    enum class Type { EXACT, LEAP, TEMPORAL, CAUSAL, VISUOMOTOR } type;
+    float symbolic_weight;
+    
+    // Embedding component
+    float embedding_similarity;  // Cosine similarity of node embeddings
+    
+    // Combined weight
+    float get_effective_weight(float symbolic_bias = 0.7f) const {
+        return symbolic_bias * symbolic_weight + 
+               (1.0f - symbolic_bias) * embedding_similarity;
+    }
+    
+    HybridEdge(int from, int to, Type t, float sw, float es)
+        : from_node(from), to_node(to), type(t), 
+          symbolic_weight(sw), embedding_similarity(es) {}
+};
+
+// Hybrid edges in structure-of-arrays form over dense node indices.
+// Each edge is stored once. After reindex() edges are grouped by source,
+// so a node's out-edges are the contiguous id range out_offsets[u] ..
+// out_offsets[u+1]; in_edges holds edge ids grouped by target. Edges
+// added since the last reindex() sit unindexed at the end; new nodes
+// alone keep the indices valid.
+struct HybridEdgeTable {
+    // Edge columns (edge id = position)
+    std::vector<uint32_t> from;
+    std::vector<uint32_t> to;
+    std::vector<uint8_t> type;
+    std::vector<float> symbolic_weight;
+    std::vector<float> embedding_similarity;
+    
+    // Dense node index
+    std::unordered_map<int, uint32_t> node_index;
+    std::vector<int> node_ids;
+    
+    // CSR indices (valid when !dirty)
+    std::vector<uint32_t> out_offsets;  // node_count() + 1
+    std::vector<uint32_t> in_offsets;   // node_count() + 1
+    std::vector<uint32_t> in_edges;     // Edge ids
+    bool dirty = false;
+    
+    uint32_t intern(int node_id);
+    int64_t find(int node_id) const;  // -1 when unknown
+    void add(uint32_t from_index, uint32_t to_index, HybridEdge::Type edge_type,
+             float symbolic, float similarity);
+    
+    // Group edges by source and rebuild both indices: O(nodes + edges)
+    void reindex();
+    
+    size_t node_count() const { return node_ids.size(); }
+    size_t edge_count() const { return from.size(); }
+    size_t memory_bytes() const;
+    
+    float weight(uint32_t e, float symbolic_bias) const {
+        return symbolic_bias * symbolic_weight[e] + (1.0f - symbolic_bias) * embedding_similarity[e];
+    }
+    HybridEdge edge(uint32_t e) const {
+        return HybridEdge(node_ids[from[e]], node_ids[to[e]], static_cast<HybridEdge::Type>(type[e]),
+                          symbolic_weight[e], embedding_similarity[e]);
+    }
+};
+
 // Multi-hop context propagation
 struct ContextHorizon {
     struct HopNode {
@@ -97,6 +192,16 @@ struct ContextHorizon {
         float threshold = 0.01f
     );
     
+    // Same walk directly over an indexed edge table (effective weights
+    // computed per visited edge); cost scales with the k-hop neighborhood only
+    std::vector<HopNode> propagate(
+        int origin_node,
+        const HybridEdgeTable& edges,
+        int max_hops = 3,
+        float threshold = 0.01f,
+        float symbolic_bias = 0.7f
+    );
+    
     // Compute context vector from multi-hop neighborhood
     std::vector<float> compute_context_vector(
         const std::vector<HopNode>& neighborhood,
@@ -104,58 +209,119 @@ struct ContextHorizon {
     );
 };
 
-// Hybrid edge system - symbolic + embedding-based
-struct HybridEdge {
-    int from_node;
-    int to_node;
-    
-    // Symbolic component
-    enum class Type { EXACT, LEAP, TEMPORAL, CAUSAL, VISUOMOTOR } type;
-    float symbolic_weight;
-    
-    // Embedding component
-    float embedding_similarity;  // Cosine similarity of node embeddings
-    
-    // Combined weight
-    float get_effective_weight(float symbolic_bias = 0.7f) const {
-        return symbolic_bias * symbolic_weight + 
-               (1.0f - symbolic_bias) * embedding_similarity;
-    }
-    
-    HybridEdge(int from, int to, Type t, float sw, float es)
-        : from_node(from), to_node(to), type(t), 
-          symbolic_weight(sw), embedding_similarity(es) {}
-};
-
 // Hierarchical temporal memory layer
+// Each level keeps a time index: node spans sorted by start time with a
+// max-end tournament tree on top, so range queries cost O(log n) per hit and
+// nearest-time queries O(log n). Summary embeddings are stored as int8 with
+// a per-vector scale. Once memory_bytes() exceeds the budget the oldest
+// nodes of the lower levels are rolled up into the level above (when no
+// parent summarizes them yet) and dropped; the oldest narratives go last.
 struct TemporalHierarchy {
+    using Clock = std::chrono::high_resolution_clock;
+    
     enum class Level {
         FRAMES,      // 100ms - 5s (perception)
         SCENES,      // 5s - 2min (events)
         EPISODES,    // 2min+ (sequences)
         NARRATIVES   // Long-term themes
     };
+    static constexpr size_t LEVEL_COUNT = 4;
     
     struct TemporalNode {
         Level level;
         std::vector<int> constituent_nodes;  // Nodes that form this chunk
-        std::vector<float> summary_embedding;  // Compressed representation
-        std::chrono::high_resolution_clock::time_point start_time;
-        std::chrono::high_resolution_clock::time_point end_time;
+        std::vector<int8_t> summary_q;       // Quantized summary embedding
+        float summary_scale = 0.0f;          // summary = summary_q * scale
+        Clock::time_point start_time;
+        Clock::time_point end_time;
         float coherence;  // How well it fits together
+        int parent = -1;  // Node of the level above that summarizes this one
+        
+        std::vector<float> summary_embedding() const;  // Dequantized
+    };
+    
+    // Span index of one level
+    class TimeIndex {
+    public:
+        void insert(int id, int64_t start, int64_t end);
+        void erase_oldest(size_t count);
+        
+        // Ids whose span overlaps [t0, t1], oldest first
+        void overlapping(int64_t t0, int64_t t1, std::vector<int>& out) const;
+        // Id whose span is closest to t (0 distance when it contains t), -1 if empty
+        int nearest(int64_t t) const;
+        // Position of the first span starting after t
+        size_t upper_bound(int64_t t) const;
+        
+        size_t size() const { return entries_.size(); }
+        int id_at(size_t i) const { return entries_[i].id; }
+        int64_t start_at(size_t i) const { return entries_[i].start; }
+        size_t memory_bytes() const;
+        
+    private:
+        struct Entry { int64_t start; int64_t end; int id; };
+        std::vector<Entry> entries_;            // Sorted by start
+        mutable std::vector<int64_t> max_end_;  // Tournament tree over entries_
+        mutable size_t leaves_ = 0;
+        mutable bool dirty_ = false;
+        
+        void rebuild() const;
+        void collect(size_t node, size_t lo, size_t hi, size_t limit,
+                     int64_t t0, std::vector<int>& out) const;
     };
     
     std::unordered_map<int, TemporalNode> temporal_nodes;
     
-    // Compress a sequence into next level
+    // Compress a sequence into next level. From FRAMES the ids are graph
+    // nodes (summary from their embeddings, span [start, end]); from higher
+    // levels they are temporal nodes of from_level, whose spans and
+    // summaries are merged and which get the new node as parent.
     int compress_sequence(const std::vector<int>& node_ids, Level from_level);
+    int compress_sequence(const std::vector<int>& node_ids, Level from_level,
+                          Clock::time_point start, Clock::time_point end,
+                          const std::unordered_map<int, std::vector<float>>& embeddings);
     
-    // Retrieve relevant temporal context
+    // Retrieve relevant temporal context: top max_results by
+    // coherence * exp(-|query_time - start| / 60s), walking outwards from
+    // query_time in start order
     std::vector<int> retrieve_temporal_context(
         std::chrono::high_resolution_clock::time_point query_time,
         Level level,
         int max_results = 5
     );
+    
+    // Nodes of a level whose span overlaps [from, to], oldest first
+    std::vector<int> retrieve_range(Level level, Clock::time_point from,
+                                    Clock::time_point to) const;
+    
+    // Node of a level whose span is closest to t, -1 if the level is empty
+    int retrieve_nearest(Level level, Clock::time_point t) const;
+    
+    // Memory budget (0 = unbounded); compaction runs when it is exceeded
+    void set_memory_budget(size_t bytes);
+    size_t memory_budget() const { return memory_budget_; }
+    size_t memory_bytes() const;
+    size_t level_size(Level level) const { return index_[static_cast<size_t>(level)].size(); }
+    
+private:
+    std::array<TimeIndex, LEVEL_COUNT> index_;
+    int next_id_ = 1000000;  // Start from high number
+    size_t memory_budget_ = 32u << 20;
+    size_t node_bytes_ = 0;  // temporal_nodes entries and payloads
+    
+    // Lower levels keep at least this many recent nodes through compaction
+    static constexpr size_t MIN_RETAINED = 64;
+    // Nodes rolled up into one summary during compaction
+    static constexpr size_t COMPACTION_FANOUT = 16;
+    
+    // compress_sequence without the budget check
+    int summarize(const std::vector<int>& node_ids, Level from_level,
+                  Clock::time_point start, Clock::time_point end,
+                  const std::unordered_map<int, std::vector<float>>& embeddings);
+    void compact();
+    bool compact_level(size_t level);  // false when the level is at MIN_RETAINED
+    void erase_oldest(size_t level, size_t count);
+    size_t node_bytes(const TemporalNode& node) const;
 };
 
 // Main unified activation field
@@ -172,10 +338,20 @@ public:
     // Continuous dynamics (called at 10-30 Hz)
     void tick(float dt);
     
-    // Message queue system for async communication
+    // Message queue system for async communication: one lock-free MPSC
+    // queue per MessageType, payloads in a recycled slab pool. Any thread
+    // may post; each type should have a single draining thread.
     void post_message(const FieldMessage& msg);
+    bool post_message(MessageType type, int source, int target, float energy,
+                      float confidence, const float* data, size_t data_size);
     std::vector<FieldMessage> drain_messages(MessageType type);
     
+    // Append up to max_messages pending messages of one type to batch
+    size_t drain_messages(MessageType type, FieldMessageBatch& batch,
+                          size_t max_messages = SIZE_MAX);
+    size_t pending_messages(MessageType type) const;
+    uint64_t dropped_messages() const { return dropped_messages_.load(std::memory_order_relaxed); }
+    
     // Working context
     WorkingContext& get_working_context() { return working_context_; }
     const WorkingContext& get_working_context() const { return working_context_; }
@@ -187,7 +363,9 @@ public:
     void add_edge(int from, int to, HybridEdge::Type type, float weight,
                   const std::vector<float>& from_emb,
                   const std::vector<float>& to_emb);
-    const std::vector<HybridEdge>& get_edges_from(int node_id) const;
+    std::vector<HybridEdge> get_edges_from(int node_id) const;  // Materialized copies
+    size_t get_edge_count() const;
+    size_t get_edge_memory_bytes() const;
     
     // Temporal hierarchy
     TemporalHierarchy& get_temporal_hierarchy() { return temporal_hierarchy_; }
@@ -206,17 +384,23 @@ public:
     float get_coherence() const;  // Measure of field stability
     
 private:
-    // Activation field
-    std::unordered_map<int, float> activations_;
+    // Activation field: dense, indexed like edges_.node_ids
+    std::vector<float> activations_;
     std::unordered_map<int, std::vector<float>> embeddings_;
     
-    // Graph structure (hybrid edges)
-    std::unordered_map<int, std::vector<HybridEdge>> edges_out_;
-    std::unordered_map<int, std::vector<HybridEdge>> edges_in_;
+    // Graph structure (hybrid edges); also the adjacency ContextHorizon walks
+    HybridEdgeTable edges_;
+    float symbolic_bias_ = 0.7f;
+    
+    // Dynamics scratch (reused every tick)
+    std::vector<float> spread_delta_;
     
     // Message queues for async operation
-    std::queue<FieldMessage> message_queue_;
-    std::mutex queue_mutex_;
+    MessagePool message_pool_;
+    MPSCMessageQueue message_queues_[MESSAGE_TYPE_COUNT];
+    std::mutex drain_mutex_[MESSAGE_TYPE_COUNT];  // Serializes consumers of one type
+    std::atomic<uint64_t> dropped_messages_{0};
+    FieldMessageBatch tick_batch_;                // process_messages() scratch
     
     // Sub-systems
     WorkingContext working_context_;
@@ -228,20 +412,32 @@ private:
     std::mutex reflection_mutex_;
     
     // Continuous dynamics
-    void decay_activations(float dt);
-    void spread_activation(float dt);
+    void field_dynamics(float dt);
+    void decay_and_spread(float dt);   // Fused pass over out-edge rows
     void update_working_context(float dt);
     void process_messages();
+    bool enqueue_message(MessageType type, int source, int target, float energy, float confidence,
+                         std::chrono::high_resolution_clock::time_point timestamp,
+                         const float* data, size_t data_size);
+    void inject_energy_raw(int node_id, float energy, const float* embedding, size_t dim);
     
-    // Hopfield dynamics integration
+    // Hopfield dynamics integration (applies the spread first; in-edge rows)
     void hopfield_update(float dt);
     
+    // Dense slot for a node (created on first use); caller holds field_mutex_
+    uint32_t node_slot(int node_id);
+    
     // Coherence computation
     float compute_field_coherence() const;
     
     // Cross-modal binding strength
     float compute_binding_strength(int node_a, int node_b, float temporal_overlap);
     
+    // add_edge body; caller holds field_mutex_
+    void add_edge_locked(int from, int to, HybridEdge::Type type, float weight,
+                         const std::vector<float>& from_emb,
+                         const std::vector<float>& to_emb);
+    
     // Energy conservation
     std::atomic<float> total_energy_;
     float max_total_energy_ = 1000.0f;
@@ -0,0 +1,202 @@
+#include "field_message_queue.h"
+#include <algorithm>
+#include <cstdlib>
+#include <new>
+
+namespace melvin {
+namespace fields {
+
+namespace {
+
+constexpr uint64_t INDEX_MASK = 0xFFFFFFFFull;
+
+inline uint64_t make_head(uint64_t tag, uint32_t index_plus_one) {
+    return (tag << 32) | index_plus_one;
+}
+
+} // namespace
+
+// ============================================================================
+// SlabPool Implementation
+// ============================================================================
+
+SlabPool::SlabPool(size_t block_bytes, size_t blocks_per_slab)
+    : block_bytes_(block_bytes),
+      stride_((HEADER_BYTES + block_bytes + 15) & ~static_cast<size_t>(15)),
+      blocks_per_slab_(blocks_per_slab > 0 ? blocks_per_slab : 1) {
+    static_assert(sizeof(BlockHeader) <= HEADER_BYTES, "block header must fit its slot");
+    for (size_t i = 0; i < MAX_SLABS; ++i) {
+        slabs_[i].store(nullptr, std::memory_order_relaxed);
+    }
+}
+
+SlabPool::~SlabPool() {
+    size_t count = slab_count_.load(std::memory_order_acquire);
+    for (size_t i = 0; i < count; ++i) {
+        std::free(slabs_[i].load(std::memory_order_relaxed));
+    }
+}
+
+SlabPool::BlockHeader* SlabPool::header(uint32_t index) const {
+    uint8_t* slab = slabs_[index / blocks_per_slab_].load(std::memory_order_acquire);
+    return reinterpret_cast<BlockHeader*>(slab + (index % blocks_per_slab_) * stride_);
+}
+
+void* SlabPool::acquire() {
+    for (;;) {
+        uint64_t head = free_head_.load(std::memory_order_acquire);
+        uint32_t top = static_cast<uint32_t>(head & INDEX_MASK);
+        if (top == 0) {
+            if (!grow()) return nullptr;
+            continue;
+        }
+        BlockHeader* block = header(top - 1);
+        uint32_t next = block->next_free.load(std::memory_order_relaxed);
+        if (free_head_.compare_exchange_weak(head, make_head((head >> 32) + 1, next),
+                                             std::memory_order_acq_rel)) {
+            in_use_.fetch_add(1, std::memory_order_relaxed);
+            return reinterpret_cast<uint8_t*>(block) + HEADER_BYTES;
+        }
+    }
+}
+
+void SlabPool::release(void* ptr) {
+    if (!ptr) return;
+    BlockHeader* block = header_of(ptr);
+    push_chain(block->index + 1, block, 1);
+}
+
+SlabPool::BlockHeader* SlabPool::header_of(void* block) {
+    return reinterpret_cast<BlockHeader*>(static_cast<uint8_t*>(block) - HEADER_BYTES);
+}
+
+void SlabPool::push_chain(uint32_t first, BlockHeader* last, size_t count) {
+    uint64_t head = free_head_.load(std::memory_order_relaxed);
+    do {
+        last->next_free.store(static_cast<uint32_t>(head & INDEX_MASK), std::memory_order_relaxed);
+    } while (!free_head_.compare_exchange_weak(head, make_head((head >> 32) + 1, first),
+                                               std::memory_order_acq_rel));
+    in_use_.fetch_sub(count, std::memory_order_relaxed);
+}
+
+void SlabPool::link(Chain& chain, void* block) {
+    BlockHeader* h = header_of(block);
+    h->next_free.store(chain.first, std::memory_order_relaxed);
+    chain.first = h->index + 1;
+    if (!chain.last) chain.last = block;
+    chain.count++;
+}
+
+void SlabPool::release(Chain& chain) {
+    if (chain.count == 0) return;
+    push_chain(chain.first, header_of(chain.last), chain.count);
+    chain = Chain();
+}
+
+bool SlabPool::grow() {
+    std::lock_guard<std::mutex> lock(grow_mutex_);
+
+    // Another thread may have refilled the free list while we waited
+    if ((free_head_.load(std::memory_order_acquire) & INDEX_MASK) != 0) return true;
+
+    size_t slab_index = slab_count_.load(std::memory_order_relaxed);
+    if (slab_index >= MAX_SLABS ||
+        (slab_index + 1) * blocks_per_slab_ > static_cast<size_t>(UINT32_MAX - 1)) {
+        return false;
+    }
+
+    size_t bytes = stride_ * blocks_per_slab_;
+    uint8_t* slab = static_cast<uint8_t*>(std::aligned_alloc(64, (bytes + 63) & ~static_cast<size_t>(63)));
+    if (!slab) return false;
+
+    // Link the new blocks into a chain: first -> ... -> last
+    uint32_t first = static_cast<uint32_t>(slab_index * blocks_per_slab_);
+    for (size_t i = 0; i < blocks_per_slab_; ++i) {
+        auto* block = new (slab + i * stride_) BlockHeader;
+        block->index = first + static_cast<uint32_t>(i);
+        block->next_free.store(i + 1 < blocks_per_slab_ ? block->index + 2 : 0,
+                               std::memory_order_relaxed);
+    }
+    slabs_[slab_index].store(slab, std::memory_order_release);
+    slab_count_.store(slab_index + 1, std::memory_order_release);
+
+    // Splice the chain in front of whatever was released meanwhile
+    auto* last = reinterpret_cast<BlockHeader*>(slab + (blocks_per_slab_ - 1) * stride_);
+    in_use_.fetch_add(blocks_per_slab_, std::memory_order_relaxed);  // push_chain subtracts them
+    push_chain(first + 1, last, blocks_per_slab_);
+    return true;
+}
+
+// ============================================================================
+// MessagePool Implementation
+// ============================================================================
+
+MessagePool::MessagePool() {
+    for (size_t c = 0; c < NUM_CLASSES; ++c) {
+        size_t bytes = sizeof(MessageNode) + class_capacity(c) * sizeof(float);
+        // Aim for ~64 KB slabs
+        size_t blocks = std::max<size_t>(16, (64 * 1024) / bytes);
+        classes_[c].reset(new SlabPool(bytes, blocks));
+    }
+}
+
+MessageNode* MessagePool::acquire(size_t payload_size) {
+    size_t c = 0;
+    while (c < NUM_CLASSES && class_capacity(c) < payload_size) ++c;
+    
+    void* block;
+    if (c == NUM_CLASSES) {
+        size_t bytes = sizeof(MessageNode) + payload_size * sizeof(float);
+        block = std::aligned_alloc(16, (bytes + 15) & ~static_cast<size_t>(15));
+    } else {
+        block = classes_[c]->acquire();
+    }
+    if (!block) return nullptr;
+    
+    MessageNode* node = new (block) MessageNode;
+    node->size_class = c == NUM_CLASSES ? HEAP_CLASS : static_cast<uint8_t>(c);
+    node->payload_size = static_cast<uint32_t>(payload_size);
+    return node;
+}
+
+void MessagePool::release(MessageNode* node) {
+    if (!node) return;
+    uint8_t c = node->size_class;
+    node->~MessageNode();
+    if (c == HEAP_CLASS) {
+        std::free(node);
+    } else {
+        classes_[c]->release(node);
+    }
+}
+
+void MessagePool::ReleaseBatch::add(MessageNode* node) {
+    uint8_t c = node->size_class;
+    if (c == HEAP_CLASS) {
+        pool_.release(node);
+        return;
+    }
+    node->~MessageNode();
+    pool_.classes_[c]->link(chains_[c], node);
+}
+
+void MessagePool::ReleaseBatch::flush() {
+    for (size_t c = 0; c < NUM_CLASSES; ++c) {
+        pool_.classes_[c]->release(chains_[c]);
+    }
+}
+
+size_t MessagePool::slab_count() const {
+    size_t total = 0;
+    for (const auto& pool : classes_) total += pool->slab_count();
+    return total;
+}
+
+size_t MessagePool::messages_in_use() const {
+    size_t total = 0;
+    for (const auto& pool : classes_) total += pool->blocks_in_use();
+    return total;
+}
+
+} // namespace fields
+} // namespace melvin
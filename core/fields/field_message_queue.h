@@ -0,0 +1,209 @@
+#ifndef FIELD_MESSAGE_QUEUE_H
+#define FIELD_MESSAGE_QUEUE_H
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace melvin {
+namespace fields {
+
+/**
+ * @brief Fixed-size block allocator carved from slabs that are never freed
+ *
+ * Free blocks form a lock-free stack of 32-bit block indices; the head
+ * carries a 32-bit tag so a block recycled between a reader's load and
+ * CAS cannot be mistaken for the one it saw (ABA). Only growing by a new
+ * slab takes a mutex. Blocks are 16-byte aligned.
+ */
+class SlabPool {
+public:
+    explicit SlabPool(size_t block_bytes, size_t blocks_per_slab = 256);
+    ~SlabPool();
+
+    SlabPool(const SlabPool&) = delete;
+    SlabPool& operator=(const SlabPool&) = delete;
+
+    // nullptr once MAX_SLABS slabs are in use
+    void* acquire();
+    void release(void* block);
+
+    /**
+     * @brief Blocks linked locally, released together with a single CAS
+     */
+    struct Chain {
+        uint32_t first = 0;  // index + 1, 0 = empty
+        void* last = nullptr;
+        size_t count = 0;
+    };
+    void link(Chain& chain, void* block);
+    void release(Chain& chain);
+
+    size_t block_bytes() const { return block_bytes_; }
+    size_t slab_count() const { return slab_count_.load(std::memory_order_relaxed); }
+    size_t blocks_in_use() const { return in_use_.load(std::memory_order_relaxed); }
+
+    static constexpr size_t MAX_SLABS = 4096;
+
+private:
+    struct BlockHeader {
+        uint32_t index;
+        std::atomic<uint32_t> next_free;  // index + 1 of the next free block, 0 = none
+    };
+    static constexpr size_t HEADER_BYTES = 16;
+
+    size_t block_bytes_;
+    size_t stride_;
+    size_t blocks_per_slab_;
+    std::atomic<uint8_t*> slabs_[MAX_SLABS];
+    std::atomic<size_t> slab_count_{0};
+    std::atomic<uint64_t> free_head_{0};  // (tag << 32) | (index + 1)
+    std::atomic<size_t> in_use_{0};
+    std::mutex grow_mutex_;
+
+    BlockHeader* header(uint32_t index) const;
+    static BlockHeader* header_of(void* block);
+    void push_chain(uint32_t first, BlockHeader* last, size_t count);
+    bool grow();
+};
+
+/**
+ * @brief One queued message; its payload floats follow it in the same block
+ */
+struct alignas(16) MessageNode {
+    std::atomic<MessageNode*> next{nullptr};
+    int source_node_id = 0;
+    int target_node_id = 0;
+    float energy = 0.0f;
+    float confidence = 1.0f;
+    std::chrono::high_resolution_clock::time_point timestamp;
+    uint32_t payload_size = 0;
+    uint8_t size_class = 0;
+
+    float* payload() { return reinterpret_cast<float*>(this + 1); }
+    const float* payload() const { return reinterpret_cast<const float*>(this + 1); }
+};
+
+/**
+ * @brief Recycled message blocks in power-of-two payload size classes
+ *
+ * Class 0 carries no payload, class c >= 1 up to 8 << c floats
+ * (16 .. 4096). One acquire per message covers node and payload; larger
+ * payloads fall back to the heap.
+ */
+class MessagePool {
+public:
+    static constexpr size_t NUM_CLASSES = 10;
+    static constexpr uint8_t HEAP_CLASS = 0xFF;
+
+    MessagePool();
+
+    // Constructed node with payload room for payload_size floats (nullptr when exhausted)
+    MessageNode* acquire(size_t payload_size);
+    void release(MessageNode* node);
+
+    /**
+     * @brief Deferred release: collect nodes, then return them with one CAS per class
+     */
+    class ReleaseBatch {
+    public:
+        explicit ReleaseBatch(MessagePool& pool) : pool_(pool) {}
+        ~ReleaseBatch() { flush(); }
+        void add(MessageNode* node);
+        void flush();
+    private:
+        MessagePool& pool_;
+        SlabPool::Chain chains_[NUM_CLASSES];
+    };
+
+    size_t slab_count() const;
+    size_t messages_in_use() const;
+
+    static size_t class_capacity(size_t size_class) {
+        return size_class == 0 ? 0 : size_t(8) << size_class;
+    }
+
+private:
+    std::unique_ptr<SlabPool> classes_[NUM_CLASSES];
+};
+
+/**
+ * @brief Unbounded intrusive MPSC queue (Vyukov)
+ *
+ * push() is wait-free (one exchange) from any thread; pop() must only be
+ * called by one consumer at a time.
+ */
+class MPSCMessageQueue {
+public:
+    MPSCMessageQueue() : head_(&stub_), tail_(&stub_) {}
+
+    MPSCMessageQueue(const MPSCMessageQueue&) = delete;
+    MPSCMessageQueue& operator=(const MPSCMessageQueue&) = delete;
+
+    void push(MessageNode* node) {
+        node->next.store(nullptr, std::memory_order_relaxed);
+        MessageNode* prev = head_.exchange(node, std::memory_order_acq_rel);
+        prev->next.store(node, std::memory_order_release);
+        enqueued_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Oldest node, or nullptr when empty (or a producer is mid-push)
+     */
+    MessageNode* pop() {
+        MessageNode* tail = tail_;
+        MessageNode* next = tail->next.load(std::memory_order_acquire);
+        if (tail == &stub_) {
+            if (!next) return nullptr;
+            tail_ = next;
+            tail = next;
+            next = next->next.load(std::memory_order_acquire);
+        }
+        if (next) {
+            tail_ = next;
+            note_dequeued();
+            return tail;
+        }
+        if (tail != head_.load(std::memory_order_acquire)) return nullptr;
+        push_stub();
+        next = tail->next.load(std::memory_order_acquire);
+        if (next) {
+            tail_ = next;
+            note_dequeued();
+            return tail;
+        }
+        return nullptr;
+    }
+
+    size_t size_approx() const {
+        uint64_t in = enqueued_.load(std::memory_order_relaxed);
+        uint64_t out = dequeued_.load(std::memory_order_relaxed);
+        return in > out ? static_cast<size_t>(in - out) : 0;
+    }
+
+private:
+    alignas(64) std::atomic<MessageNode*> head_;  // Producers
+    std::atomic<uint64_t> enqueued_{0};
+    alignas(64) MessageNode* tail_;               // Consumer
+    std::atomic<uint64_t> dequeued_{0};           // Single writer: no RMW
+    MessageNode stub_;
+
+    void note_dequeued() {
+        dequeued_.store(dequeued_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+
+    void push_stub() {
+        stub_.next.store(nullptr, std::memory_order_relaxed);
+        MessageNode* prev = head_.exchange(&stub_, std::memory_order_acq_rel);
+        prev->next.store(&stub_, std::memory_order_release);
+    }
+};
+
+} // namespace fields
+} // namespace melvin
+
+#endif // FIELD_MESSAGE_QUEUE_H
@@ -1,4 +1,6 @@
 #include "parallel_graph_traversal.h"
+#include "core/metrics/latency_histogram.h"
+#include "core/metrics/trace.h"
 #include <algorithm>
 #include <cmath>
 #include <iostream>
@@ -34,6 +36,9 @@ std::vector<ActivatedNode> ParallelGraphTraversal::spread_activation(
     float decay_per_step,
     size_t max_nodes_to_activate) {
     
+    static auto& spread_latency = metrics::latency_metric("traversal.spread");
+    metrics::ScopedLatency timer(spread_latency);
+    MELVIN_TRACE_SCOPE("traversal.spread");
     auto start_time = std::chrono::high_resolution_clock::now();
     
     // Global activation map (thread-safe)
@@ -59,7 +64,10 @@ std::vector<ActivatedNode> ParallelGraphTraversal::spread_activation(
     float current_threshold = compute_adaptive_threshold(total_nodes_activated);
     
     // Spread until energy dissipates (NO hop limit) OR convergence detected
+    int level = 0;
     while (!current_frontier.empty() && total_nodes_activated < max_nodes_to_activate) {
+        MELVIN_TRACE_SCOPE_ARG("traversal.level", "level", level);
+        level++;
         
         // v3.1: Check for early convergence
         if (stability_metrics_.converged) {
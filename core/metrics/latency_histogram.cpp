@@ -0,0 +1,230 @@
+/**
+ * @file latency_histogram.cpp
+ * @brief Implementation of HDR-style latency histograms
+ */
+
+#include "latency_histogram.h"
+#include <sstream>
+#include <iomanip>
+#include <algorithm>
+
+namespace melvin {
+namespace metrics {
+
+// ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
+// HISTOGRAM
+// ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
+
+void Histogram::add_totals(uint64_t count, uint64_t sum, uint64_t max) {
+    count_ += count;
+    sum_ += sum;
+    max_ = std::max(max_, max);
+}
+
+void Histogram::merge(const Histogram& other) {
+    for (int i = 0; i < BUCKET_COUNT; i++) {
+        counts_[i] += other.counts_[i];
+    }
+    add_totals(other.count_, other.sum_, other.max_);
+}
+
+uint64_t Histogram::value_at(double q) const {
+    if (count_ == 0) return 0;
+
+    // Bucket totals may run slightly ahead of count_ while shards are
+    // being written, so the walk is bounded by the bucket sum
+    uint64_t total = 0;
+    for (uint64_t c : counts_) total += c;
+    if (total == 0) return 0;
+
+    uint64_t rank = static_cast<uint64_t>(std::max(0.0, std::min(1.0, q)) * (total - 1)) + 1;
+    uint64_t seen = 0;
+    for (int i = 0; i < BUCKET_COUNT; i++) {
+        seen += counts_[i];
+        if (seen >= rank) {
+            uint64_t lower = bucket_lower(i);
+            return std::min(lower + (bucket_upper(i) - lower) / 2, max_);
+        }
+    }
+    return max_;
+}
+
+// ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
+// PER-THREAD RECORDERS
+// ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
+
+struct LatencyMetric::Shard {
+    // Single writer (the owning thread): relaxed load + store, no RMW
+    std::atomic<uint64_t> counts[Histogram::BUCKET_COUNT];
+    std::atomic<uint64_t> count{0};
+    std::atomic<uint64_t> sum{0};
+    std::atomic<uint64_t> max{0};
+
+    Shard() { reset(); }
+
+    void reset() {
+        for (auto& c : counts) c.store(0, std::memory_order_relaxed);
+        count.store(0, std::memory_order_relaxed);
+        sum.store(0, std::memory_order_relaxed);
+        max.store(0, std::memory_order_relaxed);
+    }
+
+    void fold_into(Histogram& h) const {
+        uint64_t n = count.load(std::memory_order_acquire);
+        for (int i = 0; i < Histogram::BUCKET_COUNT; i++) {
+            uint64_t c = counts[i].load(std::memory_order_relaxed);
+            if (c) h.add_bucket(i, c);
+        }
+        h.add_totals(n, sum.load(std::memory_order_relaxed), max.load(std::memory_order_relaxed));
+    }
+
+    static void bump(std::atomic<uint64_t>& a, uint64_t n) {
+        a.store(a.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+    }
+};
+
+LatencyMetric::LatencyMetric(const std::string& name, size_t id)
+    : name_(name), id_(id) {}
+
+LatencyMetric::~LatencyMetric() = default;
+
+// A thread's shards, indexed by metric id. Shards are owned by their
+// metric; on thread exit each is handed back to it (metrics are never
+// destroyed while threads record, see LatencyRegistry)
+struct LatencyMetric::ThreadShards {
+    std::vector<std::pair<LatencyMetric*, Shard*>> by_id;
+
+    ~ThreadShards() {
+        for (auto& [metric, shard] : by_id) {
+            if (shard) metric->retire(shard);
+        }
+    }
+};
+
+LatencyMetric::Shard* LatencyMetric::local_shard() {
+    thread_local ThreadShards local;
+    if (id_ < local.by_id.size() && local.by_id[id_].second) {
+        return local.by_id[id_].second;
+    }
+
+    Shard* raw;
+    {
+        std::lock_guard<std::mutex> lock(shards_mutex_);
+        if (free_shards_.empty()) {
+            shards_.push_back(std::make_unique<Shard>());
+        } else {
+            shards_.push_back(std::move(free_shards_.back()));
+            free_shards_.pop_back();
+        }
+        raw = shards_.back().get();
+    }
+    if (id_ >= local.by_id.size()) local.by_id.resize(id_ + 1, {nullptr, nullptr});
+    local.by_id[id_] = {this, raw};
+    return raw;
+}
+
+void LatencyMetric::retire(Shard* shard) {
+    // Runs on the owning thread, so the shard has no writer left
+    std::lock_guard<std::mutex> lock(shards_mutex_);
+    auto it = std::find_if(shards_.begin(), shards_.end(),
+                           [shard](const std::unique_ptr<Shard>& s) { return s.get() == shard; });
+    if (it == shards_.end()) return;
+    shard->fold_into(retired_);
+    shard->reset();
+    free_shards_.push_back(std::move(*it));
+    *it = std::move(shards_.back());
+    shards_.pop_back();
+}
+
+void LatencyMetric::record_ns(uint64_t ns) {
+    Shard* shard = local_shard();
+    Shard::bump(shard->counts[Histogram::bucket_index(ns)], 1);
+    Shard::bump(shard->sum, ns);
+    if (ns > shard->max.load(std::memory_order_relaxed)) {
+        shard->max.store(ns, std::memory_order_relaxed);
+    }
+    // Count last: a reader never sees more samples than bucket entries
+    shard->count.store(shard->count.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+}
+
+Histogram LatencyMetric::merged() const {
+    std::lock_guard<std::mutex> lock(shards_mutex_);
+    Histogram result = retired_;
+    for (const auto& shard : shards_) {
+        shard->fold_into(result);
+    }
+    return result;
+}
+
+LatencySummary LatencyMetric::summary() const {
+    Histogram h = merged();
+    LatencySummary s;
+    s.name = name_;
+    s.count = h.count();
+    s.mean_ms = h.mean() / 1e6;
+    s.p50_ms = h.value_at(0.50) / 1e6;
+    s.p90_ms = h.value_at(0.90) / 1e6;
+    s.p99_ms = h.value_at(0.99) / 1e6;
+    s.p999_ms = h.value_at(0.999) / 1e6;
+    s.max_ms = h.max() / 1e6;
+    return s;
+}
+
+// ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
+// REGISTRY
+// ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
+
+LatencyRegistry& LatencyRegistry::instance() {
+    // Intentionally leaked: metrics may be recorded from threads that
+    // outlive static destruction
+    static LatencyRegistry* registry = new LatencyRegistry();
+    return *registry;
+}
+
+LatencyMetric& LatencyRegistry::get(const std::string& name) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = metrics_.find(name);
+    if (it != metrics_.end()) {
+        return *it->second;
+    }
+    auto metric = std::make_unique<LatencyMetric>(name, metrics_.size());
+    LatencyMetric& ref = *metric;
+    metrics_.emplace(name, std::move(metric));
+    return ref;
+}
+
+std::vector<LatencySummary> LatencyRegistry::snapshot() const {
+    std::vector<const LatencyMetric*> metrics;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (const auto& [name, metric] : metrics_) {
+            metrics.push_back(metric.get());
+        }
+    }
+
+    std::vector<LatencySummary> result;
+    for (const auto* metric : metrics) {
+        LatencySummary s = metric->summary();
+        if (s.count > 0) result.push_back(s);
+    }
+    return result;
+}
+
+std::string to_json(const LatencySummary& s, double timestamp) {
+    std::ostringstream oss;
+    oss << std::fixed << std::setprecision(6);
+    oss << "{\"t\":" << timestamp
+        << ",\"name\":\"" << s.name << "\""
+        << ",\"count\":" << s.count
+        << ",\"mean_ms\":" << s.mean_ms
+        << ",\"p50_ms\":" << s.p50_ms
+        << ",\"p90_ms\":" << s.p90_ms
+        << ",\"p99_ms\":" << s.p99_ms
+        << ",\"p999_ms\":" << s.p999_ms
+        << ",\"max_ms\":" << s.max_ms
+        << "}";
+    return oss.str();
+}
+
+} // namespace metrics
+} // namespace melvin
@@ -0,0 +1,208 @@
+/**
+ * @file latency_histogram.h
+ * @brief Low-overhead HDR-style latency histograms
+ *
+ * Log-linear buckets (32 linear sub-buckets per power of two, reported
+ * at their midpoint: < 1.6% relative error) over nanosecond values. Each thread records into its
+ * own shard with plain relaxed stores; shards are merged only when a
+ * summary is read, so recording never contends. When a thread exits its
+ * shards are folded into each metric's retired totals and recycled.
+ *
+ * Usage:
+ *   static auto& spread = metrics::latency_metric("reason.spread");
+ *   { metrics::ScopedLatency timer(spread); ... }
+ *   auto summary = spread.summary();  // p50/p90/p99/p999 in ms
+ */
+
+#ifndef MELVIN_LATENCY_HISTOGRAM_H
+#define MELVIN_LATENCY_HISTOGRAM_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace melvin {
+namespace metrics {
+
+/**
+ * @brief Percentile summary of one latency metric (milliseconds)
+ */
+struct LatencySummary {
+    std::string name;
+    uint64_t count = 0;
+    double mean_ms = 0.0;
+    double p50_ms = 0.0;
+    double p90_ms = 0.0;
+    double p99_ms = 0.0;
+    double p999_ms = 0.0;
+    double max_ms = 0.0;
+};
+
+/**
+ * @brief Single-threaded log-linear histogram (the merged view)
+ */
+class Histogram {
+public:
+    // Values below SUB_BUCKETS are exact; each octave above is split into
+    // HALF_SUB_BUCKETS linear buckets
+    static constexpr int SUB_BUCKET_BITS = 6;
+    static constexpr int SUB_BUCKETS = 1 << SUB_BUCKET_BITS;
+    static constexpr int HALF_SUB_BUCKETS = SUB_BUCKETS / 2;
+    static constexpr int BUCKET_COUNT = (64 - SUB_BUCKET_BITS) * HALF_SUB_BUCKETS + SUB_BUCKETS;
+
+    Histogram() : counts_(BUCKET_COUNT, 0) {}
+
+    static int bucket_index(uint64_t value) {
+        if (value < static_cast<uint64_t>(SUB_BUCKETS)) return static_cast<int>(value);
+        int msb = 63 - __builtin_clzll(value);
+        int shift = msb - SUB_BUCKET_BITS + 1;
+        return shift * HALF_SUB_BUCKETS + static_cast<int>(value >> shift);
+    }
+
+    /**
+     * @brief Smallest and largest value that map to a bucket
+     */
+    static uint64_t bucket_lower(int index) {
+        if (index < SUB_BUCKETS) return static_cast<uint64_t>(index);
+        int shift = index / HALF_SUB_BUCKETS - 1;
+        uint64_t sub = static_cast<uint64_t>(index - shift * HALF_SUB_BUCKETS);
+        return sub << shift;
+    }
+    static uint64_t bucket_upper(int index) {
+        if (index < SUB_BUCKETS) return static_cast<uint64_t>(index);
+        int shift = index / HALF_SUB_BUCKETS - 1;
+        return bucket_lower(index) + ((uint64_t(1) << shift) - 1);
+    }
+
+    void record(uint64_t value) {
+        counts_[bucket_index(value)]++;
+        count_++;
+        sum_ += value;
+        if (value > max_) max_ = value;
+    }
+
+    void add_bucket(int index, uint64_t n) { counts_[index] += n; }
+    void add_totals(uint64_t count, uint64_t sum, uint64_t max);
+
+    void merge(const Histogram& other);
+
+    /**
+     * @brief Value at quantile q (0-1), reported as the bucket's midpoint
+     */
+    uint64_t value_at(double q) const;
+
+    uint64_t count() const { return count_; }
+    uint64_t max() const { return max_; }
+    double mean() const { return count_ ? static_cast<double>(sum_) / count_ : 0.0; }
+
+private:
+    std::vector<uint64_t> counts_;
+    uint64_t count_ = 0;
+    uint64_t sum_ = 0;
+    uint64_t max_ = 0;
+};
+
+/**
+ * @brief Named latency metric with per-thread recorders
+ */
+class LatencyMetric {
+public:
+    LatencyMetric(const std::string& name, size_t id);
+    ~LatencyMetric();
+
+    LatencyMetric(const LatencyMetric&) = delete;
+    LatencyMetric& operator=(const LatencyMetric&) = delete;
+
+    /**
+     * @brief Record one sample (wait-free, thread-local shard)
+     */
+    void record_ns(uint64_t ns);
+    void record_ms(double ms) { record_ns(ms > 0.0 ? static_cast<uint64_t>(ms * 1e6) : 0); }
+
+    /**
+     * @brief Merge all shards (safe while other threads record)
+     */
+    Histogram merged() const;
+    LatencySummary summary() const;
+
+    const std::string& name() const { return name_; }
+
+private:
+    struct Shard;
+    struct ThreadShards;
+
+    std::string name_;
+    size_t id_;
+    mutable std::mutex shards_mutex_;
+    std::vector<std::unique_ptr<Shard>> shards_;       // Owned by live threads
+    std::vector<std::unique_ptr<Shard>> free_shards_;  // Zeroed, for reuse
+    Histogram retired_;                                // Exited threads' samples
+
+    Shard* local_shard();
+    void retire(Shard* shard);
+};
+
+/**
+ * @brief Process-wide set of latency metrics
+ *
+ * Metrics are created on first use and live for the whole process, so
+ * references to them may be cached in function-local statics.
+ */
+class LatencyRegistry {
+public:
+    static LatencyRegistry& instance();
+
+    LatencyMetric& get(const std::string& name);
+
+    /**
+     * @brief Summaries of every metric with at least one sample, by name
+     */
+    std::vector<LatencySummary> snapshot() const;
+
+private:
+    LatencyRegistry() = default;
+
+    mutable std::mutex mutex_;
+    std::map<std::string, std::unique_ptr<LatencyMetric>> metrics_;
+};
+
+inline LatencyMetric& latency_metric(const std::string& name) {
+    return LatencyRegistry::instance().get(name);
+}
+
+/**
+ * @brief Records the lifetime of the scope into a metric
+ */
+class ScopedLatency {
+public:
+    explicit ScopedLatency(LatencyMetric& metric)
+        : metric_(metric), start_(std::chrono::steady_clock::now()) {}
+
+    ~ScopedLatency() {
+        auto elapsed = std::chrono::steady_clock::now() - start_;
+        metric_.record_ns(static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()));
+    }
+
+    ScopedLatency(const ScopedLatency&) = delete;
+    ScopedLatency& operator=(const ScopedLatency&) = delete;
+
+private:
+    LatencyMetric& metric_;
+    std::chrono::steady_clock::time_point start_;
+};
+
+/**
+ * @brief One-line JSON for a summary (used by the KPI dump)
+ */
+std::string to_json(const LatencySummary& summary, double timestamp);
+
+} // namespace metrics
+} // namespace melvin
+
+#endif // MELVIN_LATENCY_HISTOGRAM_H
@@ -0,0 +1,186 @@
+/**
+ * @file trace.cpp
+ * @brief Implementation of span tracing and Chrome trace-event export
+ */
+
+#include "trace.h"
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <unordered_set>
+#include <vector>
+
+namespace melvin {
+namespace trace {
+
+namespace {
+
+/**
+ * @brief Per-thread span buffer
+ *
+ * Shared with the global list so spans from exited threads can still be
+ * written. The mutex is only contended while start() or the writer runs.
+ */
+struct ThreadBuffer {
+    uint32_t tid = 0;
+    std::string thread_name;
+    std::mutex mutex;
+    std::vector<TraceEvent> events;
+};
+
+struct TraceState {
+    std::mutex mutex;
+    std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+    std::unordered_set<std::string> names;
+    std::atomic<uint64_t> dropped{0};
+    uint32_t next_tid = 1;
+    std::chrono::steady_clock::time_point epoch = std::chrono::steady_clock::now();
+};
+
+TraceState& state() {
+    // Intentionally leaked: spans may close on threads that outlive
+    // static destruction
+    static TraceState* s = new TraceState();
+    return *s;
+}
+
+ThreadBuffer& local_buffer() {
+    thread_local std::shared_ptr<ThreadBuffer> buffer;
+    if (!buffer) {
+        buffer = std::make_shared<ThreadBuffer>();
+        TraceState& s = state();
+        std::lock_guard<std::mutex> lock(s.mutex);
+        buffer->tid = s.next_tid++;
+        s.buffers.push_back(buffer);
+    }
+    return *buffer;
+}
+
+void write_escaped(std::ostream& out, const char* text) {
+    out << '"';
+    for (const char* p = text; *p; p++) {
+        char c = *p;
+        if (c == '"' || c == '\\') {
+            out << '\\' << c;
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            out << ' ';
+        } else {
+            out << c;
+        }
+    }
+    out << '"';
+}
+
+} // namespace
+
+// ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
+// RECORDING
+// ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
+
+void start() {
+    TraceState& s = state();
+    {
+        std::lock_guard<std::mutex> lock(s.mutex);
+        for (auto& buffer : s.buffers) {
+            std::lock_guard<std::mutex> buffer_lock(buffer->mutex);
+            buffer->events.clear();
+        }
+        s.dropped.store(0, std::memory_order_relaxed);
+    }
+    enabled_flag().store(true, std::memory_order_release);
+}
+
+void stop() {
+    enabled_flag().store(false, std::memory_order_release);
+}
+
+uint64_t now_ns() {
+    auto elapsed = std::chrono::steady_clock::now() - state().epoch;
+    return static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+}
+
+void record(const char* name, uint64_t start_ns, uint64_t end_ns,
+            const char* arg_name, int64_t arg_value) {
+    ThreadBuffer& buffer = local_buffer();
+    std::lock_guard<std::mutex> lock(buffer.mutex);
+    if (buffer.events.size() >= MAX_EVENTS_PER_THREAD) {
+        state().dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    buffer.events.push_back({name, arg_name, arg_value, start_ns,
+                             end_ns > start_ns ? end_ns - start_ns : 0});
+}
+
+void set_thread_name(const char* name) {
+    ThreadBuffer& buffer = local_buffer();
+    std::lock_guard<std::mutex> lock(buffer.mutex);
+    buffer.thread_name = name;
+}
+
+const char* intern(const std::string& name) {
+    TraceState& s = state();
+    std::lock_guard<std::mutex> lock(s.mutex);
+    return s.names.insert(name).first->c_str();
+}
+
+uint64_t dropped_events() {
+    return state().dropped.load(std::memory_order_relaxed);
+}
+
+// ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
+// CHROME TRACE EXPORT
+// ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
+
+bool write_chrome_json(const std::string& filepath) {
+    std::ofstream out(filepath);
+    if (!out.is_open()) {
+        return false;
+    }
+
+    std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+    {
+        std::lock_guard<std::mutex> lock(state().mutex);
+        buffers = state().buffers;
+    }
+
+    out << std::fixed << std::setprecision(3);
+    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    bool first = true;
+
+    for (const auto& buffer : buffers) {
+        std::lock_guard<std::mutex> lock(buffer->mutex);
+
+        if (!buffer->thread_name.empty()) {
+            out << (first ? "" : ",\n")
+                << "{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":1,\"tid\":" << buffer->tid
+                << ",\"args\":{\"name\":";
+            write_escaped(out, buffer->thread_name.c_str());
+            out << "}}";
+            first = false;
+        }
+
+        // Complete events; timestamps in microseconds
+        for (const auto& e : buffer->events) {
+            out << (first ? "" : ",\n") << "{\"ph\":\"X\",\"name\":";
+            write_escaped(out, e.name);
+            out << ",\"pid\":1,\"tid\":" << buffer->tid
+                << ",\"ts\":" << e.start_ns / 1e3
+                << ",\"dur\":" << e.duration_ns / 1e3;
+            if (e.arg_name) {
+                out << ",\"args\":{";
+                write_escaped(out, e.arg_name);
+                out << ":" << e.arg_value << "}";
+            }
+            out << "}";
+            first = false;
+        }
+    }
+
+    out << "\n]}\n";
+    return out.good();
+}
+
+} // namespace trace
+} // namespace melvin
@@ -0,0 +1,138 @@
+/**
+ * @file trace.h
+ * @brief Compile-time switchable span tracing (Chrome trace-event export)
+ *
+ * Build with TRACE=1 (defines MELVIN_TRACING=1) to compile the span
+ * macros in; otherwise they expand to nothing. Even when compiled in,
+ * spans are only recorded between trace::start() and trace::stop(), so
+ * an idle build pays one relaxed load per span.
+ *
+ * Each thread records into its own buffer; write_chrome_json() merges
+ * them into a file that chrome://tracing and ui.perfetto.dev both open.
+ *
+ * Usage:
+ *   MELVIN_TRACE_THREAD_NAME("vision_capture");
+ *   { MELVIN_TRACE_SCOPE("vision.capture"); ... }
+ *   { MELVIN_TRACE_SCOPE_ARG("traversal.level", "depth", depth); ... }
+ *
+ * Span names must have static lifetime; use trace::intern() for names
+ * built at runtime.
+ */
+
+#ifndef MELVIN_TRACE_H
+#define MELVIN_TRACE_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+namespace melvin {
+namespace trace {
+
+/**
+ * @brief One completed span
+ */
+struct TraceEvent {
+    const char* name;
+    const char* arg_name;   // nullptr if no argument
+    int64_t arg_value;
+    uint64_t start_ns;      // Relative to the trace epoch
+    uint64_t duration_ns;
+};
+
+constexpr size_t MAX_EVENTS_PER_THREAD = 1 << 18;
+
+/**
+ * @brief Begin recording spans (clears anything already buffered)
+ */
+void start();
+
+/**
+ * @brief Stop recording; buffered spans are kept until the next start()
+ */
+void stop();
+
+inline std::atomic<bool>& enabled_flag() {
+    static std::atomic<bool> flag{false};
+    return flag;
+}
+
+inline bool enabled() {
+    return enabled_flag().load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Nanoseconds since the trace epoch (steady clock)
+ */
+uint64_t now_ns();
+
+/**
+ * @brief Append a span to the calling thread's buffer
+ */
+void record(const char* name, uint64_t start_ns, uint64_t end_ns,
+            const char* arg_name = nullptr, int64_t arg_value = 0);
+
+/**
+ * @brief Label the calling thread in the trace viewer
+ */
+void set_thread_name(const char* name);
+
+/**
+ * @brief Stable pointer for a name built at runtime (never freed)
+ */
+const char* intern(const std::string& name);
+
+/**
+ * @brief Write all buffered spans as Chrome trace-event JSON
+ */
+bool write_chrome_json(const std::string& filepath);
+
+/**
+ * @brief Spans discarded because a thread buffer was full
+ */
+uint64_t dropped_events();
+
+/**
+ * @brief Records the lifetime of the scope as one span
+ */
+class ScopedSpan {
+public:
+    explicit ScopedSpan(const char* name, const char* arg_name = nullptr, int64_t arg_value = 0)
+        : name_(enabled() ? name : nullptr), arg_name_(arg_name), arg_value_(arg_value),
+          start_ns_(name_ ? now_ns() : 0) {}
+
+    ~ScopedSpan() {
+        if (name_) record(name_, start_ns_, now_ns(), arg_name_, arg_value_);
+    }
+
+    ScopedSpan(const ScopedSpan&) = delete;
+    ScopedSpan& operator=(const ScopedSpan&) = delete;
+
+private:
+    const char* name_;
+    const char* arg_name_;
+    int64_t arg_value_;
+    uint64_t start_ns_;
+};
+
+} // namespace trace
+} // namespace melvin
+
+#define MELVIN_TRACE_CONCAT_(a, b) a##b
+#define MELVIN_TRACE_CONCAT(a, b) MELVIN_TRACE_CONCAT_(a, b)
+
+#if defined(MELVIN_TRACING) && MELVIN_TRACING
+#define MELVIN_TRACE_SCOPE(name) \
+    ::melvin::trace::ScopedSpan MELVIN_TRACE_CONCAT(melvin_trace_span_, __LINE__)(name)
+#define MELVIN_TRACE_SCOPE_ARG(name, arg_name, arg_value) \
+    ::melvin::trace::ScopedSpan MELVIN_TRACE_CONCAT(melvin_trace_span_, __LINE__)( \
+        name, arg_name, static_cast<int64_t>(arg_value))
+#define MELVIN_TRACE_THREAD_NAME(name) ::melvin::trace::set_thread_name(name)
+#else
+#define MELVIN_TRACE_SCOPE(name) ((void)0)
+#define MELVIN_TRACE_SCOPE_ARG(name, arg_name, arg_value) ((void)0)
+#define MELVIN_TRACE_THREAD_NAME(name) ((void)0)
+#endif
+
+#endif // MELVIN_TRACE_H
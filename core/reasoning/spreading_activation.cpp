@@ -1,4 +1,6 @@
 #include "spreading_activation.h"
+#include "core/metrics/latency_histogram.h"
+#include "core/metrics/trace.h"
 #include <iostream>
 #include <algorithm>
 #include <cmath>
@@ -96,6 +98,7 @@ void ActivationField::stop_background_loop() {
 
 void ActivationField::background_loop() {
     using namespace std::chrono;
+    MELVIN_TRACE_THREAD_NAME("activation_field");
     
     while (running_.load()) {
         auto start = high_resolution_clock::now();
@@ -117,6 +120,9 @@ void ActivationField::background_loop() {
 }
 
 void ActivationField::tick(const std::unordered_map<int, std::vector<std::pair<int, float>>>& graph) {
+    static auto& tick_latency = metrics::latency_metric("field.tick");
+    metrics::ScopedLatency timer(tick_latency);
+    MELVIN_TRACE_SCOPE("field.tick");
     std::lock_guard<std::mutex> lock(activation_mutex_);
     
     // Store graph reference for background loop
@@ -5,6 +5,8 @@
 
 #include "unified_intelligence.h"
 #include "reasoning/answer_synthesizer.h"
+#include "core/metrics/latency_histogram.h"
+#include "core/metrics/trace.h"
 #include <queue>
 #include <set>
 #include <algorithm>
@@ -15,6 +17,25 @@
 namespace melvin {
 namespace intelligence {
 
+namespace {
+
+// Per-stage latency histograms for reason()
+struct ReasonLatency {
+    metrics::LatencyMetric& total = metrics::latency_metric("reason.total");
+    metrics::LatencyMetric& tokenize = metrics::latency_metric("reason.tokenize");
+    metrics::LatencyMetric& seed = metrics::latency_metric("reason.seed");
+    metrics::LatencyMetric& spread = metrics::latency_metric("reason.spread");
+    metrics::LatencyMetric& score = metrics::latency_metric("reason.score");
+    metrics::LatencyMetric& synthesize = metrics::latency_metric("reason.synthesize");
+};
+
+ReasonLatency& reason_latency() {
+    static ReasonLatency latency;
+    return latency;
+}
+
+} // namespace
+
 UnifiedIntelligence::UnifiedIntelligence() :
     current_mode_(metacognition::ReasoningMode::EXPLORATORY)
 {
@@ -46,32 +67,51 @@ void UnifiedIntelligence::initialize(
 }
 
 UnifiedResult UnifiedIntelligence::reason(const std::string& query) {
+    return reason(query, Clock::time_point::max());
+}
+
+UnifiedResult UnifiedIntelligence::reason(const std::string& query, Clock::time_point deadline) {
     UnifiedResult result;
+    auto& latency = reason_latency();
+    metrics::ScopedLatency total_timer(latency.total);
+    MELVIN_TRACE_SCOPE("reason");
     
     // ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
     // STAGE 1: UNDERSTAND QUERY (Genome-driven)
     // ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
     
-    // Tokenize and filter stop words
-    std::vector<std::string> tokens = tokenize_and_filter(query);
-    if (tokens.empty()) {
-        result.answer = "I didn't understand the question.";
-        return result;
+    std::vector<std::string> tokens;
+    std::vector<float> query_embedding;
+    {
+        metrics::ScopedLatency timer(latency.tokenize);
+        MELVIN_TRACE_SCOPE("reason.tokenize");
+        
+        // Tokenize and filter stop words
+        tokens = tokenize_and_filter(query);
+        if (tokens.empty()) {
+            result.answer = "I didn't understand the question.";
+            return result;
+        }
+        
+        // Compute query embedding
+        query_embedding = compute_embedding(tokens);
+        
+        // Classify intent
+        result.intent = classify_intent(tokens, query_embedding);
+        result.strategy = get_strategy(result.intent);
     }
     
-    // Compute query embedding
-    std::vector<float> query_embedding = compute_embedding(tokens);
-    
-    // Classify intent
-    result.intent = classify_intent(tokens, query_embedding);
-    result.strategy = get_strategy(result.intent);
-    
     // ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
     // STAGE 2: ACTIVATE & TRAVERSE (Genome-driven temperature, thresholds)
     // ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
     
     // Activate seed nodes
-    std::vector<int> seeds = activate_nodes(tokens);
+    std::vector<int> seeds;
+    {
+        metrics::ScopedLatency timer(latency.seed);
+        MELVIN_TRACE_SCOPE("reason.seed");
+        seeds = activate_nodes(tokens);
+    }
     if (seeds.empty()) {
         result.answer = "I don't recognize those concepts.";
         return result;
@@ -81,7 +121,13 @@ UnifiedResult UnifiedIntelligence::reason(const std::string& query) {
     std::unordered_map<int, float> activations;
     std::unordered_map<int, std::vector<int>> paths;
     
-    spread_activation(seeds, result.strategy, query_embedding, activations, paths);
+    {
+        metrics::ScopedLatency timer(latency.spread);
+        MELVIN_TRACE_SCOPE("reason.spread");
+        result.spread_completion = spread_activation(
+            seeds, result.strategy, query_embedding, activations, paths, deadline);
+    }
+    result.truncated = result.spread_completion < 1.0f;
     
     if (activations.empty()) {
         result.answer = "I couldn't find related information.";
@@ -94,11 +140,20 @@ UnifiedResult UnifiedIntelligence::reason(const std::string& query) {
     // STAGE 3: SCORE & RANK (Genome-driven α, β, γ)
     // ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
     
-    std::vector<std::pair<int, float>> ranked = score_and_rank(
-        activations,
-        paths,
-        query_embedding
-    );
+    bool scoring_truncated = false;
+    std::vector<std::pair<int, float>> ranked;
+    {
+        metrics::ScopedLatency timer(latency.score);
+        MELVIN_TRACE_SCOPE("reason.score");
+        ranked = score_and_rank(
+            activations,
+            paths,
+            query_embedding,
+            deadline,
+            scoring_truncated
+        );
+    }
+    result.truncated = result.truncated || scoring_truncated;
     
     // Extract top concepts for result
     for (size_t i = 0; i < std::min(size_t(5), ranked.size()); i++) {
@@ -112,19 +167,24 @@ UnifiedResult UnifiedIntelligence::reason(const std::string& query) {
     // STAGE 4: SYNTHESIZE ANSWER (LM-style organic generation)
     // ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
     
-    // Use organic LM-style generation (no templates)
-    melvin::reasoning::AnswerSynthesizer synthesizer;
-    result.answer = synthesizer.generate_lm_style(result.top_concepts, id_to_word_, result.confidence);
-    
-    // Generate explanation from path
-    if (!ranked.empty() && paths.count(ranked[0].first)) {
-        const auto& path = paths[ranked[0].first];
-        if (path.size() > 1) {
-            std::stringstream ss;
-            for (size_t i = 0; i < std::min(size_t(3), path.size()); i++) {
-                auto it = id_to_word_.find(path[i]);
-                if (it != id_to_word_.end()) {
-                    result.reasoning_path.push_back(it->second);
+    {
+        metrics::ScopedLatency timer(latency.synthesize);
+        MELVIN_TRACE_SCOPE("reason.synthesize");
+        
+        // Use organic LM-style generation (no templates)
+        melvin::reasoning::AnswerSynthesizer synthesizer;
+        result.answer = synthesizer.generate_lm_style(result.top_concepts, id_to_word_, result.confidence);
+        
+        // Generate explanation from path
+        if (!ranked.empty() && paths.count(ranked[0].first)) {
+            const auto& path = paths[ranked[0].first];
+            if (path.size() > 1) {
+                std::stringstream ss;
+                for (size_t i = 0; i < std::min(size_t(3), path.size()); i++) {
+                    auto it = id_to_word_.find(path[i]);
+                    if (it != id_to_word_.end()) {
+                        result.reasoning_path.push_back(it->second);
+                    }
                 }
             }
         }
@@ -162,8 +222,11 @@ UnifiedResult UnifiedIntelligence::reason(const std::string& query) {
     // STAGE 6: HEBBIAN LEARNING (Neurons that fire together wire together)
     // ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
     
-    // Strengthen connections between co-activated nodes
-    apply_hebbian_learning(activations, 0.01f);
+    // Strengthen connections between co-activated nodes (quadratic in the
+    // active set, so skipped once the deadline has been hit)
+    if (!result.truncated && Clock::now() < deadline) {
+        apply_hebbian_learning(activations, 0.01f);
+    }
     
     // ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
     // STAGE 7: REFLECT & ADAPT (Autonomous mode switching)
@@ -271,12 +334,13 @@ std::vector<int> UnifiedIntelligence::activate_nodes(const std::vector<std::stri
     return node_ids;
 }
 
-void UnifiedIntelligence::spread_activation(
+float UnifiedIntelligence::spread_activation(
     const std::vector<int>& seeds,
     const language::ReasoningStrategy& strategy,
     const std::vector<float>& query_embedding,
     std::unordered_map<int, float>& activations,
-    std::unordered_map<int, std::vector<int>>& paths
+    std::unordered_map<int, std::vector<int>>& paths,
+    Clock::time_point deadline
 ) {
     // Get genome parameters
     auto& params = genome_.reasoning_params();
@@ -296,8 +360,15 @@ void UnifiedIntelligence::spread_activation(
     // Spread using genome temperature and thresholds
     int iterations = 0;
     const int max_iterations = 500;
+    const int clock_check_interval = 16;  // Expansions between deadline checks
     
     while (!frontier.empty() && iterations < max_iterations) {
+        // Cooperative deadline check: keep what has been activated so far
+        if (iterations % clock_check_interval == 0 && Clock::now() >= deadline) {
+            int remaining = std::min<int>(frontier.size(), max_iterations - iterations);
+            return static_cast<float>(iterations) / static_cast<float>(iterations + remaining);
+        }
+        
         auto [current, energy] = frontier.front();
         frontier.pop();
         
@@ -332,22 +403,36 @@ void UnifiedIntelligence::spread_activation(
         
         iterations++;
     }
+    
+    return 1.0f;
 }
 
 std::vector<std::pair<int, float>> UnifiedIntelligence::score_and_rank(
     const std::unordered_map<int, float>& activations,
     const std::unordered_map<int, std::vector<int>>& paths,
-    const std::vector<float>& query_embedding
+    const std::vector<float>& query_embedding,
+    Clock::time_point deadline,
+    bool& truncated
 ) {
     // Get genome scoring weights
     auto& params = genome_.reasoning_params();
     
     std::vector<std::pair<int, float>> scored;
+    scored.reserve(activations.size());
+    std::vector<float> semantic_terms;  // Added to scored once all are known
+    semantic_terms.reserve(activations.size());
+    
+    const size_t clock_check_interval = 64;
+    size_t count = 0;
     
     for (const auto& [node_id, activation] : activations) {
-        // Semantic fit
+        if (!truncated && count++ % clock_check_interval == 0 && Clock::now() >= deadline) {
+            truncated = true;
+        }
+        
+        // Semantic fit (skipped once out of time: the cosine is the expensive part)
         float semantic_fit = 0.5f;
-        auto emb_it = embeddings_.find(node_id);
+        auto emb_it = truncated ? embeddings_.end() : embeddings_.find(node_id);
         if (emb_it != embeddings_.end()) {
             semantic_fit = cosine_similarity(emb_it->second, query_embedding);
             semantic_fit = (semantic_fit + 1.0f) / 2.0f;
@@ -362,10 +447,18 @@ std::vector<std::pair<int, float>> UnifiedIntelligence::score_and_rank(
         
         // Unified score using genome weights (α, β, γ)
         float score = params.activation_weight * activation +
-                     params.semantic_bias_weight * semantic_fit +
                      params.coherence_weight * coherence;
         
         scored.push_back({node_id, score});
+        semantic_terms.push_back(params.semantic_bias_weight * semantic_fit);
+    }
+    
+    // Out of time: drop the semantic term for every candidate, so ones
+    // visited before the deadline do not outrank the rest by iteration order
+    if (!truncated) {
+        for (size_t i = 0; i < scored.size(); i++) {
+            scored[i].second += semantic_terms[i];
+        }
     }
     
     // Sort by score
@@ -21,6 +21,7 @@
 #include <unordered_map>
 #include <mutex>
 #include <atomic>
+#include <chrono>
 #include "core/evolution/dynamic_genome.h"
 #include "core/language/intent_classifier.h"
 #include "core/metrics/reasoning_metrics.h"
@@ -56,6 +57,10 @@ struct UnifiedResult {
     // Top concepts
     std::vector<std::pair<std::string, float>> top_concepts;
     
+    // Anytime reasoning: set when the deadline cut the pipeline short
+    bool truncated;
+    float spread_completion;  // Fraction of the spread frontier expanded (1 = ran to completion)
+    
     UnifiedResult() :
         intent(language::ReasoningIntent::UNKNOWN),
         confidence(0.0f),
@@ -64,7 +69,9 @@ struct UnifiedResult {
         semantic_fit(0.0f),
         mode(metacognition::ReasoningMode::EXPLORATORY),
         active_nodes(0),
-        reasoning_steps(0)
+        reasoning_steps(0),
+        truncated(false),
+        spread_completion(1.0f)
     {}
 };
 
@@ -79,6 +86,8 @@ struct UnifiedResult {
  */
 class UnifiedIntelligence {
 public:
+    using Clock = std::chrono::steady_clock;
+    
     UnifiedIntelligence();
     ~UnifiedIntelligence() = default;
     
@@ -105,6 +114,16 @@ public:
      */
     UnifiedResult reason(const std::string& query);
     
+    /**
+     * @brief Anytime reasoning bounded by a deadline
+     * 
+     * Spreading and scoring check the clock cooperatively; once the
+     * deadline passes, the best answer found so far is returned with
+     * truncated = true and spread_completion < 1. Hebbian learning is
+     * skipped for truncated results so it never extends the overrun.
+     */
+    UnifiedResult reason(const std::string& query, Clock::time_point deadline);
+    
     /**
      * @brief Learn from feedback
      * 
@@ -201,18 +220,28 @@ private:
     
     std::vector<int> activate_nodes(const std::vector<std::string>& tokens);
     
-    void spread_activation(
+    /**
+     * @return Fraction of the frontier expanded before the deadline (1 = complete)
+     */
+    float spread_activation(
         const std::vector<int>& seeds,
         const language::ReasoningStrategy& strategy,
         const std::vector<float>& query_embedding,
         std::unordered_map<int, float>& activations,
-        std::unordered_map<int, std::vector<int>>& paths
+        std::unordered_map<int, std::vector<int>>& paths,
+        Clock::time_point deadline
     );
     
+    /**
+     * Past the deadline, remaining nodes are scored without the embedding
+     * lookup (neutral semantic fit) and `truncated` is set.
+     */
     std::vector<std::pair<int, float>> score_and_rank(
         const std::unordered_map<int, float>& activations,
         const std::unordered_map<int, std::vector<int>>& paths,
-        const std::vector<float>& query_embedding
+        const std::vector<float>& query_embedding,
+        Clock::time_point deadline,
+        bool& truncated
     );
     
     std::string synthesize_answer(
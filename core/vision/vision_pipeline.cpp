@@ -1,4 +1,5 @@
 #include "vision_pipeline.h"
+#include "core/metrics/trace.h"
 #include <cmath>
 #include <algorithm>
 #include <sstream>
@@ -19,6 +20,7 @@ Stage1_VisionInput::Stage1_VisionInput()
 }
 
 Stage1_VisionInput::Output Stage1_VisionInput::process(const cv::Mat& frame, const cv::Point2f& focus_point) {
+    MELVIN_TRACE_SCOPE("vision.input");
     Output output;
     
     cv::Mat gray;
@@ -187,6 +189,7 @@ cv::Point2f Stage2_Tokenize::compute_focus(const std::vector<Patch>& patches) {
 }
 
 Stage2_Tokenize::Output Stage2_Tokenize::process(const Stage1_VisionInput::Output& input) {
+    MELVIN_TRACE_SCOPE("vision.tokenize");
     Output output;
     output.nodes_created = 0;
     output.nodes_reused = 0;
@@ -335,6 +338,7 @@ void Stage3_Connect::update_object_tracking(const std::vector<Token>& tokens) {
 }
 
 Stage3_Connect::Output Stage3_Connect::process(const Stage2_Tokenize::Output& input) {
+    MELVIN_TRACE_SCOPE("vision.connect");
     Output output;
     
     update_object_tracking(input.tokens);
@@ -500,6 +504,7 @@ void Stage5_Generalize::evolve_parameters(bool success) {
 }
 
 Stage5_Generalize::Output Stage5_Generalize::process(const Stage3_Connect::Output& input) {
+    MELVIN_TRACE_SCOPE("vision.generalize");
     Output output;
     
     auto clusters = cluster_objects(input.objects);
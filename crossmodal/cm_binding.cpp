@@ -4,56 +4,409 @@
 
 #include "cm_binding.h"
 #include <algorithm>
+#include <cstring>
 
 namespace melvin {
 namespace crossmodal {
 
-void CMBindings::Upsert(const Binding& b) {
-    std::lock_guard<std::mutex> lock(mu_);
-    auto& vc = by_concept_[b.concept_id];
-    bool found = false;
-    for (auto& x : vc) {
-        if (x.key == b.key && x.mod == b.mod) { x.weight = b.weight; x.source = b.source; found = true; break; }
+namespace {
+
+inline uint64_t mix64(uint64_t x) {
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    return x ^ (x >> 31);
+}
+
+inline uint64_t hash_text(std::string_view s) {
+    uint64_t h = 0xcbf29ce484222325ULL;  // FNV-1a, then mixed
+    for (unsigned char c : s) h = (h ^ c) * 0x100000001b3ULL;
+    return mix64(h);
+}
+
+} // namespace
+
+// ============================================================================
+// CMStringPool
+// ============================================================================
+
+bool CMStringPool::Shard::findLocked(std::string_view s, uint64_t h, size_t& pos) const {
+    if (table.empty()) return false;
+    size_t mask = table.size() - 1;
+    for (pos = (h >> 4) & mask; table[pos] != 0; pos = (pos + 1) & mask) {
+        if (names[table[pos] - 1] == s) return true;
+    }
+    return false;
+}
+
+void CMStringPool::Shard::growLocked() {
+    table.assign(std::max<size_t>(16, table.size() * 2), 0);
+    size_t mask = table.size() - 1;
+    for (uint32_t local = 0; local < names.size(); ++local) {
+        size_t pos = (hash_text(names[local]) >> 4) & mask;
+        while (table[pos] != 0) pos = (pos + 1) & mask;
+        table[pos] = local + 1;
+    }
+}
+
+uint32_t CMStringPool::Intern(std::string_view s) {
+    uint64_t h = hash_text(s);
+    uint32_t index = static_cast<uint32_t>(h % kShards);
+    Shard& shard = shards_[index];
+    size_t pos;
+    {
+        std::shared_lock<std::shared_mutex> lock(shard.mu);
+        if (shard.findLocked(s, h, pos)) return (shard.table[pos] - 1) * kShards + index;
+    }
+
+    std::unique_lock<std::shared_mutex> lock(shard.mu);
+    if ((shard.names.size() + 1) * 2 > shard.table.size()) shard.growLocked();
+    if (shard.findLocked(s, h, pos)) return (shard.table[pos] - 1) * kShards + index;
+
+    // Copy the text into the current chunk; oversized strings get their own
+    char* text;
+    if (s.size() > kChunkBytes) {
+        shard.chunks.emplace_back(new char[s.size()]);
+        shard.chunk_bytes += s.size();
+        text = shard.chunks.back().get();
+        shard.chunk_used = kChunkBytes;
+    } else {
+        if (shard.chunks.empty() || shard.chunk_used + s.size() > kChunkBytes) {
+            shard.chunks.emplace_back(new char[kChunkBytes]);
+            shard.chunk_bytes += kChunkBytes;
+            shard.chunk_used = 0;
+        }
+        text = shard.chunks.back().get() + shard.chunk_used;
+        shard.chunk_used += s.size();
+    }
+    if (!s.empty()) std::memcpy(text, s.data(), s.size());
+
+    uint32_t local = static_cast<uint32_t>(shard.names.size());
+    shard.names.emplace_back(text, s.size());
+    shard.table[pos] = local + 1;
+    return local * kShards + index;
+}
+
+bool CMStringPool::Find(std::string_view s, uint32_t& id) const {
+    uint64_t h = hash_text(s);
+    uint32_t index = static_cast<uint32_t>(h % kShards);
+    const Shard& shard = shards_[index];
+    std::shared_lock<std::shared_mutex> lock(shard.mu);
+    size_t pos;
+    if (!shard.findLocked(s, h, pos)) return false;
+    id = (shard.table[pos] - 1) * kShards + index;
+    return true;
+}
+
+std::string_view CMStringPool::Name(uint32_t id) const {
+    const Shard& shard = shards_[id % kShards];
+    std::shared_lock<std::shared_mutex> lock(shard.mu);
+    uint32_t local = id / kShards;
+    return local < shard.names.size() ? shard.names[local] : std::string_view();
+}
+
+size_t CMStringPool::Size() const {
+    size_t total = 0;
+    for (const auto& shard : shards_) {
+        std::shared_lock<std::shared_mutex> lock(shard.mu);
+        total += shard.names.size();
+    }
+    return total;
+}
+
+size_t CMStringPool::MemoryBytes() const {
+    size_t bytes = 0;
+    for (const auto& shard : shards_) {
+        std::shared_lock<std::shared_mutex> lock(shard.mu);
+        bytes += shard.chunk_bytes + shard.names.capacity() * sizeof(std::string_view) +
+                 shard.table.capacity() * sizeof(uint32_t);
+    }
+    return bytes;
+}
+
+// ============================================================================
+// CMBindings shards
+// ============================================================================
+
+uint32_t CMBindings::ConceptShard::allocBlock(uint8_t size_class) {
+    auto& blocks = free_blocks[size_class];
+    if (!blocks.empty()) {
+        uint32_t begin = blocks.back();
+        blocks.pop_back();
+        return begin;
+    }
+    uint32_t begin = static_cast<uint32_t>(key.size());
+    size_t end = begin + (size_t(1) << size_class);
+    key.resize(end);
+    source.resize(end);
+    weight.resize(end);
+    mod.resize(end);
+    return begin;
+}
+
+void CMBindings::ConceptShard::freeBlock(uint32_t begin, uint8_t size_class) {
+    free_blocks[size_class].push_back(begin);
+}
+
+void CMBindings::ConceptShard::moveCell(uint32_t from, uint32_t to) {
+    key[to] = key[from];
+    source[to] = source[from];
+    weight[to] = weight[from];
+    mod[to] = mod[from];
+}
+
+void CMBindings::KeyShard::upsert(uint32_t key_id, int64_t c, uint8_t m, float w, uint32_t s) {
+    uint32_t local = key_id / kShards;
+    if (local >= head.size()) {
+        head.resize(local + 1, kNil);
+        fanout.resize(local + 1, 0);
+    }
+
+    uint32_t weakest = kNil;
+    for (uint32_t r = head[local]; r != kNil; r = next[r]) {
+        if (concept_id[r] == c && mod[r] == m) {
+            weight[r] = w;
+            source[r] = s;
+            return;
+        }
+        if (weakest == kNil || weight[r] < weight[weakest]) weakest = r;
+    }
+
+    if (fanout[local] >= kMaxPerKey) {
+        // Full: replace the weakest ref if the new binding is stronger
+        if (weight[weakest] < w) {
+            concept_id[weakest] = c;
+            weight[weakest] = w;
+            source[weakest] = s;
+            mod[weakest] = m;
+        }
+        return;
+    }
+
+    uint32_t r;
+    if (!free_refs.empty()) {
+        r = free_refs.back();
+        free_refs.pop_back();
+        concept_id[r] = c;
+        weight[r] = w;
+        source[r] = s;
+        next[r] = head[local];
+        mod[r] = m;
+    } else {
+        r = static_cast<uint32_t>(concept_id.size());
+        concept_id.push_back(c);
+        weight.push_back(w);
+        source.push_back(s);
+        next.push_back(head[local]);
+        mod.push_back(m);
     }
-    if (!found) vc.push_back(b);
-    // Cap per-concept bindings (top by weight)
-    if (vc.size() > 64) {
-        std::sort(vc.begin(), vc.end(), [](const Binding& a, const Binding& b){ return a.weight > b.weight; });
-        vc.resize(64);
+    head[local] = r;
+    ++fanout[local];
+}
+
+void CMBindings::KeyShard::remove(uint32_t key_id, int64_t c, uint8_t m) {
+    uint32_t local = key_id / kShards;
+    if (local >= head.size()) return;
+    for (uint32_t prev = kNil, r = head[local]; r != kNil; prev = r, r = next[r]) {
+        if (concept_id[r] != c || mod[r] != m) continue;
+        if (prev == kNil) head[local] = next[r];
+        else next[prev] = next[r];
+        free_refs.push_back(r);
+        --fanout[local];
+        return;
     }
-    auto& vk = by_key_[b.key];
-    found = false;
-    for (auto& x : vk) {
-        if (x.concept_id == b.concept_id && x.mod == b.mod) { x.weight = b.weight; x.source = b.source; found = true; break; }
+}
+
+// ============================================================================
+// CMBindings
+// ============================================================================
+
+CMBindings::ConceptShard& CMBindings::conceptShard(int64_t id) {
+    return concept_shards_[mix64(static_cast<uint64_t>(id)) % kShards];
+}
+
+const CMBindings::ConceptShard& CMBindings::conceptShard(int64_t id) const {
+    return concept_shards_[mix64(static_cast<uint64_t>(id)) % kShards];
+}
+
+void CMBindings::Upsert(const Binding& b) {
+    Upsert(b.concept_id, b.mod, keys_.Intern(b.key), b.weight, sources_.Intern(b.source));
+}
+
+void CMBindings::Upsert(int64_t concept_id, Binding::Modality mod, uint32_t key_id,
+                        float weight, uint32_t source_id) {
+    uint8_t m = static_cast<uint8_t>(mod);
+    ConceptShard& cs = conceptShard(concept_id);
+    std::unique_lock<std::shared_mutex> lock(cs.mu);
+    auto [it, fresh] = cs.ranges.try_emplace(concept_id, ConceptShard::Range{0, 0, 0});
+    ConceptShard::Range& r = it->second;
+    if (fresh) r.begin = cs.allocBlock(0);
+
+    uint32_t cell = kNil;
+    for (uint32_t i = r.begin, end = r.begin + r.size; i < end; ++i) {
+        if (cs.key[i] == key_id && cs.mod[i] == m) {
+            cell = i;
+            break;
+        }
+    }
+
+    if (cell == kNil && r.size == kMaxPerConcept) {
+        // Cap per-concept bindings: evict the weakest (maybe the new one)
+        uint32_t weakest = r.begin;
+        for (uint32_t i = r.begin + 1, end = r.begin + r.size; i < end; ++i) {
+            if (cs.weight[i] < cs.weight[weakest]) weakest = i;
+        }
+        if (weight < cs.weight[weakest]) return;
+        removeFromKey(cs.key[weakest], concept_id, cs.mod[weakest]);
+        cell = weakest;
+        cs.key[cell] = key_id;
+        cs.mod[cell] = m;
+    } else if (cell == kNil) {
+        if (r.size == (1u << r.size_class)) {
+            // Block full: move the concept to one twice the size
+            uint32_t begin = cs.allocBlock(r.size_class + 1);
+            for (uint32_t i = 0; i < r.size; ++i) cs.moveCell(r.begin + i, begin + i);
+            cs.freeBlock(r.begin, r.size_class);
+            r.begin = begin;
+            ++r.size_class;
+        }
+        cell = r.begin + r.size++;
+        cs.key[cell] = key_id;
+        cs.mod[cell] = m;
+        ++cs.live;
     }
-    if (!found) vk.push_back(b);
+    cs.weight[cell] = weight;
+    cs.source[cell] = source_id;
+
+    KeyShard& ks = keyShard(key_id);
+    std::unique_lock<std::shared_mutex> key_lock(ks.mu);
+    ks.upsert(key_id, concept_id, m, weight, source_id);
+}
+
+void CMBindings::removeFromKey(uint32_t key_id, int64_t concept_id, uint8_t mod) {
+    KeyShard& ks = keyShard(key_id);
+    std::unique_lock<std::shared_mutex> lock(ks.mu);
+    ks.remove(key_id, concept_id, mod);
 }
 
 std::vector<Binding> CMBindings::ForConcept(int64_t id) const {
-    std::lock_guard<std::mutex> lock(mu_);
-    auto it = by_concept_.find(id);
-    if (it == by_concept_.end()) return {};
-    return it->second;
+    std::vector<Binding> out;
+    auto view = ViewConcept(id);
+    out.reserve(view.size());
+    for (const BindingRef& ref : view) out.push_back(materialize(ref));
+    return out;
 }
 
 std::vector<Binding> CMBindings::ForKey(const std::string& key) const {
-    std::lock_guard<std::mutex> lock(mu_);
-    auto it = by_key_.find(key);
-    if (it == by_key_.end()) return {};
-    return it->second;
+    std::vector<Binding> out;
+    for (const BindingRef& ref : ViewKey(key)) out.push_back(materialize(ref));
+    return out;
 }
 
 void CMBindings::PruneConcept(int64_t id, size_t max_keep) {
-    std::lock_guard<std::mutex> lock(mu_);
-    auto it = by_concept_.find(id);
-    if (it == by_concept_.end()) return;
-    auto& vc = it->second;
-    if (vc.size() <= max_keep) return;
-    std::sort(vc.begin(), vc.end(), [](const Binding& a, const Binding& b){ return a.weight > b.weight; });
-    vc.resize(max_keep);
+    ConceptShard& cs = conceptShard(id);
+    std::unique_lock<std::shared_mutex> lock(cs.mu);
+    auto it = cs.ranges.find(id);
+    if (it == cs.ranges.end()) return;
+    ConceptShard::Range& r = it->second;
+    if (r.size <= max_keep) return;
+
+    // Keep the strongest max_keep cells at the front of the block
+    std::vector<uint32_t> order(r.size);
+    for (uint32_t i = 0; i < r.size; ++i) order[i] = r.begin + i;
+    std::nth_element(order.begin(), order.begin() + max_keep, order.end(),
+        [&](uint32_t a, uint32_t b){ return cs.weight[a] > cs.weight[b]; });
+    for (size_t i = max_keep; i < order.size(); ++i) {
+        removeFromKey(cs.key[order[i]], id, cs.mod[order[i]]);
+    }
+    std::sort(order.begin(), order.begin() + max_keep);
+    for (size_t i = 0; i < max_keep; ++i) cs.moveCell(order[i], r.begin + static_cast<uint32_t>(i));
+    cs.live -= r.size - max_keep;
+    r.size = static_cast<uint8_t>(max_keep);
+    if (r.size == 0) {
+        cs.freeBlock(r.begin, r.size_class);
+        cs.ranges.erase(it);
+    }
 }
 
-} // namespace crossmodal
-} // namespace melvin
+CMBindings::ConceptView CMBindings::ViewConcept(int64_t id) const {
+    ConceptView view;
+    const ConceptShard& cs = conceptShard(id);
+    view.lock_ = std::shared_lock<std::shared_mutex>(cs.mu);
+    view.shard_ = &cs;
+    view.concept_id_ = id;
+    auto it = cs.ranges.find(id);
+    if (it != cs.ranges.end()) {
+        view.begin_ = it->second.begin;
+        view.size_ = it->second.size;
+    }
+    return view;
+}
+
+CMBindings::KeyView CMBindings::ViewKey(uint32_t key_id) const {
+    KeyView view;
+    const KeyShard& ks = keyShard(key_id);
+    view.lock_ = std::shared_lock<std::shared_mutex>(ks.mu);
+    view.shard_ = &ks;
+    view.key_id_ = key_id;
+    uint32_t local = key_id / kShards;
+    if (local < ks.head.size()) view.head_ = ks.head[local];
+    return view;
+}
+
+CMBindings::KeyView CMBindings::ViewKey(const std::string& key) const {
+    uint32_t key_id;
+    if (!keys_.Find(key, key_id)) return KeyView();
+    return ViewKey(key_id);
+}
+
+BindingRef CMBindings::ConceptView::operator[](size_t i) const {
+    size_t cell = begin_ + i;
+    return {concept_id_, static_cast<Binding::Modality>(shard_->mod[cell]),
+            shard_->key[cell], shard_->weight[cell], shard_->source[cell]};
+}
+
+BindingRef CMBindings::KeyView::iterator::operator*() const {
+    const KeyShard* s = view->shard_;
+    return {s->concept_id[ref], static_cast<Binding::Modality>(s->mod[ref]),
+            view->key_id_, s->weight[ref], s->source[ref]};
+}
+
+CMBindings::KeyView::iterator& CMBindings::KeyView::iterator::operator++() {
+    ref = view->shard_->next[ref];
+    return *this;
+}
+
+Binding CMBindings::materialize(const BindingRef& ref) const {
+    return Binding{ref.concept_id, ref.mod, std::string(keys_.Name(ref.key_id)), ref.weight,
+                   std::string(sources_.Name(ref.source_id))};
+}
 
+size_t CMBindings::Size() const {
+    size_t total = 0;
+    for (const auto& cs : concept_shards_) {
+        std::shared_lock<std::shared_mutex> lock(cs.mu);
+        total += cs.live;
+    }
+    return total;
+}
 
+size_t CMBindings::MemoryBytes() const {
+    size_t bytes = keys_.MemoryBytes() + sources_.MemoryBytes();
+    for (const auto& cs : concept_shards_) {
+        std::shared_lock<std::shared_mutex> lock(cs.mu);
+        bytes += cs.key.capacity() * (3 * sizeof(uint32_t) + sizeof(uint8_t)) +
+                 cs.ranges.size() * (sizeof(std::pair<const int64_t, ConceptShard::Range>) + 2 * sizeof(void*)) +
+                 cs.ranges.bucket_count() * sizeof(void*);
+        for (const auto& blocks : cs.free_blocks) bytes += blocks.capacity() * sizeof(uint32_t);
+    }
+    for (const auto& ks : key_shards_) {
+        std::shared_lock<std::shared_mutex> lock(ks.mu);
+        bytes += ks.head.capacity() * (sizeof(uint32_t) + sizeof(uint8_t)) +
+                 ks.concept_id.capacity() * (sizeof(int64_t) + 3 * sizeof(uint32_t) + sizeof(uint8_t)) +
+                 ks.free_refs.capacity() * sizeof(uint32_t);
+    }
+    return bytes;
+}
+
+} // namespace crossmodal
+} // namespace melvin
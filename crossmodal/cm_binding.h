@@ -5,7 +5,12 @@
 #ifndef MELVIN_CROSSMODAL_CM_BINDING_H
 #define MELVIN_CROSSMODAL_CM_BINDING_H
 
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <shared_mutex>
 #include <string>
+#include <string_view>
 #include <vector>
 #include <unordered_map>
 #include <mutex>
@@ -13,6 +18,8 @@
 namespace melvin {
 namespace crossmodal {
 
+class CMIO;
+
 struct Binding {
     int64_t concept_id;
     enum Modality { TEXT, VISION, AUDIO, MOTOR } mod;
@@ -21,24 +28,188 @@ struct Binding {
     std::string source; // provenance
 };
 
+// A stored binding: key and source as interned ids
+struct BindingRef {
+    int64_t concept_id;
+    Binding::Modality mod;
+    uint32_t key_id;
+    float weight;
+    uint32_t source_id;
+};
+
+// Append-only string interner, sharded by hash. Names stay valid for the
+// pool's lifetime: text lives in fixed chunks that never move.
+class CMStringPool {
+public:
+    static constexpr uint32_t kShards = 16;  // id % kShards = shard
+
+    uint32_t Intern(std::string_view s);
+    bool Find(std::string_view s, uint32_t& id) const;
+    std::string_view Name(uint32_t id) const;  // Empty for unknown ids
+    size_t Size() const;
+    size_t MemoryBytes() const;
+
+private:
+    friend class CMIO;  // Snapshot save / restore
+
+    static constexpr size_t kChunkBytes = 64 * 1024;
+
+    struct Shard {
+        mutable std::shared_mutex mu;
+        std::vector<std::unique_ptr<char[]>> chunks;
+        size_t chunk_used = kChunkBytes;
+        size_t chunk_bytes = 0;
+        std::vector<std::string_view> names;  // Local id -> text
+        std::vector<uint32_t> table;          // Open addressing: local id + 1, 0 = empty
+
+        bool findLocked(std::string_view s, uint64_t h, size_t& pos) const;
+        void growLocked();
+    };
+    std::array<Shard, kShards> shards_;
+};
+
+// Bindings in flat structure-of-arrays storage, sharded by concept id.
+// A concept's bindings are one contiguous block of the shard's columns
+// (power-of-two capacity, at most kMaxPerConcept; the weakest binding is
+// evicted when full), found by a hash on the concept id; upserts then scan
+// its 32-bit key column. A key-sharded fan-out index, capped at
+// kMaxPerKey, answers key lookups without touching concept shards. Locks
+// are always taken concept shard first, then one key shard.
 class CMBindings {
+    struct ConceptShard;
+    struct KeyShard;
+
 public:
+    static constexpr uint32_t kShards = CMStringPool::kShards;
+    static constexpr size_t kMaxPerConcept = 64;
+    static constexpr size_t kMaxPerKey = 64;
+    static constexpr uint32_t kNil = 0xFFFFFFFFu;
+
     void Upsert(const Binding& b);
-    std::vector<Binding> ForConcept(int64_t id) const;
+    void Upsert(int64_t concept_id, Binding::Modality mod, uint32_t key_id,
+                float weight, uint32_t source_id);
+    std::vector<Binding> ForConcept(int64_t id) const;  // Materialized copies
     std::vector<Binding> ForKey(const std::string& key) const;
     void PruneConcept(int64_t id, size_t max_keep = 64);
 
+    // Zero-copy read views. Each holds its shard's shared lock while alive:
+    // keep them short-lived and do not upsert from the same thread meanwhile.
+    class ConceptView {
+    public:
+        size_t size() const { return size_; }
+        bool empty() const { return size_ == 0; }
+        BindingRef operator[](size_t i) const;
+
+        struct iterator {
+            const ConceptView* view;
+            size_t i;
+            BindingRef operator*() const { return (*view)[i]; }
+            iterator& operator++() { ++i; return *this; }
+            bool operator!=(const iterator& o) const { return i != o.i; }
+        };
+        iterator begin() const { return {this, 0}; }
+        iterator end() const { return {this, size_}; }
+
+    private:
+        friend class CMBindings;
+        std::shared_lock<std::shared_mutex> lock_;
+        const ConceptShard* shard_ = nullptr;
+        int64_t concept_id_ = 0;
+        uint32_t begin_ = 0;
+        size_t size_ = 0;
+    };
+
+    class KeyView {
+    public:
+        bool empty() const { return head_ == kNil; }
+
+        struct iterator {
+            const KeyView* view;
+            uint32_t ref;
+            BindingRef operator*() const;
+            iterator& operator++();
+            bool operator!=(const iterator& o) const { return ref != o.ref; }
+        };
+        iterator begin() const { return {this, head_}; }
+        iterator end() const { return {this, kNil}; }
+
+    private:
+        friend class CMBindings;
+        std::shared_lock<std::shared_mutex> lock_;
+        const KeyShard* shard_ = nullptr;
+        uint32_t key_id_ = kNil;
+        uint32_t head_ = kNil;
+    };
+
+    ConceptView ViewConcept(int64_t id) const;
+    KeyView ViewKey(uint32_t key_id) const;
+    KeyView ViewKey(const std::string& key) const;  // Empty for unknown keys
+
+    CMStringPool& keys() { return keys_; }
+    const CMStringPool& keys() const { return keys_; }
+    CMStringPool& sources() { return sources_; }
+    const CMStringPool& sources() const { return sources_; }
+
+    size_t Size() const;         // Stored bindings (concept side)
+    size_t MemoryBytes() const;  // Columns, indices and interned strings
+
 private:
-    // concept_id -> list
-    std::unordered_map<int64_t, std::vector<Binding>> by_concept_;
-    // key -> list
-    std::unordered_map<std::string, std::vector<Binding>> by_key_;
-    mutable std::mutex mu_;
+    friend class CMIO;  // Snapshot save / restore
+
+    struct ConceptShard {
+        static constexpr size_t kSizeClasses = 7;  // Block capacities 1 .. 64
+
+        struct Range {
+            uint32_t begin;
+            uint8_t size;
+            uint8_t size_class;  // Capacity 1 << size_class
+        };
+
+        mutable std::shared_mutex mu;
+        std::unordered_map<int64_t, Range> ranges;
+        // Binding columns, one block per concept; freed blocks are recycled
+        std::vector<uint32_t> key;
+        std::vector<uint32_t> source;
+        std::vector<float> weight;
+        std::vector<uint8_t> mod;
+        std::array<std::vector<uint32_t>, kSizeClasses> free_blocks;
+        size_t live = 0;
+
+        uint32_t allocBlock(uint8_t size_class);
+        void freeBlock(uint32_t begin, uint8_t size_class);
+        void moveCell(uint32_t from, uint32_t to);
+    };
+
+    struct KeyShard {
+        mutable std::shared_mutex mu;
+        std::vector<uint32_t> head;     // key_id / kShards -> first ref
+        std::vector<uint8_t> fanout;    // Refs per key (<= kMaxPerKey)
+        // Ref columns, chained per key through next
+        std::vector<int64_t> concept_id;
+        std::vector<float> weight;
+        std::vector<uint32_t> source;
+        std::vector<uint32_t> next;
+        std::vector<uint8_t> mod;
+        std::vector<uint32_t> free_refs;
+
+        void upsert(uint32_t key_id, int64_t c, uint8_t m, float w, uint32_t s);
+        void remove(uint32_t key_id, int64_t c, uint8_t m);
+    };
+
+    CMStringPool keys_;
+    CMStringPool sources_;
+    std::array<ConceptShard, kShards> concept_shards_;
+    std::array<KeyShard, kShards> key_shards_;
+
+    ConceptShard& conceptShard(int64_t id);
+    const ConceptShard& conceptShard(int64_t id) const;
+    KeyShard& keyShard(uint32_t key_id) { return key_shards_[key_id % kShards]; }
+    const KeyShard& keyShard(uint32_t key_id) const { return key_shards_[key_id % kShards]; }
+    void removeFromKey(uint32_t key_id, int64_t concept_id, uint8_t mod);
+    Binding materialize(const BindingRef& ref) const;
 };
 
 } // namespace crossmodal
 } // namespace melvin
 
 #endif // MELVIN_CROSSMODAL_CM_BINDING_H
-
-
@@ -4,6 +4,7 @@
 
 #include "cm_grounder.h"
 #include <algorithm>
+#include <map>
 #include <functional>
 #include <cmath>
 
@@ -38,18 +39,33 @@ void CMGrounder::SetWeights(float alpha_context, float beta_temporal, float temp
     alpha_ = alpha_context; beta_ = beta_temporal; temperature_ = temperature;
 }
 
+void CMGrounder::Reweight(std::vector<std::pair<std::string,float>>& predictions) const {
+    // Apply contextual and temporal gating multiplicatively
+    for (auto& p : predictions) {
+        auto c = context_relevance_.find(p.first);
+        auto t = temporal_consistency_.find(p.first);
+        float ctx = c != context_relevance_.end() ? c->second : 0.0f;
+        float tmp = t != temporal_consistency_.end() ? t->second : 0.0f;
+        p.second = p.second * (1.0f + alpha_ * ctx + beta_ * tmp);
+    }
+    softmax_normalize(predictions, temperature_);
+}
+
+CMIndex* CMGrounder::IndexFor(Binding::Modality mod) {
+    switch (mod) {
+        case Binding::VISION: return &vision_idx_;
+        case Binding::AUDIO:  return &audio_idx_;
+        case Binding::MOTOR:  return &motor_idx_;
+        default:              return nullptr;
+    }
+}
+
 GroundingResult CMGrounder::PredictVisionForConcept(int64_t concept_id, int k) {
     GroundingResult gr;
     if (!concept_encoder_) return gr;
     CMVec c = concept_encoder_(concept_id);
     gr.predictions = vision_idx_.TopK(c, k);
-    // Apply contextual and temporal gating multiplicatively
-    for (auto& p : gr.predictions) {
-        float ctx = context_relevance_.count(p.first) ? context_relevance_[p.first] : 0.0f;
-        float tmp = temporal_consistency_.count(p.first) ? temporal_consistency_[p.first] : 0.0f;
-        p.second = p.second * (1.0f + alpha_ * ctx + beta_ * tmp);
-    }
-    softmax_normalize(gr.predictions, temperature_);
+    Reweight(gr.predictions);
     return gr;
 }
 
@@ -58,12 +74,7 @@ GroundingResult CMGrounder::PredictAudioForConcept(int64_t concept_id, int k) {
     if (!concept_encoder_) return gr;
     CMVec c = concept_encoder_(concept_id);
     gr.predictions = audio_idx_.TopK(c, k);
-    for (auto& p : gr.predictions) {
-        float ctx = context_relevance_.count(p.first) ? context_relevance_[p.first] : 0.0f;
-        float tmp = temporal_consistency_.count(p.first) ? temporal_consistency_[p.first] : 0.0f;
-        p.second = p.second * (1.0f + alpha_ * ctx + beta_ * tmp);
-    }
-    softmax_normalize(gr.predictions, temperature_);
+    Reweight(gr.predictions);
     return gr;
 }
 
@@ -72,20 +83,61 @@ GroundingResult CMGrounder::PredictMotorForConcept(int64_t concept_id, int k) {
     if (!concept_encoder_) return gr;
     CMVec c = concept_encoder_(concept_id);
     gr.predictions = motor_idx_.TopK(c, k);
-    for (auto& p : gr.predictions) {
-        float ctx = context_relevance_.count(p.first) ? context_relevance_[p.first] : 0.0f;
-        float tmp = temporal_consistency_.count(p.first) ? temporal_consistency_[p.first] : 0.0f;
-        p.second = p.second * (1.0f + alpha_ * ctx + beta_ * tmp);
-    }
-    softmax_normalize(gr.predictions, temperature_);
+    Reweight(gr.predictions);
     return gr;
 }
 
+std::vector<GroundingResult> CMGrounder::PredictBatch(const std::vector<GroundingQuery>& queries) {
+    std::vector<GroundingResult> out(queries.size());
+    if (!concept_encoder_) return out;
+    
+    // Queries whose k keeps the same number of re-rank candidates share a
+    // scan at their largest k: the candidate set is the one each would get
+    // alone, and its exact top k is a prefix of the shared top k
+    struct Group {
+        std::vector<CMVec> batch;
+        std::unordered_map<int64_t, size_t> slot;
+        std::vector<std::pair<size_t, size_t>> members;  // (query, batch slot)
+        int k = 0;
+    };
+    
+    std::unordered_map<int64_t, CMVec> encoded;  // Each concept encoded once
+    for (auto mod : {Binding::VISION, Binding::AUDIO, Binding::MOTOR}) {
+        std::map<size_t, Group> groups;  // By CMIndex::RerankCount(k)
+        for (size_t i = 0; i < queries.size(); ++i) {
+            const auto& q = queries[i];
+            if (q.mod != mod || q.k <= 0) continue;
+            Group& g = groups[CMIndex::RerankCount(q.k)];
+            auto [it, fresh] = g.slot.try_emplace(q.concept_id, g.batch.size());
+            if (fresh) {
+                auto e = encoded.find(q.concept_id);
+                if (e == encoded.end()) e = encoded.emplace(q.concept_id, concept_encoder_(q.concept_id)).first;
+                g.batch.push_back(e->second);
+            }
+            g.members.emplace_back(i, it->second);
+            g.k = std::max(g.k, q.k);
+        }
+        
+        for (const auto& [rerank, g] : groups) {
+            auto top = IndexFor(mod)->TopKBatch(g.batch, g.k);
+            for (const auto& [i, b] : g.members) {
+                auto& predictions = out[i].predictions;
+                size_t keep = std::min(top[b].size(), static_cast<size_t>(queries[i].k));
+                predictions.assign(top[b].begin(), top[b].begin() + keep);
+            }
+        }
+    }
+    
+    for (auto& gr : out) {
+        Reweight(gr.predictions);
+    }
+    return out;
+}
+
 std::vector<std::pair<int64_t,float>> CMGrounder::PredictConceptForVision(const std::string& vision_key, int k) {
-    // For a lite version, approximate by scanning bindings for this key
+    // For a lite version, approximate by reading the key's fan-out
     std::vector<std::pair<int64_t,float>> out;
-    auto bs = bindings_.ForKey(vision_key);
-    for (const auto& b : bs) if (b.mod == Binding::VISION) out.emplace_back(b.concept_id, b.weight);
+    for (const BindingRef& b : bindings_.ViewKey(vision_key)) if (b.mod == Binding::VISION) out.emplace_back(b.concept_id, b.weight);
     std::sort(out.begin(), out.end(), [](auto&a, auto&b){ return a.second>b.second; });
     if ((int)out.size() > k) out.resize(k);
     return out;
@@ -93,8 +145,7 @@ std::vector<std::pair<int64_t,float>> CMGrounder::PredictConceptForVision(const
 
 std::vector<std::pair<int64_t,float>> CMGrounder::PredictConceptForAudio(const std::string& audio_key, int k) {
     std::vector<std::pair<int64_t,float>> out;
-    auto bs = bindings_.ForKey(audio_key);
-    for (const auto& b : bs) if (b.mod == Binding::AUDIO) out.emplace_back(b.concept_id, b.weight);
+    for (const BindingRef& b : bindings_.ViewKey(audio_key)) if (b.mod == Binding::AUDIO) out.emplace_back(b.concept_id, b.weight);
     std::sort(out.begin(), out.end(), [](auto&a, auto&b){ return a.second>b.second; });
     if ((int)out.size() > k) out.resize(k);
     return out;
@@ -102,8 +153,7 @@ std::vector<std::pair<int64_t,float>> CMGrounder::PredictConceptForAudio(const s
 
 std::vector<std::pair<int64_t,float>> CMGrounder::PredictConceptForMotor(const std::string& motor_schema_id, int k) {
     std::vector<std::pair<int64_t,float>> out;
-    auto bs = bindings_.ForKey(motor_schema_id);
-    for (const auto& b : bs) if (b.mod == Binding::MOTOR) out.emplace_back(b.concept_id, b.weight);
+    for (const BindingRef& b : bindings_.ViewKey(motor_schema_id)) if (b.mod == Binding::MOTOR) out.emplace_back(b.concept_id, b.weight);
     std::sort(out.begin(), out.end(), [](auto&a, auto&b){ return a.second>b.second; });
     if ((int)out.size() > k) out.resize(k);
     return out;
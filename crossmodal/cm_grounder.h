@@ -19,12 +19,24 @@ struct GroundingResult {
     std::vector<std::pair<std::string,float>> predictions; // key, confidence
 };
 
+struct GroundingQuery {
+    int64_t concept_id;
+    Binding::Modality mod; // VISION, AUDIO or MOTOR
+    int k;
+};
+
 class CMGrounder {
 public:
     GroundingResult PredictVisionForConcept(int64_t concept_id, int k);
     GroundingResult PredictAudioForConcept(int64_t concept_id, int k);
     GroundingResult PredictMotorForConcept(int64_t concept_id, int k);
 
+    // Ground many (concept, modality) pairs at once: each concept is encoded
+    // once and each index scanned once per re-rank size (all k <= 16 share
+    // one scan). Results match the single-query calls and follow the query
+    // order; TEXT queries get empty predictions.
+    std::vector<GroundingResult> PredictBatch(const std::vector<GroundingQuery>& queries);
+
     std::vector<std::pair<int64_t,float>> PredictConceptForVision(const std::string& vision_key, int k);
     std::vector<std::pair<int64_t,float>> PredictConceptForAudio(const std::string& audio_key, int k);
     std::vector<std::pair<int64_t,float>> PredictConceptForMotor(const std::string& motor_schema_id, int k);
@@ -36,6 +48,7 @@ public:
     CMIndex& audio_index() { return audio_idx_; }
     CMIndex& motor_index() { return motor_idx_; }
     CMBindings& bindings() { return bindings_; }
+    const CMBindings& bindings() const { return bindings_; }
 
     template<typename F>
     void SetConceptEncoder(F fn) { enc_holder_.store(fn); concept_encoder_.set(&enc_holder_); }
@@ -47,6 +60,12 @@ public:
     void SetWeights(float alpha_context, float beta_temporal, float temperature);
 
 private:
+    friend class CMIO;  // Snapshot save / restore
+
+    // Context and temporal gating, then softmax, over one prediction list
+    void Reweight(std::vector<std::pair<std::string,float>>& predictions) const;
+    CMIndex* IndexFor(Binding::Modality mod);
+
     CMIndex vision_idx_;
     CMIndex audio_idx_;
     CMIndex motor_idx_;
@@ -4,35 +4,302 @@
 
 #include "cm_index.h"
 #include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <functional>
+#include <queue>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#if defined(__GNUC__)
+#include <immintrin.h>
+#define CM_INDEX_AVX2_DISPATCH 1  // AVX2 kernel picked at run time
+#endif
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#endif
 
 namespace melvin {
 namespace crossmodal {
 
+static_assert(sizeof(CMVec) == CMIndex::kDim * sizeof(float), "CMIndex rows mirror CMVec");
+
+namespace {
+
+using Scored = std::pair<float, uint32_t>;  // (score, key id)
+using MinHeap = std::priority_queue<Scored, std::vector<Scored>, std::greater<Scored>>;
+
+constexpr uint32_t kRowBlock = 64;  // 16 KB of int8 rows, 64 KB of fp32 rows
+
+struct alignas(64) WideQuery { int16_t v[CMIndex::kDim]; };
+
+inline float dot_f32(const float* a, const float* b) {
+    // Independent partial sums so the loop pipelines (and vectorizes)
+    float acc[8] = {0, 0, 0, 0, 0, 0, 0, 0};
+    for (size_t i = 0; i < CMIndex::kDim; i += 8) {
+        for (size_t j = 0; j < 8; ++j) acc[j] += a[i + j] * b[i + j];
+    }
+    return ((acc[0] + acc[1]) + (acc[2] + acc[3])) + ((acc[4] + acc[5]) + (acc[6] + acc[7]));
+}
+
+// Symmetric int8 quantization; returns the scale
+inline float quantize(const float* v, int8_t* out) {
+    float max_abs = 0.0f;
+    for (size_t i = 0; i < CMIndex::kDim; ++i) max_abs = std::max(max_abs, std::fabs(v[i]));
+    if (max_abs <= 0.0f) {
+        std::memset(out, 0, CMIndex::kDim);
+        return 0.0f;
+    }
+    float inv = 127.0f / max_abs;
+    for (size_t i = 0; i < CMIndex::kDim; ++i) {
+        out[i] = static_cast<int8_t>(std::lround(v[i] * inv));
+    }
+    return max_abs / 127.0f;
+}
+
+// Row (int8) . query (pre-widened to int16)
+inline int32_t dot_i8(const int8_t* row, const int16_t* q) {
+#if defined(__SSE2__)
+    __m128i acc = _mm_setzero_si128();
+    for (size_t i = 0; i < CMIndex::kDim; i += 16) {
+        __m128i r = _mm_load_si128(reinterpret_cast<const __m128i*>(row + i));
+        __m128i lo = _mm_srai_epi16(_mm_unpacklo_epi8(r, r), 8);  // Sign-extend
+        __m128i hi = _mm_srai_epi16(_mm_unpackhi_epi8(r, r), 8);
+        acc = _mm_add_epi32(acc, _mm_madd_epi16(lo, _mm_load_si128(reinterpret_cast<const __m128i*>(q + i))));
+        acc = _mm_add_epi32(acc, _mm_madd_epi16(hi, _mm_load_si128(reinterpret_cast<const __m128i*>(q + i + 8))));
+    }
+    acc = _mm_add_epi32(acc, _mm_shuffle_epi32(acc, _MM_SHUFFLE(1, 0, 3, 2)));
+    acc = _mm_add_epi32(acc, _mm_shuffle_epi32(acc, _MM_SHUFFLE(2, 3, 0, 1)));
+    return _mm_cvtsi128_si32(acc);
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+    int32x4_t acc = vdupq_n_s32(0);
+    for (size_t i = 0; i < CMIndex::kDim; i += 8) {
+        int16x8_t r = vmovl_s8(vld1_s8(row + i));
+        int16x8_t b = vld1q_s16(q + i);
+        acc = vmlal_s16(acc, vget_low_s16(r), vget_low_s16(b));
+        acc = vmlal_high_s16(acc, r, b);
+    }
+    return vaddvq_s32(acc);
+#else
+    int32_t acc = 0;
+    for (size_t i = 0; i < CMIndex::kDim; ++i) acc += row[i] * q[i];
+    return acc;
+#endif
+}
+
+// One row against four queries: the row is loaded and widened once.
+// Accumulators are spelled out so they stay in registers at -O2.
+inline void dot_i8_x4(const int8_t* row, const int16_t* const q[4], int32_t out[4]) {
+#if defined(__SSE2__)
+    __m128i acc0 = _mm_setzero_si128(), acc1 = _mm_setzero_si128();
+    __m128i acc2 = _mm_setzero_si128(), acc3 = _mm_setzero_si128();
+    for (size_t i = 0; i < CMIndex::kDim; i += 16) {
+        __m128i r = _mm_load_si128(reinterpret_cast<const __m128i*>(row + i));
+        __m128i lo = _mm_srai_epi16(_mm_unpacklo_epi8(r, r), 8);
+        __m128i hi = _mm_srai_epi16(_mm_unpackhi_epi8(r, r), 8);
+        acc0 = _mm_add_epi32(acc0, _mm_madd_epi16(lo, _mm_load_si128(reinterpret_cast<const __m128i*>(q[0] + i))));
+        acc1 = _mm_add_epi32(acc1, _mm_madd_epi16(lo, _mm_load_si128(reinterpret_cast<const __m128i*>(q[1] + i))));
+        acc2 = _mm_add_epi32(acc2, _mm_madd_epi16(lo, _mm_load_si128(reinterpret_cast<const __m128i*>(q[2] + i))));
+        acc3 = _mm_add_epi32(acc3, _mm_madd_epi16(lo, _mm_load_si128(reinterpret_cast<const __m128i*>(q[3] + i))));
+        acc0 = _mm_add_epi32(acc0, _mm_madd_epi16(hi, _mm_load_si128(reinterpret_cast<const __m128i*>(q[0] + i + 8))));
+        acc1 = _mm_add_epi32(acc1, _mm_madd_epi16(hi, _mm_load_si128(reinterpret_cast<const __m128i*>(q[1] + i + 8))));
+        acc2 = _mm_add_epi32(acc2, _mm_madd_epi16(hi, _mm_load_si128(reinterpret_cast<const __m128i*>(q[2] + i + 8))));
+        acc3 = _mm_add_epi32(acc3, _mm_madd_epi16(hi, _mm_load_si128(reinterpret_cast<const __m128i*>(q[3] + i + 8))));
+    }
+    // Transpose-add the four accumulators into one vector of sums
+    __m128i s01 = _mm_add_epi32(_mm_unpacklo_epi32(acc0, acc1), _mm_unpackhi_epi32(acc0, acc1));
+    __m128i s23 = _mm_add_epi32(_mm_unpacklo_epi32(acc2, acc3), _mm_unpackhi_epi32(acc2, acc3));
+    __m128i sum = _mm_add_epi32(_mm_unpacklo_epi64(s01, s23), _mm_unpackhi_epi64(s01, s23));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out), sum);
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+    int32x4_t acc0 = vdupq_n_s32(0), acc1 = vdupq_n_s32(0);
+    int32x4_t acc2 = vdupq_n_s32(0), acc3 = vdupq_n_s32(0);
+    for (size_t i = 0; i < CMIndex::kDim; i += 8) {
+        int16x8_t r = vmovl_s8(vld1_s8(row + i));
+        int16x4_t rl = vget_low_s16(r);
+        int16x8_t b0 = vld1q_s16(q[0] + i), b1 = vld1q_s16(q[1] + i);
+        int16x8_t b2 = vld1q_s16(q[2] + i), b3 = vld1q_s16(q[3] + i);
+        acc0 = vmlal_high_s16(vmlal_s16(acc0, rl, vget_low_s16(b0)), r, b0);
+        acc1 = vmlal_high_s16(vmlal_s16(acc1, rl, vget_low_s16(b1)), r, b1);
+        acc2 = vmlal_high_s16(vmlal_s16(acc2, rl, vget_low_s16(b2)), r, b2);
+        acc3 = vmlal_high_s16(vmlal_s16(acc3, rl, vget_low_s16(b3)), r, b3);
+    }
+    out[0] = vaddvq_s32(acc0);
+    out[1] = vaddvq_s32(acc1);
+    out[2] = vaddvq_s32(acc2);
+    out[3] = vaddvq_s32(acc3);
+#else
+    for (size_t t = 0; t < 4; ++t) out[t] = dot_i8(row, q[t]);
+#endif
+}
+
+#if defined(CM_INDEX_AVX2_DISPATCH)
+// dot_i8_x4 on 256-bit lanes, for CPUs that have AVX2 (checked at run time)
+__attribute__((target("avx2")))
+void dot_i8_x4_avx2(const int8_t* row, const int16_t* const q[4], int32_t out[4]) {
+    __m256i acc0 = _mm256_setzero_si256(), acc1 = _mm256_setzero_si256();
+    __m256i acc2 = _mm256_setzero_si256(), acc3 = _mm256_setzero_si256();
+    for (size_t i = 0; i < CMIndex::kDim; i += 16) {
+        __m256i r = _mm256_cvtepi8_epi16(_mm_load_si128(reinterpret_cast<const __m128i*>(row + i)));
+        acc0 = _mm256_add_epi32(acc0, _mm256_madd_epi16(r, _mm256_load_si256(reinterpret_cast<const __m256i*>(q[0] + i))));
+        acc1 = _mm256_add_epi32(acc1, _mm256_madd_epi16(r, _mm256_load_si256(reinterpret_cast<const __m256i*>(q[1] + i))));
+        acc2 = _mm256_add_epi32(acc2, _mm256_madd_epi16(r, _mm256_load_si256(reinterpret_cast<const __m256i*>(q[2] + i))));
+        acc3 = _mm256_add_epi32(acc3, _mm256_madd_epi16(r, _mm256_load_si256(reinterpret_cast<const __m256i*>(q[3] + i))));
+    }
+    __m256i s01 = _mm256_hadd_epi32(acc0, acc1);
+    __m256i s23 = _mm256_hadd_epi32(acc2, acc3);
+    __m256i s = _mm256_hadd_epi32(s01, s23);  // Per 128-bit half: q0 q1 q2 q3
+    __m128i sum = _mm_add_epi32(_mm256_castsi256_si128(s), _mm256_extracti128_si256(s, 1));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out), sum);
+}
+#endif
+
+using DotX4 = void (*)(const int8_t*, const int16_t* const*, int32_t*);
+
+DotX4 select_dot_i8_x4() {
+#if defined(CM_INDEX_AVX2_DISPATCH)
+    static const bool avx2 = __builtin_cpu_supports("avx2");
+    if (avx2) return dot_i8_x4_avx2;
+#endif
+    return dot_i8_x4;
+}
+
+inline void push_bounded(MinHeap& heap, size_t limit, float score, uint32_t id) {
+    if (heap.size() < limit) {
+        heap.emplace(score, id);
+    } else if (score > heap.top().first) {
+        heap.pop();
+        heap.emplace(score, id);
+    }
+}
+
+} // namespace
+
 void CMIndex::Add(const std::string& key, const CMVec& v) {
-    std::lock_guard<std::mutex> lock(mu_);
-    kv_[key] = v;
+    std::unique_lock<std::shared_mutex> lock(mu_);
+    auto [it, inserted] = key_ids_.try_emplace(key, static_cast<uint32_t>(keys_.size()));
+    uint32_t id = it->second;
+    if (inserted) {
+        keys_.push_back(key);
+        rows_.emplace_back();
+        qrows_.emplace_back();
+        qscale_.push_back(0.0f);
+    }
+    std::memcpy(rows_[id].v, v.v.data(), sizeof(rows_[id].v));
+    qscale_[id] = quantize(rows_[id].v, qrows_[id].v);
 }
 
 std::vector<std::pair<std::string,float>> CMIndex::TopK(const CMVec& q, int k) const {
-    std::vector<std::pair<std::string,float>> scores;
-    scores.reserve(kv_.size());
-    CMSpace& S = CMSpace::Instance();
-    {
-        std::lock_guard<std::mutex> lock(mu_);
-        for (const auto& it : kv_) {
-            scores.emplace_back(it.first, S.Cosine(q, it.second));
+    return std::move(Search(&q, 1, k)[0]);
+}
+
+std::vector<std::vector<std::pair<std::string,float>>> CMIndex::TopKBatch(
+    const std::vector<CMVec>& queries, int k) const {
+    return Search(queries.data(), queries.size(), k);
+}
+
+std::vector<std::vector<std::pair<std::string,float>>> CMIndex::Search(
+    const CMVec* queries, size_t count, int k) const {
+    std::vector<std::vector<std::pair<std::string,float>>> results(count);
+    if (k <= 0 || count == 0) return results;
+    
+    std::shared_lock<std::shared_mutex> lock(mu_);
+    uint32_t n = static_cast<uint32_t>(rows_.size());
+    size_t keep = std::min<size_t>(n, static_cast<size_t>(k));
+    if (keep == 0) return results;
+    
+    // Rows are visited in blocks that stay cached while every query scores
+    // them, so a batch costs about one pass over the matrix
+    std::vector<MinHeap> heaps(count);
+    if (scan_ == Scan::FP32 || n <= RerankCount(k)) {
+        // Exact scan
+        for (uint32_t block = 0; block < n; block += kRowBlock) {
+            uint32_t end = std::min(n, block + kRowBlock);
+            for (size_t j = 0; j < count; ++j) {
+                const float* qv = queries[j].v.data();
+                for (uint32_t id = block; id < end; ++id) {
+                    push_bounded(heaps[j], keep, dot_f32(rows_[id].v, qv), id);
+                }
+            }
+        }
+    } else {
+        // Approximate scan over the int8 copy, queries widened to int16 once.
+        // A query's scale is common to all rows, so ranking ignores it.
+        std::vector<WideQuery> wide(count);
+        for (size_t j = 0; j < count; ++j) {
+            alignas(64) int8_t q8[kDim];
+            quantize(queries[j].v.data(), q8);
+            for (size_t i = 0; i < kDim; ++i) wide[j].v[i] = q8[i];
+        }
+        
+        std::vector<MinHeap> candidates(count);
+        size_t limit = RerankCount(k);
+        DotX4 dot_x4 = select_dot_i8_x4();
+        for (uint32_t block = 0; block < n; block += kRowBlock) {
+            uint32_t end = std::min(n, block + kRowBlock);
+            if (count == 1) {
+                for (uint32_t id = block; id < end; ++id) {
+                    float approx = static_cast<float>(dot_i8(qrows_[id].v, wide[0].v)) * qscale_[id];
+                    push_bounded(candidates[0], limit, approx, id);
+                }
+                continue;
+            }
+            // Four queries per row load; a short last group repeats its
+            // final query and drops the extra scores
+            for (size_t j = 0; j < count; j += 4) {
+                size_t group = std::min<size_t>(4, count - j);
+                const int16_t* q4[4];
+                for (size_t t = 0; t < 4; ++t) q4[t] = wide[j + std::min(t, group - 1)].v;
+                for (uint32_t id = block; id < end; ++id) {
+                    int32_t dots[4];
+                    dot_x4(qrows_[id].v, q4, dots);
+                    for (size_t t = 0; t < group; ++t) {
+                        push_bounded(candidates[j + t], limit, static_cast<float>(dots[t]) * qscale_[id], id);
+                    }
+                }
+            }
+        }
+        
+        // Re-rank the candidates in fp32
+        for (size_t j = 0; j < count; ++j) {
+            const float* qv = queries[j].v.data();
+            for (; !candidates[j].empty(); candidates[j].pop()) {
+                uint32_t id = candidates[j].top().second;
+                push_bounded(heaps[j], keep, dot_f32(rows_[id].v, qv), id);
+            }
         }
     }
-    if ((int)scores.size() > k) {
-        std::nth_element(scores.begin(), scores.begin() + k, scores.end(),
-            [](const auto& a, const auto& b){ return a.second > b.second; });
-        scores.resize(k);
+    
+    // Only the final k materialize their keys, best first
+    for (size_t j = 0; j < count; ++j) {
+        auto& result = results[j];
+        result.resize(heaps[j].size());
+        for (size_t i = result.size(); i-- > 0; heaps[j].pop()) {
+            result[i] = {keys_[heaps[j].top().second], heaps[j].top().first};
+        }
     }
-    std::sort(scores.begin(), scores.end(), [](const auto& a, const auto& b){ return a.second > b.second; });
-    return scores;
+    return results;
 }
 
-} // namespace crossmodal
-} // namespace melvin
+void CMIndex::SetScan(Scan scan) {
+    std::unique_lock<std::shared_mutex> lock(mu_);
+    scan_ = scan;
+}
 
+size_t CMIndex::Size() const {
+    std::shared_lock<std::shared_mutex> lock(mu_);
+    return rows_.size();
+}
+
+size_t CMIndex::MemoryBytes() const {
+    std::shared_lock<std::shared_mutex> lock(mu_);
+    size_t bytes = rows_.capacity() * sizeof(Row) + qrows_.capacity() * sizeof(QRow) +
+                   qscale_.capacity() * sizeof(float) + keys_.capacity() * sizeof(std::string);
+    for (const auto& key : keys_) {
+        bytes += 2 * key.size();  // Key text, held by keys_ and key_ids_
+    }
+    return bytes + key_ids_.size() * (sizeof(std::pair<const std::string, uint32_t>) + 2 * sizeof(void*));
+}
 
+} // namespace crossmodal
+} // namespace melvin
@@ -5,28 +5,65 @@
 #ifndef MELVIN_CROSSMODAL_CM_INDEX_H
 #define MELVIN_CROSSMODAL_CM_INDEX_H
 
+#include <algorithm>
 #include <string>
 #include <vector>
 #include <unordered_map>
 #include <mutex>
+#include <shared_mutex>
+#include <cstdint>
 #include "cm_space.h"
 
 namespace melvin {
 namespace crossmodal {
 
+class CMIO;
+
+// Vectors live in a contiguous row-major matrix (one 64-byte aligned row
+// per key, row number = key id) with an int8 copy quantized per row. TopK
+// scans the int8 copy, re-ranks the best candidates against the fp32 rows
+// and only then looks up the key strings. Batched queries share each pass
+// over the rows.
 class CMIndex {
 public:
+    static constexpr size_t kDim = 256;  // CMVec width
+
+    enum class Scan { FP32, INT8 };
+
     void Add(const std::string& key, const CMVec& v);
     std::vector<std::pair<std::string,float>> TopK(const CMVec& q, int k) const;
+    // TopK for many queries in one pass over the matrix; results follow
+    // the query order
+    std::vector<std::vector<std::pair<std::string,float>>> TopKBatch(
+        const std::vector<CMVec>& queries, int k) const;
+
+    // FP32 scores every row exactly; INT8 (default) scans the quantized copy
+    void SetScan(Scan scan);
+    // Candidates kept from the int8 scan for the fp32 re-rank; queries with
+    // equal counts can share a batch without changing their results
+    static size_t RerankCount(int k) { return std::max<size_t>(64, 4 * static_cast<size_t>(k)); }
+    size_t Size() const;
+    size_t MemoryBytes() const;
 
 private:
-    std::unordered_map<std::string, CMVec> kv_;
-    mutable std::mutex mu_;
+    friend class CMIO;  // Snapshot save / restore
+
+    struct alignas(64) Row { float v[kDim]; };
+    struct alignas(64) QRow { int8_t v[kDim]; };
+
+    std::unordered_map<std::string, uint32_t> key_ids_;
+    std::vector<std::string> keys_;  // key id -> key
+    std::vector<Row> rows_;
+    std::vector<QRow> qrows_;
+    std::vector<float> qscale_;      // Row value ~= qrows_ value * qscale_
+    Scan scan_ = Scan::INT8;
+    mutable std::shared_mutex mu_;
+
+    std::vector<std::vector<std::pair<std::string,float>>> Search(
+        const CMVec* queries, size_t count, int k) const;
 };
 
 } // namespace crossmodal
 } // namespace melvin
 
 #endif // MELVIN_CROSSMODAL_CM_INDEX_H
-
-
@@ -3,9 +3,22 @@
  */
 
 #include "cm_io.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <deque>
 #include <fstream>
+#include <memory>
 #include <sstream>
 
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define CM_IO_MMAP 1  // Snapshots are read through a read-only mapping
+#endif
+
 namespace melvin {
 namespace crossmodal {
 
@@ -70,9 +83,667 @@ bool CMIO::LoadMotorMap(const std::string& path, CMGrounder& g) {
     return true;
 }
 
-bool CMIO::ExportBindingsTSV(const std::string& path, const CMBindings&) {
-    // Minimal stub: append-only export can be added when needed
-    (void)path;
+// ============================================================================
+// Binding export
+// ============================================================================
+
+static const char* modality_name(Binding::Modality mod) {
+    switch (mod) {
+        case Binding::TEXT:   return "text";
+        case Binding::VISION: return "vision";
+        case Binding::AUDIO:  return "audio";
+        case Binding::MOTOR:  return "motor";
+    }
+    return "unknown";
+}
+
+bool CMIO::ExportBindingsTSV(const std::string& path, const CMBindings& b) {
+    std::ofstream f(path);
+    if (!f.good()) return false;
+
+    std::vector<BindingRef> refs;
+    for (const auto& cs : b.concept_shards_) {
+        std::shared_lock<std::shared_mutex> lock(cs.mu);
+        for (const auto& [concept_id, r] : cs.ranges) {
+            for (uint32_t i = r.begin; i < r.begin + r.size; ++i) {
+                refs.push_back({concept_id, static_cast<Binding::Modality>(cs.mod[i]),
+                                cs.key[i], cs.weight[i], cs.source[i]});
+            }
+        }
+    }
+    std::sort(refs.begin(), refs.end(), [](const BindingRef& x, const BindingRef& y) {
+        if (x.concept_id != y.concept_id) return x.concept_id < y.concept_id;
+        if (x.mod != y.mod) return x.mod < y.mod;
+        if (x.weight != y.weight) return x.weight > y.weight;
+        return x.key_id < y.key_id;
+    });
+
+    f << "# concept_id\tmodality\tkey\tweight\tsource\n";
+    for (const auto& ref : refs) {
+        f << ref.concept_id << '\t' << modality_name(ref.mod) << '\t' << b.keys_.Name(ref.key_id) << '\t'
+          << ref.weight << '\t' << b.sources_.Name(ref.source_id) << '\n';
+    }
+    return f.good();
+}
+
+// ============================================================================
+// Snapshot format
+// ============================================================================
+
+namespace {
+
+// Section tags (stable on disk; append only)
+enum SectionTag : uint32_t {
+    PARAMS = 1,
+    INDEX_META, INDEX_KEY_LENGTHS, INDEX_KEY_TEXT, INDEX_ROWS, INDEX_QROWS, INDEX_QSCALE,
+    POOL_LENGTHS, POOL_TEXT, POOL_TABLE,
+    CONCEPT_RANGES, CONCEPT_KEY, CONCEPT_SOURCE, CONCEPT_WEIGHT, CONCEPT_MOD, CONCEPT_FREE,
+    KEY_HEAD, KEY_FANOUT, KEY_CONCEPT, KEY_WEIGHT, KEY_SOURCE, KEY_NEXT, KEY_MOD, KEY_FREE,
+    MAP_LENGTHS, MAP_TEXT, MAP_VALUES
+};
+
+struct FileHeader {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t reserved;
+    uint32_t section_count;
+    uint32_t shard_count;
+    uint32_t dim;
+    uint32_t reserved2;
+    uint64_t file_size;
+    uint64_t table_checksum;
+};
+
+struct SectionEntry {
+    uint32_t tag;
+    uint32_t elem_size;
+    uint64_t offset;
+    uint64_t count;
+    uint64_t checksum;
+};
+
+struct GrounderParams {
+    uint64_t seed;  // CMSpace seed the index vectors were encoded with
+    float alpha;
+    float beta;
+    float temperature;
+    uint32_t reserved;
+};
+
+struct IndexMeta {
+    uint32_t scan;
+    uint32_t rows;
+};
+
+struct RangeRecord {
+    int64_t concept_id;
+    uint32_t begin;
+    uint8_t size;
+    uint8_t size_class;
+    uint16_t reserved;
+};
+
+struct FreeBlockRecord {
+    uint32_t begin;
+    uint32_t size_class;
+};
+
+constexpr uint64_t kSectionAlign = 64;
+
+inline uint64_t align_section(uint64_t offset) {
+    return (offset + kSectionAlign - 1) & ~(kSectionAlign - 1);
+}
+
+inline uint64_t rotl64(uint64_t x, int r) { return (x << r) | (x >> (64 - r)); }
+
+inline uint64_t load64(const uint8_t* p) {
+    uint64_t v;
+    std::memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+// xxHash64-style: four independent lanes over 32-byte stripes, so the
+// checksum keeps up with the copy it protects
+uint64_t checksum64(const void* data, size_t n) {
+    const uint64_t P1 = 0x9E3779B185EBCA87ULL;
+    const uint64_t P2 = 0xC2B2AE3D27D4EB4FULL;
+    const uint8_t* p = static_cast<const uint8_t*>(data);
+    uint64_t a = P1 + P2, b = P2, c = 0, d = 0 - P1;
+    size_t i = 0;
+    for (; i + 32 <= n; i += 32) {
+        a = rotl64(a + load64(p + i) * P2, 31) * P1;
+        b = rotl64(b + load64(p + i + 8) * P2, 31) * P1;
+        c = rotl64(c + load64(p + i + 16) * P2, 31) * P1;
+        d = rotl64(d + load64(p + i + 24) * P2, 31) * P1;
+    }
+    uint64_t h = rotl64(a, 1) + rotl64(b, 7) + rotl64(c, 12) + rotl64(d, 18) + n;
+    for (; i + 8 <= n; i += 8) h = rotl64(h ^ (rotl64(load64(p + i) * P2, 31) * P1), 27) * P1 + P2;
+    for (; i < n; ++i) h = rotl64(h ^ (p[i] * P1), 11) * P2;
+    h = (h ^ (h >> 33)) * P2;
+    return h ^ (h >> 29);
+}
+
+} // namespace
+
+// Sections are copied out while every shard is read-locked, so the
+// snapshot is one consistent cut; release() drops the locks before the
+// checksums and the disk write
+class SnapshotWriter {
+public:
+    void hold(std::shared_mutex& mu) { locks_.emplace_back(mu); }
+    void release() { locks_.clear(); }
+
+    template<typename T>
+    void add(uint32_t tag, const std::vector<T>& v) { addCopy(tag, v.data(), v.size()); }
+
+    template<typename T>
+    void addCopy(uint32_t tag, const T* data, size_t count) {
+        auto& bytes = owned_.emplace_back(new uint8_t[count * sizeof(T)]);  // Uninitialized
+        if (count > 0) std::memcpy(bytes.get(), data, count * sizeof(T));
+        sections_.push_back({tag, static_cast<uint32_t>(sizeof(T)), bytes.get(), count});
+    }
+
+    template<typename T>
+    void addCopy(uint32_t tag, const std::vector<T>& v) { addCopy(tag, v.data(), v.size()); }
+
+    // Lengths, then the concatenated text
+    template<typename Strings>
+    void addStrings(uint32_t length_tag, uint32_t text_tag, const Strings& strings) {
+        std::vector<uint32_t> lengths;
+        std::vector<char> text;
+        lengths.reserve(strings.size());
+        for (std::string_view s : strings) {
+            lengths.push_back(static_cast<uint32_t>(s.size()));
+            text.insert(text.end(), s.begin(), s.end());
+        }
+        addCopy(length_tag, lengths);
+        addCopy(text_tag, text);
+    }
+
+    bool write(const std::string& path) const;
+
+private:
+    struct Pending {
+        uint32_t tag;
+        uint32_t elem_size;
+        const void* data;
+        uint64_t count;
+    };
+    std::vector<Pending> sections_;
+    std::deque<std::unique_ptr<uint8_t[]>> owned_;
+    std::vector<std::shared_lock<std::shared_mutex>> locks_;
+};
+
+bool SnapshotWriter::write(const std::string& path) const {
+    std::vector<SectionEntry> table(sections_.size());
+    uint64_t offset = align_section(sizeof(FileHeader) + table.size() * sizeof(SectionEntry));
+    for (size_t i = 0; i < sections_.size(); ++i) {
+        const Pending& s = sections_[i];
+        uint64_t bytes = s.count * s.elem_size;
+        table[i] = {s.tag, s.elem_size, offset, s.count, checksum64(s.data, bytes)};
+        offset = align_section(offset + bytes);
+    }
+    FileHeader header{CM_SNAPSHOT_MAGIC, CM_SNAPSHOT_VERSION, 0,
+                      static_cast<uint32_t>(table.size()), CMStringPool::kShards,
+                      static_cast<uint32_t>(CMIndex::kDim), 0, offset,
+                      checksum64(table.data(), table.size() * sizeof(SectionEntry))};
+
+    // Written next to the target, then renamed over it
+    std::string tmp = path + ".tmp";
+    FILE* f = std::fopen(tmp.c_str(), "wb");
+    if (!f) return false;
+    static const char zeros[kSectionAlign] = {};
+    uint64_t pos = 0;
+    bool ok = true;
+    auto put = [&](const void* data, uint64_t bytes) {
+        if (ok && bytes > 0) ok = std::fwrite(data, 1, bytes, f) == bytes;
+        pos += bytes;
+    };
+    put(&header, sizeof(header));
+    put(table.data(), table.size() * sizeof(SectionEntry));
+    for (size_t i = 0; i < sections_.size(); ++i) {
+        put(zeros, table[i].offset - pos);
+        put(sections_[i].data, table[i].count * table[i].elem_size);
+    }
+    put(zeros, header.file_size - pos);
+    // The data must be on disk before the rename makes it the snapshot,
+    // and the rename before the caller relies on it
+    ok = ok && std::fflush(f) == 0 && ::fsync(fileno(f)) == 0;
+    ok = std::fclose(f) == 0 && ok;
+    if (!ok || std::rename(tmp.c_str(), path.c_str()) != 0) {
+        std::remove(tmp.c_str());
+        return false;
+    }
+    size_t slash = path.find_last_of('/');
+    std::string dir = slash == std::string::npos ? "." : slash == 0 ? "/" : path.substr(0, slash);
+    int dir_fd = ::open(dir.c_str(), O_RDONLY | O_DIRECTORY);
+    if (dir_fd < 0) return false;
+    ok = ::fsync(dir_fd) == 0;
+    ::close(dir_fd);
+    return ok;
+}
+
+// Maps a snapshot read-only and verifies it up front; sections are then
+// consumed in file order, each copied out with one memcpy
+class SnapshotReader {
+public:
+    SnapshotReader() = default;
+    SnapshotReader(const SnapshotReader&) = delete;
+    SnapshotReader& operator=(const SnapshotReader&) = delete;
+    ~SnapshotReader();
+
+    bool open(const std::string& path);
+
+    // Next section, which must carry this tag and element size
+    template<typename T>
+    bool next(uint32_t tag, std::vector<T>& out) {
+        if (next_ >= table_.size()) return false;
+        const SectionEntry& e = table_[next_++];
+        if (e.tag != tag || e.elem_size != sizeof(T)) return false;
+        // Payloads are 64-byte aligned in the file; assign copies without
+        // zero-filling first
+        const T* first = reinterpret_cast<const T*>(data_ + e.offset);
+        out.assign(first, first + e.count);
+        return true;
+    }
+
+    bool nextStrings(uint32_t length_tag, uint32_t text_tag,
+                     std::vector<uint32_t>& lengths, std::vector<char>& text) {
+        if (!next(length_tag, lengths) || !next(text_tag, text)) return false;
+        uint64_t total = 0;
+        for (uint32_t length : lengths) total += length;
+        return total == text.size();
+    }
+
+    bool done() const { return next_ == table_.size(); }
+
+private:
+    const uint8_t* data_ = nullptr;
+    size_t size_ = 0;
+    bool mapped_ = false;
+    struct alignas(kSectionAlign) Block { uint8_t bytes[kSectionAlign]; };
+    std::vector<Block> buffer_;  // File contents when it cannot be mapped
+    std::vector<SectionEntry> table_;
+    size_t next_ = 0;
+};
+
+SnapshotReader::~SnapshotReader() {
+#if defined(CM_IO_MMAP)
+    if (mapped_) munmap(const_cast<uint8_t*>(data_), size_);
+#endif
+}
+
+bool SnapshotReader::open(const std::string& path) {
+#if defined(CM_IO_MMAP)
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+    struct stat st;
+    if (fstat(fd, &st) == 0 && st.st_size > 0) {
+        int flags = MAP_PRIVATE;
+#if defined(MAP_POPULATE)
+        flags |= MAP_POPULATE;  // Every page is read by the checksum pass anyway
+#endif
+        void* p = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, flags, fd, 0);
+        if (p != MAP_FAILED) {
+            data_ = static_cast<const uint8_t*>(p);
+            size_ = static_cast<size_t>(st.st_size);
+            mapped_ = true;
+        }
+    }
+    ::close(fd);
+    if (!mapped_) return false;
+#else
+    std::ifstream f(path, std::ios::binary | std::ios::ate);
+    if (!f.good()) return false;
+    size_ = static_cast<size_t>(f.tellg());
+    buffer_.resize((size_ + kSectionAlign - 1) / kSectionAlign);
+    f.seekg(0);
+    if (!f.read(reinterpret_cast<char*>(buffer_.data()), size_)) return false;
+    data_ = buffer_.data()->bytes;
+#endif
+
+    FileHeader header;
+    if (size_ < sizeof(header)) return false;
+    std::memcpy(&header, data_, sizeof(header));
+    if (header.magic != CM_SNAPSHOT_MAGIC || header.version != CM_SNAPSHOT_VERSION ||
+        header.shard_count != CMStringPool::kShards || header.dim != CMIndex::kDim ||
+        header.file_size != size_ ||
+        header.section_count > (size_ - sizeof(header)) / sizeof(SectionEntry)) {
+        return false;
+    }
+
+    table_.resize(header.section_count);
+    std::memcpy(table_.data(), data_ + sizeof(header), table_.size() * sizeof(SectionEntry));
+    if (checksum64(table_.data(), table_.size() * sizeof(SectionEntry)) != header.table_checksum) return false;
+    for (const SectionEntry& e : table_) {
+        if (e.elem_size == 0 || e.offset > size_ || e.count > (size_ - e.offset) / e.elem_size) return false;
+        if (checksum64(data_ + e.offset, e.count * e.elem_size) != e.checksum) return false;
+    }
+    return true;
+}
+
+// ============================================================================
+// Snapshot save / restore
+// ============================================================================
+
+bool CMIO::SaveSnapshot(const std::string& path, const CMGrounder& g) {
+    SnapshotWriter out;
+    GrounderParams params{CMSpace::Instance().Seed(), g.alpha_, g.beta_, g.temperature_, 0};
+    out.addCopy(PARAMS, &params, 1);
+    writeIndex(out, g.vision_idx_);
+    writeIndex(out, g.audio_idx_);
+    writeIndex(out, g.motor_idx_);
+    writeBindings(out, g.bindings_);
+    writeMap(out, g.context_relevance_);
+    writeMap(out, g.temporal_consistency_);
+    out.release();
+    return out.write(path);
+}
+
+bool CMIO::LoadSnapshot(const std::string& path, CMGrounder& g) {
+    SnapshotReader in;
+    if (!in.open(path)) return false;
+
+    // Restore into a private grounder, then swap: a bad file changes nothing
+    auto staged = std::make_unique<CMGrounder>();
+    std::vector<GrounderParams> params;
+    if (!in.next(PARAMS, params) || params.size() != 1 ||
+        !readIndex(in, staged->vision_idx_) ||
+        !readIndex(in, staged->audio_idx_) ||
+        !readIndex(in, staged->motor_idx_) ||
+        !readBindings(in, staged->bindings_) ||
+        !readMap(in, staged->context_relevance_) ||
+        !readMap(in, staged->temporal_consistency_) ||
+        !in.done()) {
+        return false;
+    }
+
+    // Seed first: a query that sees the restored indices must encode with
+    // the seed they were built under
+    CMSpace::Instance().SetSeed(params[0].seed);
+    swapIndex(g.vision_idx_, staged->vision_idx_);
+    swapIndex(g.audio_idx_, staged->audio_idx_);
+    swapIndex(g.motor_idx_, staged->motor_idx_);
+    swapBindings(g.bindings_, staged->bindings_);
+    g.context_relevance_.swap(staged->context_relevance_);
+    g.temporal_consistency_.swap(staged->temporal_consistency_);
+    g.alpha_ = params[0].alpha;
+    g.beta_ = params[0].beta;
+    g.temperature_ = params[0].temperature;
+    return true;
+}
+
+void CMIO::writeIndex(SnapshotWriter& out, const CMIndex& index) {
+    out.hold(index.mu_);
+    IndexMeta meta{static_cast<uint32_t>(index.scan_), static_cast<uint32_t>(index.rows_.size())};
+    out.addCopy(INDEX_META, &meta, 1);
+    out.addStrings(INDEX_KEY_LENGTHS, INDEX_KEY_TEXT, index.keys_);
+    out.add(INDEX_ROWS, index.rows_);
+    out.add(INDEX_QROWS, index.qrows_);
+    out.add(INDEX_QSCALE, index.qscale_);
+}
+
+bool CMIO::readIndex(SnapshotReader& in, CMIndex& index) {
+    std::vector<IndexMeta> meta;
+    std::vector<uint32_t> lengths;
+    std::vector<char> text;
+    if (!in.next(INDEX_META, meta) || meta.size() != 1 ||
+        !in.nextStrings(INDEX_KEY_LENGTHS, INDEX_KEY_TEXT, lengths, text) ||
+        !in.next(INDEX_ROWS, index.rows_) || !in.next(INDEX_QROWS, index.qrows_) ||
+        !in.next(INDEX_QSCALE, index.qscale_)) {
+        return false;
+    }
+    size_t rows = meta[0].rows;
+    if (meta[0].scan > static_cast<uint32_t>(CMIndex::Scan::INT8) || lengths.size() != rows ||
+        index.rows_.size() != rows || index.qrows_.size() != rows || index.qscale_.size() != rows) {
+        return false;
+    }
+
+    index.scan_ = static_cast<CMIndex::Scan>(meta[0].scan);
+    index.keys_.reserve(rows);
+    index.key_ids_.reserve(rows);
+    const char* p = text.data();
+    for (uint32_t id = 0; id < rows; ++id) {
+        index.keys_.emplace_back(p, lengths[id]);
+        p += lengths[id];
+        if (!index.key_ids_.emplace(index.keys_.back(), id).second) return false;
+    }
+    return true;
+}
+
+void CMIO::swapIndex(CMIndex& a, CMIndex& b) {
+    std::unique_lock<std::shared_mutex> lock(a.mu_);  // b is private to the caller
+    a.key_ids_.swap(b.key_ids_);
+    a.keys_.swap(b.keys_);
+    a.rows_.swap(b.rows_);
+    a.qrows_.swap(b.qrows_);
+    a.qscale_.swap(b.qscale_);
+    std::swap(a.scan_, b.scan_);
+}
+
+void CMIO::writePool(SnapshotWriter& out, const CMStringPool& pool) {
+    for (const auto& shard : pool.shards_) {
+        out.hold(shard.mu);
+        out.addStrings(POOL_LENGTHS, POOL_TEXT, shard.names);
+        out.add(POOL_TABLE, shard.table);
+    }
+}
+
+bool CMIO::readPool(SnapshotReader& in, CMStringPool& pool) {
+    for (auto& shard : pool.shards_) {
+        std::vector<uint32_t> lengths;
+        std::vector<char> text;
+        if (!in.nextStrings(POOL_LENGTHS, POOL_TEXT, lengths, text) || !in.next(POOL_TABLE, shard.table)) {
+            return false;
+        }
+        // The hash table is restored as is: power of two, at most half full
+        size_t table_size = shard.table.size();
+        if ((table_size & (table_size - 1)) != 0 || lengths.size() * 2 > table_size) return false;
+        for (uint32_t entry : shard.table) {
+            if (entry > lengths.size()) return false;
+        }
+
+        // All restored text in one chunk; new strings start a fresh one
+        const char* p = nullptr;
+        if (!text.empty()) {
+            shard.chunks.emplace_back(new char[text.size()]);
+            std::memcpy(shard.chunks.back().get(), text.data(), text.size());
+            shard.chunk_bytes = text.size();
+            p = shard.chunks.back().get();
+        }
+        shard.chunk_used = CMStringPool::kChunkBytes;
+        shard.names.reserve(lengths.size());
+        for (uint32_t length : lengths) {
+            shard.names.emplace_back(p, length);
+            p += length;
+        }
+    }
+    return true;
+}
+
+void CMIO::writeBindings(SnapshotWriter& out, const CMBindings& bindings) {
+    writePool(out, bindings.keys_);
+    writePool(out, bindings.sources_);
+
+    for (const auto& cs : bindings.concept_shards_) {
+        out.hold(cs.mu);
+        std::vector<RangeRecord> ranges;
+        ranges.reserve(cs.ranges.size());
+        for (const auto& [concept_id, r] : cs.ranges) {
+            ranges.push_back({concept_id, r.begin, r.size, r.size_class, 0});
+        }
+        std::vector<FreeBlockRecord> free_blocks;
+        for (uint32_t size_class = 0; size_class < cs.free_blocks.size(); ++size_class) {
+            for (uint32_t begin : cs.free_blocks[size_class]) free_blocks.push_back({begin, size_class});
+        }
+        out.addCopy(CONCEPT_RANGES, ranges);
+        out.add(CONCEPT_KEY, cs.key);
+        out.add(CONCEPT_SOURCE, cs.source);
+        out.add(CONCEPT_WEIGHT, cs.weight);
+        out.add(CONCEPT_MOD, cs.mod);
+        out.addCopy(CONCEPT_FREE, free_blocks);
+    }
+
+    for (const auto& ks : bindings.key_shards_) {
+        out.hold(ks.mu);
+        out.add(KEY_HEAD, ks.head);
+        out.add(KEY_FANOUT, ks.fanout);
+        out.add(KEY_CONCEPT, ks.concept_id);
+        out.add(KEY_WEIGHT, ks.weight);
+        out.add(KEY_SOURCE, ks.source);
+        out.add(KEY_NEXT, ks.next);
+        out.add(KEY_MOD, ks.mod);
+        out.add(KEY_FREE, ks.free_refs);
+    }
+}
+
+bool CMIO::readBindings(SnapshotReader& in, CMBindings& bindings) {
+    using ConceptShard = CMBindings::ConceptShard;
+    if (!readPool(in, bindings.keys_) || !readPool(in, bindings.sources_)) return false;
+
+    for (auto& cs : bindings.concept_shards_) {
+        std::vector<RangeRecord> ranges;
+        std::vector<FreeBlockRecord> free_blocks;
+        if (!in.next(CONCEPT_RANGES, ranges) || !in.next(CONCEPT_KEY, cs.key) ||
+            !in.next(CONCEPT_SOURCE, cs.source) || !in.next(CONCEPT_WEIGHT, cs.weight) ||
+            !in.next(CONCEPT_MOD, cs.mod) || !in.next(CONCEPT_FREE, free_blocks)) {
+            return false;
+        }
+        size_t cells = cs.key.size();
+        if (cs.source.size() != cells || cs.weight.size() != cells || cs.mod.size() != cells) return false;
+
+        cs.ranges.reserve(ranges.size());
+        for (const auto& r : ranges) {
+            if (r.size_class >= ConceptShard::kSizeClasses || r.size > (1u << r.size_class) ||
+                r.size > CMBindings::kMaxPerConcept || r.begin + (size_t(1) << r.size_class) > cells) {
+                return false;
+            }
+            if (!cs.ranges.emplace(r.concept_id, ConceptShard::Range{r.begin, r.size, r.size_class}).second) {
+                return false;
+            }
+            cs.live += r.size;
+        }
+        for (const auto& block : free_blocks) {
+            if (block.size_class >= ConceptShard::kSizeClasses ||
+                block.begin + (size_t(1) << block.size_class) > cells) {
+                return false;
+            }
+            cs.free_blocks[block.size_class].push_back(block.begin);
+        }
+    }
+
+    for (auto& ks : bindings.key_shards_) {
+        if (!in.next(KEY_HEAD, ks.head) || !in.next(KEY_FANOUT, ks.fanout) ||
+            !in.next(KEY_CONCEPT, ks.concept_id) || !in.next(KEY_WEIGHT, ks.weight) ||
+            !in.next(KEY_SOURCE, ks.source) || !in.next(KEY_NEXT, ks.next) ||
+            !in.next(KEY_MOD, ks.mod) || !in.next(KEY_FREE, ks.free_refs)) {
+            return false;
+        }
+        size_t refs = ks.concept_id.size();
+        if (ks.fanout.size() != ks.head.size() || ks.weight.size() != refs || ks.source.size() != refs ||
+            ks.next.size() != refs || ks.mod.size() != refs) {
+            return false;
+        }
+        auto valid = [&](uint32_t r) { return r == CMBindings::kNil || r < refs; };
+        if (!std::all_of(ks.head.begin(), ks.head.end(), valid) ||
+            !std::all_of(ks.next.begin(), ks.next.end(), valid) ||
+            !std::all_of(ks.free_refs.begin(), ks.free_refs.end(), [&](uint32_t r) { return r < refs; })) {
+            return false;
+        }
+
+        // Every ref sits on at most one chain, and each chain holds exactly
+        // fanout refs: upsert relies on a full key having a weakest ref
+        std::vector<uint8_t> seen(refs, 0);
+        for (size_t local = 0; local < ks.head.size(); ++local) {
+            size_t length = 0;
+            for (uint32_t r = ks.head[local]; r != CMBindings::kNil; r = ks.next[r]) {
+                if (seen[r] || ++length > CMBindings::kMaxPerKey) return false;
+                seen[r] = 1;
+            }
+            if (length != ks.fanout[local]) return false;
+        }
+        for (uint32_t r : ks.free_refs) {
+            if (seen[r]) return false;
+            seen[r] = 1;
+        }
+    }
+    return true;
+}
+
+void CMIO::swapBindings(CMBindings& a, CMBindings& b) {
+    // a may be in use: lock all of it, concept shards before key shards as
+    // Upsert does, so readers see either the old or the restored state
+    std::vector<std::unique_lock<std::shared_mutex>> locks;
+    for (auto& cs : a.concept_shards_) locks.emplace_back(cs.mu);
+    for (auto& ks : a.key_shards_) locks.emplace_back(ks.mu);
+    for (auto& shard : a.keys_.shards_) locks.emplace_back(shard.mu);
+    for (auto& shard : a.sources_.shards_) locks.emplace_back(shard.mu);
+
+    for (size_t i = 0; i < CMBindings::kShards; ++i) {
+        auto& x = a.concept_shards_[i];
+        auto& y = b.concept_shards_[i];
+        x.ranges.swap(y.ranges);
+        x.key.swap(y.key);
+        x.source.swap(y.source);
+        x.weight.swap(y.weight);
+        x.mod.swap(y.mod);
+        x.free_blocks.swap(y.free_blocks);
+        std::swap(x.live, y.live);
+    }
+    for (size_t i = 0; i < CMBindings::kShards; ++i) {
+        auto& x = a.key_shards_[i];
+        auto& y = b.key_shards_[i];
+        x.head.swap(y.head);
+        x.fanout.swap(y.fanout);
+        x.concept_id.swap(y.concept_id);
+        x.weight.swap(y.weight);
+        x.source.swap(y.source);
+        x.next.swap(y.next);
+        x.mod.swap(y.mod);
+        x.free_refs.swap(y.free_refs);
+    }
+    auto swap_pool = [](CMStringPool& x, CMStringPool& y) {
+        for (size_t i = 0; i < CMStringPool::kShards; ++i) {
+            auto& s = x.shards_[i];
+            auto& t = y.shards_[i];
+            s.chunks.swap(t.chunks);
+            std::swap(s.chunk_used, t.chunk_used);
+            std::swap(s.chunk_bytes, t.chunk_bytes);
+            s.names.swap(t.names);
+            s.table.swap(t.table);
+        }
+    };
+    swap_pool(a.keys_, b.keys_);
+    swap_pool(a.sources_, b.sources_);
+}
+
+void CMIO::writeMap(SnapshotWriter& out, const std::unordered_map<std::string, float>& map) {
+    std::vector<std::string_view> keys;
+    std::vector<float> values;
+    keys.reserve(map.size());
+    values.reserve(map.size());
+    for (const auto& [key, value] : map) {
+        keys.push_back(key);
+        values.push_back(value);
+    }
+    out.addStrings(MAP_LENGTHS, MAP_TEXT, keys);
+    out.addCopy(MAP_VALUES, values);
+}
+
+bool CMIO::readMap(SnapshotReader& in, std::unordered_map<std::string, float>& map) {
+    std::vector<uint32_t> lengths;
+    std::vector<char> text;
+    std::vector<float> values;
+    if (!in.nextStrings(MAP_LENGTHS, MAP_TEXT, lengths, text) || !in.next(MAP_VALUES, values) ||
+        values.size() != lengths.size()) {
+        return false;
+    }
+    map.reserve(lengths.size());
+    const char* p = text.data();
+    for (size_t i = 0; i < lengths.size(); ++i) {
+        map.emplace(std::string(p, lengths[i]), values[i]);
+        p += lengths[i];
+    }
     return true;
 }
 
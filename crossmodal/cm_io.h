@@ -1,22 +1,70 @@
 /**
  * @file cm_io.h
+ *
+ * Snapshot format (host byte order, every offset 64-byte aligned so
+ * sections can be used straight from a read-only mapping):
+ *   Header:   u32 magic "MCMS", u16 version, u16 reserved, u32 section
+ *             count, u32 shard count, u32 vector width, u32 reserved,
+ *             u64 file size, u64 checksum of the section table
+ *   Table:    per section u32 tag, u32 element size, u64 offset,
+ *             u64 element count, u64 checksum of the payload
+ *   Payloads: raw arrays, in a fixed order: grounder parameters (incl.
+ *             the CMSpace seed), the vision / audio / motor indices,
+ *             the key and source pools, the binding shards, then the
+ *             context and temporal maps.
+ * A snapshot is only restored once every checksum matches.
  */
 
 #ifndef MELVIN_CROSSMODAL_CM_IO_H
 #define MELVIN_CROSSMODAL_CM_IO_H
 
 #include <string>
+#include <unordered_map>
 #include "cm_grounder.h"
 
 namespace melvin {
 namespace crossmodal {
 
+constexpr uint32_t CM_SNAPSHOT_MAGIC = 0x534D434Du;  // "MCMS"
+constexpr uint16_t CM_SNAPSHOT_VERSION = 1;
+
+class SnapshotWriter;
+class SnapshotReader;
+
 class CMIO {
 public:
     static bool LoadVisionMap(const std::string& path, CMGrounder& g);
     static bool LoadAudioMap(const std::string& path, CMGrounder& g);
     static bool LoadMotorMap(const std::string& path, CMGrounder& g);
+    // concept_id, modality, key, weight, source per line, by concept
     static bool ExportBindingsTSV(const std::string& path, const CMBindings& b);
+
+    // Full grounder state; the file is replaced atomically and durably
+    // (temp file fsynced, renamed over the target, directory fsynced).
+    // Adds and upserts stall only while the state is copied out; the
+    // copy (about one snapshot in size) is then written unlocked.
+    static bool SaveSnapshot(const std::string& path, const CMGrounder& g);
+    // Replaces g's state and sets the CMSpace seed. On a missing, stale
+    // or corrupt file nothing is changed and false is returned. Indices and
+    // bindings are swapped under their own locks, but the context/temporal
+    // maps and weights are assigned like SetContextRelevance / SetWeights:
+    // do not restore while Predict* runs on g.
+    static bool LoadSnapshot(const std::string& path, CMGrounder& g);
+
+private:
+    static void writeIndex(SnapshotWriter& out, const CMIndex& index);
+    static void writePool(SnapshotWriter& out, const CMStringPool& pool);
+    static void writeBindings(SnapshotWriter& out, const CMBindings& bindings);
+    static void writeMap(SnapshotWriter& out, const std::unordered_map<std::string, float>& map);
+
+    // Fill freshly constructed objects; false on inconsistent sections
+    static bool readIndex(SnapshotReader& in, CMIndex& index);
+    static bool readPool(SnapshotReader& in, CMStringPool& pool);
+    static bool readBindings(SnapshotReader& in, CMBindings& bindings);
+    static bool readMap(SnapshotReader& in, std::unordered_map<std::string, float>& map);
+
+    static void swapIndex(CMIndex& a, CMIndex& b);
+    static void swapBindings(CMBindings& a, CMBindings& b);
 };
 
 } // namespace crossmodal
@@ -24,4 +72,3 @@ public:
 
 #endif // MELVIN_CROSSMODAL_CM_IO_H
 
-
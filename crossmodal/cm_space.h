@@ -7,7 +7,13 @@
 #define MELVIN_CROSSMODAL_CM_SPACE_H
 
 #include <array>
+#include <atomic>
+#include <cstdint>
+#include <list>
+#include <mutex>
 #include <string>
+#include <unordered_map>
+#include <vector>
 
 namespace melvin {
 namespace crossmodal {
@@ -29,11 +35,38 @@ public:
     void LoadCalib(const std::string& path);
 
     void SetSeed(uint64_t seed);
+    uint64_t Seed() const { return seed_.load(std::memory_order_relaxed); }
+
+    // Encoded vectors are cached by key hash in LRU shards holding
+    // max_entries in total (~1 KB each), admitted when a key misses twice;
+    // 0 disables the cache
+    void SetCacheCapacity(size_t max_entries);
+    size_t CacheSize() const;
 
 private:
     CMSpace() = default;
     CMVec encodeDeterministic(const std::string& key, uint64_t salt) const;
-    uint64_t seed_{42};
+    std::atomic<uint64_t> seed_{42};  // May be reset by a snapshot restore
+
+    // The hash of (seed, salt, key) determines the vector, so it is the
+    // cache key; equal hashes always encode to equal vectors
+    static constexpr size_t kCacheShards = 16;
+    struct CacheShard {
+        std::mutex mu;
+        std::list<std::pair<uint64_t, CMVec>> lru;  // Most recent first
+        std::unordered_map<uint64_t, std::list<std::pair<uint64_t, CMVec>>::iterator> index;
+        // Hashes missed once, kSeenWays-way set associative; sized to twice
+        // the shard's capacity so colliding keys do not evict each other
+        std::vector<uint64_t> seen;
+        size_t seen_victim = 0;
+    };
+    static constexpr size_t kSeenWays = 8;
+    static size_t seenSlots(size_t per_shard);
+    mutable std::array<CacheShard, kCacheShards> cache_;
+    std::atomic<size_t> cache_capacity_{8192};
+
+    bool cacheLookup(uint64_t h, CMVec& out) const;
+    void cacheInsert(uint64_t h, const CMVec& v) const;
 };
 
 } // namespace crossmodal
@@ -15,8 +15,10 @@
 #include <unistd.h>
 #include <thread>
 #include <chrono>
+#include <fstream>
 #include <opencv2/opencv.hpp>
 #include <cstring>
+#include <cstdlib>
 #include <cmath>
 
 // Linux-specific headers (only on actual Jetson)
@@ -27,10 +29,12 @@
 #include <sys/socket.h>
 #include <net/if.h>
 #include <sys/ioctl.h>
+#include <poll.h>
 #endif
 
 #include "cognitive_os/cognitive_os.h"
 #include "core/unified_intelligence.h"
+#include "core/metrics/trace.h"
 #include "storage/graph_loader.h"
 
 using namespace melvin::cognitive_os;
@@ -98,6 +102,7 @@ bool load_knowledge_graph(
     // Prefer unified binary files if available
     const std::string nodes_bin = "data/unified_nodes.bin";
     const std::string edges_bin = "data/unified_edges.bin";
+    const std::string embeddings_bin = "data/unified_embeddings.bin";  // Optional (tools/graph_gen)
     std::ifstream fn(nodes_bin, std::ios::binary);
     std::ifstream fe(edges_bin, std::ios::binary);
     if (fn.good() && fe.good()) {
@@ -110,6 +115,10 @@ bool load_knowledge_graph(
             std::cerr << "   ❌ Failed to read nodes.bin, falling back to demo graph\n";
         } else if (!loader.LoadEdgesBIN(edges_bin, graph, true)) {
             std::cerr << "   ❌ Failed to read edges.bin, falling back to demo graph\n";
+        } else if (loader.LoadEmbeddingsBIN(embeddings_bin, embeddings)) {
+            std::cout << "   ✅ " << id_to_word.size() << " concepts loaded (with embeddings)\n";
+            std::cout << "   ✅ Knowledge graph ready\n\n";
+            return true;
         } else {
             // Create simple text embeddings from labels deterministically (placeholder)
             for (const auto& kv : id_to_word) {
@@ -175,6 +184,7 @@ bool load_knowledge_graph(
  * Vision capture thread - continuously captures from USB cameras
  */
 void vision_capture_loop(EventBus* bus, const std::vector<std::string>& camera_devices) {
+    MELVIN_TRACE_THREAD_NAME("vision_capture");
     std::vector<cv::VideoCapture> cameras;
     
     // Open cameras
@@ -205,6 +215,7 @@ void vision_capture_loop(EventBus* bus, const std::vector<std::string>& camera_d
         }
         
         last_capture = now;
+        MELVIN_TRACE_SCOPE("hw.vision_capture");
         
         // Capture from all cameras
         for (size_t i = 0; i < cameras.size(); i++) {
@@ -219,7 +230,7 @@ void vision_capture_loop(EventBus* bus, const std::vector<std::string>& camera_d
                 vision.obj_ids = {};  // Would be populated by vision pipeline
                 vision.embeddings = {};  // Would be vision embeddings
                 
-                bus->publish(topics::VISION_EVENTS, vision);
+                bus->publish(topic_ids::VISION_EVENTS, vision);
             }
         }
     }
@@ -229,6 +240,7 @@ void vision_capture_loop(EventBus* bus, const std::vector<std::string>& camera_d
  * Audio input capture thread - continuously listens from USB microphone
  */
 void audio_input_loop(EventBus* bus, const std::string& alsa_device) {
+    MELVIN_TRACE_THREAD_NAME("audio_input");
 #ifdef __linux__
     snd_pcm_t* pcm_handle;
     snd_pcm_hw_params_t* hw_params;
@@ -254,6 +266,8 @@ void audio_input_loop(EventBus* bus, const std::string& alsa_device) {
         snd_pcm_sframes_t frames = snd_pcm_readi(pcm_handle, buffer.data(), buffer.size());
         
         if (frames > 0) {
+            MELVIN_TRACE_SCOPE("hw.audio_input");
+            
             // Calculate energy
             float energy = 0.0f;
             for (int i = 0; i < frames; i++) {
@@ -271,14 +285,14 @@ void audio_input_loop(EventBus* bus, const std::string& alsa_device) {
                 audio.phonemes = {};  // TODO: Speech recognition
                 audio.embedding = {};  // TODO: Audio embedding
                 
-                bus->publish(topics::AUDIO_EVENTS, audio);
+                bus->publish(topic_ids::AUDIO_EVENTS, audio);
                 
                 // Trigger cognitive query from audio
                 CogQuery query;
                 query.timestamp = audio.timestamp;
                 query.text = "";  // TODO: Speech-to-text
                 query.intent = 0;
-                bus->publish(topics::COG_QUERY, query);
+                bus->publish(topic_ids::COG_QUERY, query);
             }
         }
     }
@@ -298,6 +312,7 @@ void audio_input_loop(EventBus* bus, const std::string& alsa_device) {
  * Audio output thread - speaks responses from cognitive system
  */
 void audio_output_loop(EventBus* bus, const std::string& alsa_device) {
+    MELVIN_TRACE_THREAD_NAME("audio_output");
 #ifdef __linux__
     snd_pcm_t* pcm_handle;
     
@@ -319,11 +334,18 @@ void audio_output_loop(EventBus* bus, const std::string& alsa_device) {
     (void)alsa_device;
 #endif
     
+    // Event-driven: sleep on the subscription wakeup instead of polling
+    SubscriptionOptions options;
+    options.name = "audio_output";
+    options.policy = DeliveryPolicy::DROP_OLDEST;
+    options.queue_capacity = 64;
+    auto answers = bus->open_subscription(topics::COG_ANSWER, options);
+    
     while (g_running.load()) {
-        // Poll for cognitive answers and output them
-        auto answers = bus->poll(topics::COG_ANSWER);
+        if (!answers->wait_for(100.0)) continue;
+        MELVIN_TRACE_SCOPE("hw.audio_output");
         
-        for (const auto& event : answers) {
+        answers->drain([&](const Event& event) {
             auto answer = event.get<CogAnswer>();
             if (answer && !answer->text.empty()) {
                 // Generate text output (colored, ChatGPT-style)
@@ -335,11 +357,11 @@ void audio_output_loop(EventBus* bus, const std::string& alsa_device) {
                 // For now, text output works everywhere
 #endif
             }
-        }
-        
-        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        });
     }
     
+    bus->unsubscribe(answers);
+    
 #ifdef __linux__
     snd_pcm_close(pcm_handle);
 #endif
@@ -349,10 +371,31 @@ void audio_output_loop(EventBus* bus, const std::string& alsa_device) {
  * Motor control thread - sends commands and reads feedback via CAN bus
  */
 void motor_control_loop(EventBus* bus, const std::string& can_interface) {
+    MELVIN_TRACE_THREAD_NAME("motor_control");
+    // Only the newest motor target matters: coalesce instead of queueing
+    SubscriptionOptions options;
+    options.name = "motor_control";
+    options.policy = DeliveryPolicy::COALESCE_LATEST;
+    auto motor_states = bus->open_subscription(topics::MOTOR_STATE, options);
+    
+    auto handle_motor_state = [](const Event& event) {
+        auto motor_state = event.get<MotorState>();
+        if (motor_state && !motor_state->joint_pos.empty()) {
+            std::cout << "🦾 \033[1;33mMotor Action:\033[0m ";
+            for (size_t i = 0; i < motor_state->joint_pos.size(); i++) {
+                std::cout << "J" << i << "=" << motor_state->joint_pos[i];
+                if (i < motor_state->joint_pos.size() - 1) std::cout << ", ";
+            }
+            std::cout << "\n";
+            // TODO: Send joint targets via CAN
+        }
+    };
+    
 #ifdef __linux__
     int s = socket(PF_CAN, SOCK_RAW, CAN_RAW);
     if (s < 0) {
         std::cerr << "   ⚠️  Failed to open CAN socket\n";
+        bus->unsubscribe(motor_states);
         return;
     }
     
@@ -367,46 +410,49 @@ void motor_control_loop(EventBus* bus, const std::string& can_interface) {
     if (bind(s, (struct sockaddr *)&addr, sizeof(addr)) < 0) {
         std::cerr << "   ⚠️  Failed to bind CAN socket\n";
         close(s);
+        bus->unsubscribe(motor_states);
         return;
     }
     
+    // Wait on CAN frames and motor commands together (no sleep loop)
+    struct pollfd fds[2];
+    fds[0].fd = s;
+    fds[0].events = POLLIN;
+    fds[1].fd = motor_states->fd();
+    fds[1].events = POLLIN;
+    
     while (g_running.load()) {
+        fds[0].revents = 0;
+        fds[1].revents = 0;
+        if (poll(fds, fds[1].fd >= 0 ? 2 : 1, 100) < 0) continue;
+        MELVIN_TRACE_SCOPE("hw.motor_control");
+        
         // Read motor feedback from CAN
-        struct can_frame frame;
-        if (read(s, &frame, sizeof(frame)) > 0) {
-            // TODO: Parse Robstride feedback, publish MOTOR_FEEDBACK event
+        if (fds[0].revents & POLLIN) {
+            struct can_frame frame;
+            if (read(s, &frame, sizeof(frame)) > 0) {
+                // TODO: Parse Robstride feedback, publish MOTOR_FEEDBACK event
+            }
         }
         
-        // Check for motor commands from cognitive system
-        // TODO: Subscribe to motor command events and send via CAN
-        
-        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        // Motor commands from cognitive system
+        motor_states->drain(handle_motor_state);
     }
     
     close(s);
 #else
     (void)can_interface;
     std::cout << "   ℹ️  Motor control: Text output mode\n";
-#endif
     
     // Text output mode (fallback for no hardware)
     while (g_running.load()) {
-        auto motor_events = bus->poll(topics::MOTOR_STATE);
-        
-        for (const auto& event : motor_events) {
-            auto motor_state = event.get<MotorState>();
-            if (motor_state && !motor_state->joint_pos.empty()) {
-                std::cout << "🦾 \033[1;33mMotor Action:\033[0m ";
-                for (size_t i = 0; i < motor_state->joint_pos.size(); i++) {
-                    std::cout << "J" << i << "=" << motor_state->joint_pos[i];
-                    if (i < motor_state->joint_pos.size() - 1) std::cout << ", ";
-                }
-                std::cout << "\n";
-            }
+        if (motor_states->wait_for(100.0)) {
+            motor_states->drain(handle_motor_state);
         }
-        
-        std::this_thread::sleep_for(std::chrono::milliseconds(100));
     }
+#endif
+    
+    bus->unsubscribe(motor_states);
 }
 
 int main(int, char**) {
@@ -483,6 +529,23 @@ int main(int, char**) {
     
     g_os = &os;  // For signal handler
     
+    // MELVIN_TRACE=<seconds>: capture spans for the first N seconds (needs a TRACE=1 build)
+    int trace_seconds = 0;
+    if (const char* trace_env = std::getenv("MELVIN_TRACE")) {
+        trace_seconds = std::max(1, std::atoi(trace_env));
+        melvin::trace::start();
+    }
+    
+    // MELVIN_RECORD=<path>: capture every bus event for offline replay (bin/event_replay)
+    const char* record_path = std::getenv("MELVIN_RECORD");
+    if (record_path && *record_path) {
+        if (os.event_bus()->start_recording(record_path)) {
+            std::cout << "⏺️  Recording bus events to: " << record_path << "\n";
+        } else {
+            std::cerr << "⚠️  Cannot record bus events to " << record_path << "\n";
+        }
+    }
+    
     os.start();
     
     std::cout << "╔══════════════════════════════════════════════════════╗\n";
@@ -499,7 +562,7 @@ int main(int, char**) {
     std::cout << "  • Learning:       10 Hz\n";
     std::cout << "  • Reflection:      5 Hz\n\n";
     
-    std::cout << "📊 Metrics logging to: logs/kpis.jsonl\n";
+    std::cout << "📊 Metrics logging to: logs/kpis.bin (bin/kpi_convert → JSONL/CSV)\n";
     std::cout << "🛑 Press Ctrl+C to stop\n\n";
     
     // ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
@@ -553,6 +616,18 @@ int main(int, char**) {
         std::cout << "Active: " << metrics.active_nodes << " | ";
         std::cout << "Entropy: " << std::fixed << std::setprecision(2) << metrics.entropy << " | ";
         std::cout << "Logs: " << os.metrics()->logs_written() << "\n";
+        
+        if (trace_seconds > 0 && seconds >= trace_seconds) {
+            melvin::trace::stop();
+            melvin::trace::write_chrome_json("logs/trace.json");
+            std::cout << "📈 Trace written to logs/trace.json (chrome://tracing or ui.perfetto.dev)\n";
+            trace_seconds = 0;
+        }
+    }
+    
+    if (trace_seconds > 0) {
+        melvin::trace::stop();
+        melvin::trace::write_chrome_json("logs/trace.json");
     }
     
     // Wait for hardware threads
@@ -561,6 +636,13 @@ int main(int, char**) {
     if (audio_output_thread.joinable()) audio_output_thread.join();
     if (motor_thread.joinable()) motor_thread.join();
     
+    if (os.event_bus()->is_recording()) {
+        const auto& recorder = os.event_bus()->recorder();
+        os.event_bus()->stop_recording();
+        std::cout << "⏺️  Recorded " << recorder.events_recorded() << " events ("
+                  << recorder.events_dropped() << " dropped)\n";
+    }
+    
     return 0;
 }
 
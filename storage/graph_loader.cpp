@@ -105,6 +105,26 @@ bool GraphLoader::LoadEdgesBIN(const std::string& path,
     return true;
 }
 
+bool GraphLoader::LoadEmbeddingsBIN(const std::string& path,
+                                    std::unordered_map<int, std::vector<float>>& embeddings) {
+    std::ifstream f(path, std::ios::binary);
+    if (!f.good()) return false;
+    auto read_int32 = [&](int32_t& v){ f.read(reinterpret_cast<char*>(&v), sizeof(v)); return (bool)f; };
+    int32_t N = 0, dim = 0;
+    if (!read_int32(N) || N < 0) return false;
+    if (!read_int32(dim) || dim < 0 || dim > (1<<16)) return false;
+    embeddings.reserve((size_t)N);
+    for (int32_t i = 0; i < N; ++i) {
+        int32_t id = 0;
+        if (!read_int32(id)) return false;
+        std::vector<float> emb((size_t)dim);
+        f.read(reinterpret_cast<char*>(emb.data()), (std::streamsize)(dim * sizeof(float)));
+        if (!f) return false;
+        embeddings[id] = std::move(emb);
+    }
+    return true;
+}
+
 } // namespace storage
 } // namespace melvin
 
@@ -35,6 +35,10 @@ public:
     bool LoadEdgesBIN(const std::string& path,
                       std::unordered_map<int, std::vector<std::pair<int,float>>>& graph,
                       bool bidir = true);
+
+    // embeddings.bin: int32 N; int32 dim; repeat N times: int32 id; float[dim]
+    bool LoadEmbeddingsBIN(const std::string& path,
+                           std::unordered_map<int, std::vector<float>>& embeddings);
 };
 
 } // namespace storage
@@ -0,0 +1,443 @@
+/**
+ * @file synthetic_graph.cpp
+ * @brief Implementation of the parallel power-law graph generator
+ */
+
+#include "synthetic_graph.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <thread>
+
+namespace melvin {
+namespace storage {
+
+namespace {
+
+constexpr uint64_t EDGE_SALT = 0x45444745ULL;       // "EDGE"
+constexpr uint64_t WEIGHT_SALT = 0x57474854ULL;     // "WGHT"
+constexpr uint64_t EMBED_SALT = 0x454D4244ULL;      // "EMBD"
+constexpr uint64_t CENTROID_SALT = 0x43454E54ULL;   // "CENT"
+
+uint64_t splitmix64(uint64_t x) {
+    x += 0x9E3779B97F4A7C15ULL;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+    return x ^ (x >> 31);
+}
+
+uint64_t hash2(uint64_t seed, uint64_t value) {
+    return splitmix64(seed ^ splitmix64(value));
+}
+
+/**
+ * @brief Uniform in (0, 1) from the top 53 bits
+ */
+double to_unit(uint64_t bits) {
+    return (static_cast<double>(bits >> 11) + 0.5) * (1.0 / 9007199254740992.0);
+}
+
+/**
+ * @brief Counter-based stream: the n-th draw depends only on (key, n)
+ */
+struct HashStream {
+    uint64_t key;
+    uint64_t counter = 0;
+    double spare = 0.0;
+    bool has_spare = false;
+
+    explicit HashStream(uint64_t k) : key(k) {}
+
+    uint64_t next() { return hash2(key, counter++); }
+    double uniform() { return to_unit(next()); }
+
+    /**
+     * @brief Box-Muller; the second value of each pair is kept for the next call
+     */
+    double gaussian() {
+        if (has_spare) {
+            has_spare = false;
+            return spare;
+        }
+        double r = std::sqrt(-2.0 * std::log(uniform()));
+        double theta = 6.283185307179586 * uniform();
+        spare = r * std::sin(theta);
+        has_spare = true;
+        return r * std::cos(theta);
+    }
+};
+
+int resolve_threads(int requested) {
+    if (requested > 0) return requested;
+    unsigned hw = std::thread::hardware_concurrency();
+    return hw ? static_cast<int>(hw) : 4;
+}
+
+/**
+ * @brief Split [0, n) into one contiguous range per thread
+ */
+template<typename Fn>
+void parallel_ranges(int64_t n, int threads, Fn&& fn) {
+    threads = static_cast<int>(std::max<int64_t>(1, std::min<int64_t>(threads, n)));
+    std::vector<std::thread> workers;
+    int64_t chunk = (n + threads - 1) / threads;
+    for (int t = 0; t < threads; t++) {
+        int64_t begin = t * chunk;
+        int64_t end = std::min(n, begin + chunk);
+        if (begin >= end) break;
+        workers.emplace_back([&fn, t, begin, end]() { fn(t, begin, end); });
+    }
+    for (auto& w : workers) w.join();
+}
+
+uint64_t edge_key(const GeneratedEdge& e) {
+    return (static_cast<uint64_t>(static_cast<uint32_t>(e.src)) << 32) | static_cast<uint32_t>(e.dst);
+}
+
+/**
+ * @brief Canonical (larger id first) edge, or false for a self-loop
+ */
+bool canonical(int64_t a, int64_t b, GeneratedEdge& out) {
+    if (a == b) return false;
+    out.src = static_cast<int32_t>(std::max(a, b));
+    out.dst = static_cast<int32_t>(std::min(a, b));
+    out.weight = 0.0f;
+    return true;
+}
+
+// ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
+// BARABÁSI–ALBERT
+// ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
+//
+// Conceptually all edges live in an endpoint array T where T[2e] is the
+// source of edge e (node e / degree) and T[2e+1] its target. The target
+// is a uniform pick from T[0, 2e), which is exactly degree-proportional
+// attachment. Odd picks are themselves targets, resolved the same way
+// from their own edge's hash; even picks are known directly. The chain
+// ends after two steps on average.
+
+int64_t ba_target(uint64_t seed, int64_t edge, int degree) {
+    uint64_t pos = 2 * static_cast<uint64_t>(edge) + 1;
+    for (;;) {
+        uint64_t e = pos >> 1;
+        if ((pos & 1) == 0) return static_cast<int64_t>(e / degree);
+        if (e == 0) return 0;
+        pos = hash2(seed, e) % (2 * e);
+    }
+}
+
+std::vector<GeneratedEdge> generate_ba(const SyntheticGraphParams& p, int threads) {
+    int degree = std::max(1, p.degree);
+    uint64_t seed = hash2(p.seed, EDGE_SALT);
+    std::vector<std::vector<GeneratedEdge>> parts(threads);
+
+    parallel_ranges(p.nodes, threads, [&](int t, int64_t begin, int64_t end) {
+        auto& out = parts[t];
+        out.reserve(static_cast<size_t>((end - begin) * degree));
+        std::vector<int64_t> targets(degree);
+        for (int64_t v = begin; v < end; v++) {
+            for (int j = 0; j < degree; j++) {
+                targets[j] = ba_target(seed, v * degree + j, degree);
+            }
+            // Targets never exceed v, so duplicates are local to this node
+            std::sort(targets.begin(), targets.end());
+            for (int j = 0; j < degree; j++) {
+                if (j > 0 && targets[j] == targets[j - 1]) continue;
+                GeneratedEdge e;
+                if (canonical(v, targets[j], e)) out.push_back(e);
+            }
+        }
+    });
+
+    std::vector<GeneratedEdge> edges;
+    size_t total = 0;
+    for (const auto& part : parts) total += part.size();
+    edges.reserve(total);
+    for (auto& part : parts) {
+        edges.insert(edges.end(), part.begin(), part.end());
+        std::vector<GeneratedEdge>().swap(part);
+    }
+    return edges;
+}
+
+// ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
+// R-MAT
+// ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
+
+std::vector<GeneratedEdge> generate_rmat(const SyntheticGraphParams& p, int threads) {
+    int64_t target_edges = p.edges > 0 ? p.edges : p.nodes * std::max(1, p.degree);
+    int scale = 1;
+    while ((int64_t(1) << scale) < p.nodes) scale++;
+
+    // Quadrant thresholds in 16-bit fixed point: one hash feeds four levels
+    uint32_t a = static_cast<uint32_t>(p.rmat_a * 65536.0f);
+    uint32_t ab = static_cast<uint32_t>((p.rmat_a + p.rmat_b) * 65536.0f);
+    uint32_t abc = static_cast<uint32_t>((p.rmat_a + p.rmat_b + p.rmat_c) * 65536.0f);
+    uint64_t seed = hash2(p.seed, EDGE_SALT);
+
+    std::vector<std::vector<GeneratedEdge>> parts(threads);
+    parallel_ranges(target_edges, threads, [&](int t, int64_t begin, int64_t end) {
+        auto& out = parts[t];
+        out.reserve(static_cast<size_t>(end - begin));
+        for (int64_t i = begin; i < end; i++) {
+            HashStream rng(hash2(seed, static_cast<uint64_t>(i)));
+            int64_t src = 0;
+            int64_t dst = 0;
+            // Ids past the node count are rerolled (bounded)
+            for (int attempt = 0; attempt < 16; attempt++) {
+                src = 0;
+                dst = 0;
+                uint64_t bits = 0;
+                for (int level = 0; level < scale; level++) {
+                    if ((level & 3) == 0) bits = rng.next();
+                    uint32_t u = static_cast<uint32_t>(bits & 0xFFFF);
+                    bits >>= 16;
+                    src <<= 1;
+                    dst <<= 1;
+                    if (u < a) {
+                    } else if (u < ab) {
+                        dst |= 1;
+                    } else if (u < abc) {
+                        src |= 1;
+                    } else {
+                        src |= 1;
+                        dst |= 1;
+                    }
+                }
+                if (src < p.nodes && dst < p.nodes) break;
+            }
+            GeneratedEdge e;
+            if (src < p.nodes && dst < p.nodes && canonical(src, dst, e)) out.push_back(e);
+        }
+        std::sort(out.begin(), out.end(), [](const GeneratedEdge& x, const GeneratedEdge& y) {
+            return edge_key(x) < edge_key(y);
+        });
+    });
+
+    // Merge the sorted parts pairwise (in parallel per round), then dedupe
+    auto less = [](const GeneratedEdge& x, const GeneratedEdge& y) { return edge_key(x) < edge_key(y); };
+    while (parts.size() > 1) {
+        std::vector<std::vector<GeneratedEdge>> merged((parts.size() + 1) / 2);
+        std::vector<std::thread> workers;
+        for (size_t i = 0; i < merged.size(); i++) {
+            workers.emplace_back([&, i]() {
+                auto& x = parts[2 * i];
+                if (2 * i + 1 >= parts.size()) {
+                    merged[i] = std::move(x);
+                    return;
+                }
+                auto& y = parts[2 * i + 1];
+                merged[i].resize(x.size() + y.size());
+                std::merge(x.begin(), x.end(), y.begin(), y.end(), merged[i].begin(), less);
+                std::vector<GeneratedEdge>().swap(x);
+                std::vector<GeneratedEdge>().swap(y);
+            });
+        }
+        for (auto& w : workers) w.join();
+        parts = std::move(merged);
+    }
+
+    std::vector<GeneratedEdge> edges = parts.empty() ? std::vector<GeneratedEdge>() : std::move(parts[0]);
+    edges.erase(std::unique(edges.begin(), edges.end(),
+                            [](const GeneratedEdge& x, const GeneratedEdge& y) {
+                                return edge_key(x) == edge_key(y);
+                            }),
+                edges.end());
+    return edges;
+}
+
+// ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
+// WEIGHTS & EMBEDDINGS
+// ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
+
+float sample_weight(const SyntheticGraphParams& p, double u) {
+    double w;
+    switch (p.weights) {
+        case WeightDistribution::EXPONENTIAL:
+            w = -p.weight_mean * std::log(1.0 - u);
+            break;
+        case WeightDistribution::PARETO:
+            w = p.weight_min * std::pow(1.0 - u, -1.0 / std::max(0.1f, p.weight_alpha));
+            break;
+        case WeightDistribution::UNIFORM:
+        default:
+            w = p.weight_min + u * (p.weight_max - p.weight_min);
+            break;
+    }
+    return static_cast<float>(std::max<double>(p.weight_min, std::min<double>(p.weight_max, w)));
+}
+
+void assign_weights(const SyntheticGraphParams& p, std::vector<GeneratedEdge>& edges, int threads) {
+    uint64_t seed = hash2(p.seed, WEIGHT_SALT);
+    parallel_ranges(static_cast<int64_t>(edges.size()), threads, [&](int, int64_t begin, int64_t end) {
+        for (int64_t i = begin; i < end; i++) {
+            edges[i].weight = sample_weight(p, to_unit(hash2(seed, edge_key(edges[i]))));
+        }
+    });
+}
+
+void generate_embeddings(const SyntheticGraphParams& p, GeneratedGraph& g, int threads) {
+    int dim = p.embedding_dim;
+    int clusters = std::max(1, p.clusters);
+    g.embedding_dim = dim;
+    g.embeddings.assign(static_cast<size_t>(g.nodes) * dim, 0.0f);
+
+    // Unit-length centroids
+    std::vector<float> centroids(static_cast<size_t>(clusters) * dim);
+    uint64_t centroid_seed = hash2(p.seed, CENTROID_SALT);
+    for (int c = 0; c < clusters; c++) {
+        HashStream rng(hash2(centroid_seed, c));
+        float* row = &centroids[static_cast<size_t>(c) * dim];
+        double norm = 0.0;
+        for (int k = 0; k < dim; k++) {
+            row[k] = static_cast<float>(rng.gaussian());
+            norm += row[k] * row[k];
+        }
+        float inv = norm > 0.0 ? static_cast<float>(1.0 / std::sqrt(norm)) : 0.0f;
+        for (int k = 0; k < dim; k++) row[k] *= inv;
+    }
+
+    // Per-dimension noise so the expected offset length is cluster_spread
+    float noise = p.cluster_spread / std::sqrt(static_cast<float>(dim));
+    uint64_t embed_seed = hash2(p.seed, EMBED_SALT);
+    parallel_ranges(g.nodes, threads, [&](int, int64_t begin, int64_t end) {
+        for (int64_t id = begin; id < end; id++) {
+            int c = static_cast<int>(id * clusters / g.nodes);
+            const float* centroid = &centroids[static_cast<size_t>(c) * dim];
+            float* row = &g.embeddings[static_cast<size_t>(id) * dim];
+            HashStream rng(hash2(embed_seed, static_cast<uint64_t>(id)));
+            double norm = 0.0;
+            for (int k = 0; k < dim; k++) {
+                row[k] = centroid[k] + noise * static_cast<float>(rng.gaussian());
+                norm += row[k] * row[k];
+            }
+            float inv = norm > 0.0 ? static_cast<float>(1.0 / std::sqrt(norm)) : 0.0f;
+            for (int k = 0; k < dim; k++) row[k] *= inv;
+        }
+    });
+}
+
+bool write_all(FILE* f, const void* data, size_t bytes) {
+    return bytes == 0 || std::fwrite(data, 1, bytes, f) == bytes;
+}
+
+} // namespace
+
+// ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
+// GENERATION
+// ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
+
+GeneratedGraph generate_graph(const SyntheticGraphParams& params) {
+    GeneratedGraph g;
+    g.nodes = std::max<int64_t>(2, std::min<int64_t>(params.nodes, INT32_MAX));
+    SyntheticGraphParams p = params;
+    p.nodes = g.nodes;
+    int threads = resolve_threads(p.threads);
+
+    g.edges = p.model == GraphModel::RMAT ? generate_rmat(p, threads) : generate_ba(p, threads);
+    assign_weights(p, g.edges, threads);
+
+    g.degrees.assign(static_cast<size_t>(g.nodes), 0);
+    for (const auto& e : g.edges) {
+        g.degrees[e.src]++;
+        g.degrees[e.dst]++;
+    }
+
+    if (p.embedding_dim > 0) {
+        generate_embeddings(p, g, threads);
+    }
+    return g;
+}
+
+std::string synthetic_label(int64_t id) {
+    return "n" + std::to_string(id);
+}
+
+// ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
+// OUTPUT
+// ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
+
+bool write_nodes_bin(const GeneratedGraph& graph, const std::string& path) {
+    FILE* f = std::fopen(path.c_str(), "wb");
+    if (!f) return false;
+
+    uint32_t max_degree = 1;
+    for (uint32_t d : graph.degrees) max_degree = std::max(max_degree, d);
+    float log_max = std::log1p(static_cast<float>(max_degree));
+
+    std::vector<char> buffer;
+    buffer.reserve(1 << 20);
+    auto put = [&buffer](const void* data, size_t bytes) {
+        const char* p = static_cast<const char*>(data);
+        buffer.insert(buffer.end(), p, p + bytes);
+    };
+
+    bool ok = true;
+    int32_t n = static_cast<int32_t>(graph.nodes);
+    put(&n, sizeof(n));
+    for (int32_t id = 0; id < n && ok; id++) {
+        std::string label = synthetic_label(id);
+        int32_t len = static_cast<int32_t>(label.size());
+        float prior = std::log1p(static_cast<float>(graph.degrees[id])) / log_max;
+        put(&id, sizeof(id));
+        put(&len, sizeof(len));
+        put(label.data(), label.size());
+        put(&prior, sizeof(prior));
+        if (buffer.size() >= (1 << 20)) {
+            ok = write_all(f, buffer.data(), buffer.size());
+            buffer.clear();
+        }
+    }
+    ok = ok && write_all(f, buffer.data(), buffer.size());
+    return std::fclose(f) == 0 && ok;
+}
+
+bool write_edges_bin(const GeneratedGraph& graph, const std::string& path) {
+    FILE* f = std::fopen(path.c_str(), "wb");
+    if (!f) return false;
+
+    // Records are packed int32, int32, float: the struct has no padding
+    static_assert(sizeof(GeneratedEdge) == 12, "edge record must be 12 bytes");
+    int32_t m = static_cast<int32_t>(graph.edges.size());
+    bool ok = write_all(f, &m, sizeof(m)) &&
+              write_all(f, graph.edges.data(), graph.edges.size() * sizeof(GeneratedEdge));
+    return std::fclose(f) == 0 && ok;
+}
+
+bool write_embeddings_bin(const GeneratedGraph& graph, const std::string& path) {
+    FILE* f = std::fopen(path.c_str(), "wb");
+    if (!f) return false;
+
+    int32_t n = graph.embedding_dim > 0 ? static_cast<int32_t>(graph.nodes) : 0;
+    int32_t dim = graph.embedding_dim;
+    bool ok = write_all(f, &n, sizeof(n)) && write_all(f, &dim, sizeof(dim));
+    for (int32_t id = 0; id < n && ok; id++) {
+        ok = write_all(f, &id, sizeof(id)) &&
+             write_all(f, &graph.embeddings[static_cast<size_t>(id) * dim], dim * sizeof(float));
+    }
+    return std::fclose(f) == 0 && ok;
+}
+
+void to_adjacency(const GeneratedGraph& graph,
+                  std::unordered_map<int, std::vector<std::pair<int, float>>>& adjacency,
+                  std::unordered_map<int, std::vector<float>>& embeddings) {
+    adjacency.reserve(static_cast<size_t>(graph.nodes));
+    for (int id = 0; id < graph.nodes; id++) {
+        adjacency[id].reserve(graph.degrees[id]);
+    }
+    for (const auto& e : graph.edges) {
+        adjacency[e.src].emplace_back(e.dst, e.weight);
+        adjacency[e.dst].emplace_back(e.src, e.weight);
+    }
+
+    if (graph.embedding_dim > 0) {
+        embeddings.reserve(static_cast<size_t>(graph.nodes));
+        for (int id = 0; id < graph.nodes; id++) {
+            const float* row = &graph.embeddings[static_cast<size_t>(id) * graph.embedding_dim];
+            embeddings[id].assign(row, row + graph.embedding_dim);
+        }
+    }
+}
+
+} // namespace storage
+} // namespace melvin
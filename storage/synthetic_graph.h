@@ -0,0 +1,113 @@
+/**
+ * @file synthetic_graph.h
+ * @brief Parallel power-law graph generator for scale testing
+ *
+ * Two models:
+ *  - BA (Barabási–Albert): every node links to `degree` earlier nodes by
+ *    preferential attachment. Each edge's target is resolved from a
+ *    per-edge hash through the implicit endpoint array, so edges are
+ *    generated independently in parallel and the graph is identical for
+ *    any thread count.
+ *  - RMAT: recursive-matrix edges with tunable quadrant probabilities
+ *    (a, b, c) for heavier or lighter degree skew.
+ *
+ * Embeddings are drawn around `clusters` random centroids (node ids in
+ * contiguous ranges share a cluster), so similarity search has structure.
+ *
+ * Output matches GraphLoader's unified binary format (nodes.bin,
+ * edges.bin) plus embeddings.bin:
+ *   int32 N; int32 dim; repeat N times: int32 id; float[dim]
+ */
+
+#ifndef MELVIN_STORAGE_SYNTHETIC_GRAPH_H
+#define MELVIN_STORAGE_SYNTHETIC_GRAPH_H
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace melvin {
+namespace storage {
+
+enum class GraphModel {
+    BA,
+    RMAT
+};
+
+enum class WeightDistribution {
+    UNIFORM,      // weight_min .. weight_max
+    EXPONENTIAL,  // mean weight_mean, clamped to [weight_min, weight_max]
+    PARETO        // weight_min * (1-u)^(-1/alpha), clamped to weight_max
+};
+
+struct SyntheticGraphParams {
+    GraphModel model = GraphModel::BA;
+    int64_t nodes = 100000;
+    int degree = 8;                  // BA: edges per new node
+    int64_t edges = 0;               // RMAT: target edge count (0 = nodes * degree)
+    float rmat_a = 0.57f;            // RMAT quadrant probabilities (d = 1 - a - b - c)
+    float rmat_b = 0.19f;
+    float rmat_c = 0.19f;
+
+    WeightDistribution weights = WeightDistribution::UNIFORM;
+    float weight_min = 0.1f;
+    float weight_max = 1.0f;
+    float weight_mean = 0.3f;
+    float weight_alpha = 2.0f;
+
+    int embedding_dim = 128;
+    int clusters = 64;
+    float cluster_spread = 0.35f;    // Noise scale around each centroid
+
+    uint64_t seed = 42;
+    int threads = 0;                 // 0 = hardware concurrency
+};
+
+struct GeneratedEdge {
+    int32_t src;
+    int32_t dst;
+    float weight;
+};
+
+struct GeneratedGraph {
+    int64_t nodes = 0;
+    int embedding_dim = 0;
+    std::vector<GeneratedEdge> edges;     // Undirected, no self-loops or duplicates
+    std::vector<uint32_t> degrees;
+    std::vector<float> embeddings;        // nodes * embedding_dim, unit length rows
+};
+
+/**
+ * @brief Generate edges, degrees and (if embedding_dim > 0) embeddings
+ */
+GeneratedGraph generate_graph(const SyntheticGraphParams& params);
+
+/**
+ * @brief Node label used for generated ids ("n<id>")
+ */
+std::string synthetic_label(int64_t id);
+
+/**
+ * @brief Write nodes.bin (label, prior from log degree)
+ */
+bool write_nodes_bin(const GeneratedGraph& graph, const std::string& path);
+
+/**
+ * @brief Write edges.bin (one record per undirected edge; load with bidir)
+ */
+bool write_edges_bin(const GeneratedGraph& graph, const std::string& path);
+
+bool write_embeddings_bin(const GeneratedGraph& graph, const std::string& path);
+
+/**
+ * @brief Adjacency-list view in the shape the reasoning code takes
+ */
+void to_adjacency(const GeneratedGraph& graph,
+                  std::unordered_map<int, std::vector<std::pair<int, float>>>& adjacency,
+                  std::unordered_map<int, std::vector<float>>& embeddings);
+
+} // namespace storage
+} // namespace melvin
+
+#endif // MELVIN_STORAGE_SYNTHETIC_GRAPH_H
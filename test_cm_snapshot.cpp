@@ -0,0 +1,117 @@
+/**
+ * @file test_cm_snapshot.cpp
+ * @brief Round trip and corruption checks for crossmodal snapshots
+ *
+ * Saves a populated grounder, restores it into a fresh one and compares
+ * them, then verifies that damaged files (single bit flips, truncation,
+ * a missing file) are rejected without touching the target grounder.
+ * Exits non-zero on any failure.
+ */
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <random>
+#include <cstdio>
+#include "crossmodal/cm_io.h"
+
+using namespace melvin::crossmodal;
+
+namespace {
+
+int failures = 0;
+
+void check(bool ok, const std::string& what) {
+    std::cout << (ok ? "   ✅ " : "   ❌ ") << what << "\n";
+    if (!ok) failures++;
+}
+
+std::string read_file(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    std::ostringstream ss;
+    ss << in.rdbuf();
+    return ss.str();
+}
+
+void write_file(const std::string& path, const std::string& bytes) {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+}
+
+// Bindings as exported text: equal dumps mean equal binding state
+std::string dump_bindings(const CMGrounder& g) {
+    const std::string path = "cm_snapshot.test.tsv";
+    CMIO::ExportBindingsTSV(path, g.bindings());
+    std::string text = read_file(path);
+    std::remove(path.c_str());
+    return text;
+}
+
+void populate(CMGrounder& g) {
+    auto& space = CMSpace::Instance();
+    for (int i = 0; i < 2000; i++) {
+        std::string v = "v" + std::to_string(i);
+        std::string a = "a" + std::to_string(i);
+        g.vision_index().Add(v, space.EncodeVision(v));
+        if (i % 2 == 0) g.audio_index().Add(a, space.EncodeAudio(a));
+        if (i % 5 == 0) g.motor_index().Add("m" + std::to_string(i), space.EncodeMotor("m" + std::to_string(i)));
+        g.bindings().Upsert({i % 300, Binding::VISION, v, 0.2f + (i % 7) * 0.1f, "test"});
+        if (i % 2 == 0) g.bindings().Upsert({i % 150, Binding::AUDIO, a, 0.5f, "mic"});
+    }
+    // Pruning leaves freed blocks and key refs behind
+    for (int c = 0; c < 300; c += 3) g.bindings().PruneConcept(c, 3);
+    g.SetContextRelevance({{"v1", 0.8f}, {"v2", 0.4f}});
+    g.NoteTemporalKey("a4", 0.6f);
+    g.SetWeights(0.25f, 0.35f, 0.9f);
+}
+
+} // namespace
+
+int main() {
+    std::cout << "╔══════════════════════════════════════════════════════╗\n";
+    std::cout << "║     CROSSMODAL SNAPSHOT TEST                         ║\n";
+    std::cout << "╚══════════════════════════════════════════════════════╝\n\n";
+
+    const std::string path = "cm_snapshot.test.bin";
+    CMGrounder original;
+    populate(original);
+
+    std::cout << "🔁 Round trip\n";
+    check(CMIO::SaveSnapshot(path, original), "save");
+    CMGrounder restored;
+    check(CMIO::LoadSnapshot(path, restored), "load");
+    check(restored.vision_index().Size() == original.vision_index().Size() &&
+          restored.audio_index().Size() == original.audio_index().Size() &&
+          restored.motor_index().Size() == original.motor_index().Size(), "index sizes match");
+    check(dump_bindings(restored) == dump_bindings(original), "bindings match");
+    auto q = CMSpace::Instance().EncodeVision("v42");
+    check(restored.vision_index().TopK(q, 10) == original.vision_index().TopK(q, 10), "top-k matches");
+    restored.bindings().Upsert({7, Binding::VISION, "v-new", 0.9f, "test"});
+    check(restored.bindings().ForKey("v-new").size() == 1, "upsert after restore");
+
+    std::cout << "\n🧨 Corrupt files\n";
+    const std::string good = read_file(path);
+    const std::string before = dump_bindings(original);
+    std::mt19937_64 rng(42);
+    int accepted = 0;
+    for (int i = 0; i < 300; i++) {
+        std::string bad = good;
+        size_t bit = rng() % (bad.size() * 8);
+        bad[bit / 8] = static_cast<char>(bad[bit / 8] ^ (1 << (bit % 8)));
+        write_file(path, bad);
+        if (CMIO::LoadSnapshot(path, original)) accepted++;
+    }
+    check(accepted == 0, "300 single-bit flips rejected");
+    int truncated_accepted = 0;
+    for (size_t cut : {size_t(0), size_t(7), good.size() / 3, good.size() - 1}) {
+        write_file(path, good.substr(0, cut));
+        if (CMIO::LoadSnapshot(path, original)) truncated_accepted++;
+    }
+    check(truncated_accepted == 0, "truncated files rejected");
+    std::remove(path.c_str());
+    check(!CMIO::LoadSnapshot(path, original), "missing file rejected");
+    check(dump_bindings(original) == before, "rejected loads leave the grounder unchanged");
+
+    std::cout << "\n" << (failures == 0 ? "✅ All snapshot checks passed" : "❌ Snapshot checks failed") << "\n";
+    return failures == 0 ? 0 : 1;
+}
@@ -16,6 +16,7 @@
 #include <chrono>
 #include "cognitive_os/cognitive_os.h"
 #include "core/unified_intelligence.h"
+#include "core/metrics/trace.h"
 
 using namespace melvin::cognitive_os;
 using namespace melvin::intelligence;
@@ -135,6 +136,9 @@ int main() {
     std::cout << "                 STARTING COGNITIVE OS                 \n";
     std::cout << "═══════════════════════════════════════════════════════\n\n";
     
+#if MELVIN_TRACING
+    melvin::trace::start();
+#endif
     os.start();
     
     std::cout << "🎉 System is ALIVE and ALWAYS-ON!\n\n";
@@ -216,10 +220,55 @@ int main() {
     // ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
     
     std::cout << "📊 System metrics:\n";
-    std::cout << "   Logs written: " << os.metrics()->logs_written() << "\n";
+    os.metrics()->flush();
+    std::cout << "   Logs written: " << os.metrics()->logs_written()
+              << " (dropped " << os.metrics()->logs_dropped() << ")\n";
     std::cout << "   Dropped msgs: " << os.event_bus()->dropped_messages() << "\n";
     std::cout << "   Field size:   " << field.get_metrics().active_nodes << " active nodes\n\n";
     
+    std::cout << "⏱  Service deadlines (degrade level " << os.degrade_level() << "):\n";
+    for (const auto& st : os.service_stats()) {
+        std::cout << "   " << std::left << std::setw(11) << st.name << std::right
+                  << " runs=" << std::setw(4) << st.completions
+                  << " misses=" << std::setw(3) << st.deadline_misses
+                  << " jitter=" << std::setprecision(2) << st.avg_jitter_ms << "/" << st.max_jitter_ms << "ms"
+                  << " exec=" << st.avg_exec_ms << "ms"
+                  << " p99=" << st.p99_exec_ms << "ms\n";
+    }
+    std::cout << "\n";
+    
+    std::cout << "📈 Latency percentiles (ms):\n";
+    for (const auto& lat : os.latency_summaries()) {
+        std::cout << "   " << std::left << std::setw(28) << lat.name << std::right
+                  << " n=" << std::setw(6) << lat.count
+                  << " p50=" << std::setprecision(3) << lat.p50_ms
+                  << " p90=" << lat.p90_ms
+                  << " p99=" << lat.p99_ms
+                  << " p999=" << lat.p999_ms << "\n";
+    }
+    std::cout << "\n";
+    
+    // ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
+    // SESSIONS (one field per conversation, one shared graph)
+    // ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
+    
+    std::cout << "🧵 Conversation sessions:\n";
+    auto chat_a = field.fork_session();   // Continues the current train of thought
+    auto chat_b = field.create_session(); // Starts from an empty field
+    field.activate(chat_a, word_to_id["learning"], 0.8f);
+    field.activate(chat_b, word_to_id["hello"], 1.0f);
+    field.activate(chat_b, word_to_id["world"], 0.6f);
+    for (auto [label, session] : {std::make_pair("A (fork)", chat_a), std::make_pair("B (new) ", chat_b)}) {
+        auto m = field.get_metrics(session);
+        std::cout << "   " << label << " active=" << m.active_nodes
+                  << " max=" << std::setprecision(2) << m.max_activation << "\n";
+    }
+    std::cout << "   Global \"learning\": " << field.get_activation(word_to_id["learning"])
+              << " (A: " << field.get_activation(chat_a, word_to_id["learning"]) << ")\n";
+    field.destroy_session(chat_a);
+    field.destroy_session(chat_b);
+    std::cout << "\n";
+    
     // ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
     // STOP SYSTEM
     // ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
@@ -227,6 +276,14 @@ int main() {
     std::cout << "🛑 Stopping Cognitive OS...\n";
     os.stop();
     
+#if MELVIN_TRACING
+    melvin::trace::stop();
+    if (melvin::trace::write_chrome_json("logs/trace.json")) {
+        std::cout << "📈 Trace written to logs/trace.json ("
+                  << melvin::trace::dropped_events() << " spans dropped)\n";
+    }
+#endif
+    
     std::cout << "\n╔══════════════════════════════════════════════════════╗\n";
     std::cout << "║     COGNITIVE OS TEST COMPLETE                       ║\n";
     std::cout << "║                                                      ║\n";
@@ -0,0 +1,269 @@
+/**
+ * @file event_replay.cpp
+ * @brief Replay a recorded event stream into a headless Cognitive OS
+ *
+ * Usage: event_replay <events.bin> [--speed N|max] [--all] [--graph-dir DIR]
+ *                     [--nodes N] [--settle-ms MS]
+ *
+ * Record on the robot with MELVIN_RECORD=logs/events.bin. The replay
+ * source stands in for the hardware threads: by default only the input
+ * topics (vision, audio, motor, queries, feedback) are re-published and
+ * the OS regenerates its own outputs; --all replays every topic.
+ * --speed 1 reproduces the original timing, --speed 4 compresses it 4x,
+ * --speed max publishes as fast as possible (load test).
+ *
+ * Reports replay throughput, lateness, bus drops and per-service latency.
+ */
+
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <thread>
+#include <chrono>
+#include <atomic>
+#include <cstdlib>
+#include <algorithm>
+#include "cognitive_os/cognitive_os.h"
+#include "cognitive_os/event_record.h"
+#include "core/unified_intelligence.h"
+#include "storage/graph_loader.h"
+#include "storage/synthetic_graph.h"
+
+using namespace melvin;
+using namespace melvin::cognitive_os;
+
+namespace {
+
+struct Config {
+    std::string events_path;
+    double speed = 1.0;           // 0 = max
+    bool all_topics = false;
+    std::string graph_dir;
+    int nodes = 20000;
+    int settle_ms = 500;
+};
+
+void usage(const char* argv0) {
+    std::cerr << "Usage: " << argv0
+              << " <events.bin> [--speed N|max] [--all] [--graph-dir DIR] [--nodes N]"
+              << " [--settle-ms MS]\n";
+}
+
+bool is_input_topic(const std::string& name) {
+    return name == topics::VISION_EVENTS || name == topics::AUDIO_EVENTS ||
+           name == topics::MOTOR_STATE || name == topics::MOTOR_FEEDBACK ||
+           name == topics::COG_QUERY || name == topics::COG_FEEDBACK;
+}
+
+bool load_graph(const Config& cfg,
+                std::unordered_map<int, std::vector<std::pair<int, float>>>& graph,
+                std::unordered_map<int, std::vector<float>>& embeddings,
+                std::unordered_map<int, std::string>& id_to_word,
+                std::unordered_map<std::string, int>& word_to_id) {
+    if (!cfg.graph_dir.empty()) {
+        storage::GraphLoader loader;
+        std::unordered_map<int, float> priors;
+        if (!loader.LoadNodesBIN(cfg.graph_dir + "/unified_nodes.bin", id_to_word, word_to_id, priors) ||
+            !loader.LoadEdgesBIN(cfg.graph_dir + "/unified_edges.bin", graph, true)) {
+            return false;
+        }
+        loader.LoadEmbeddingsBIN(cfg.graph_dir + "/unified_embeddings.bin", embeddings);
+        return true;
+    }
+
+    storage::SyntheticGraphParams params;
+    params.nodes = cfg.nodes;
+    storage::GeneratedGraph generated = storage::generate_graph(params);
+    storage::to_adjacency(generated, graph, embeddings);
+    for (int id = 0; id < generated.nodes; id++) {
+        std::string word = storage::synthetic_label(id);
+        id_to_word[id] = word;
+        word_to_id[word] = id;
+    }
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Config cfg;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--all") {
+            cfg.all_topics = true;
+            continue;
+        }
+        if (arg[0] != '-') {
+            cfg.events_path = arg;
+            continue;
+        }
+        if (i + 1 >= argc) {
+            usage(argv[0]);
+            return 1;
+        }
+        std::string value = argv[++i];
+
+        if (arg == "--speed") {
+            cfg.speed = (value == "max") ? 0.0 : std::atof(value.c_str());
+            if (value != "max" && cfg.speed <= 0.0) {
+                usage(argv[0]);
+                return 1;
+            }
+        } else if (arg == "--graph-dir") {
+            cfg.graph_dir = value;
+        } else if (arg == "--nodes") {
+            cfg.nodes = std::max(1, std::atoi(value.c_str()));
+        } else if (arg == "--settle-ms") {
+            cfg.settle_ms = std::max(0, std::atoi(value.c_str()));
+        } else {
+            usage(argv[0]);
+            return 1;
+        }
+    }
+
+    if (cfg.events_path.empty()) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    EventLogReader reader;
+    if (!reader.open(cfg.events_path)) {
+        std::cerr << "❌ Cannot open event log " << cfg.events_path << "\n";
+        return 1;
+    }
+
+    // ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
+    // HEADLESS COGNITIVE OS
+    // ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
+
+    std::unordered_map<int, std::vector<std::pair<int, float>>> graph;
+    std::unordered_map<int, std::vector<float>> embeddings;
+    std::unordered_map<int, std::string> id_to_word;
+    std::unordered_map<std::string, int> word_to_id;
+    if (!load_graph(cfg, graph, embeddings, id_to_word, word_to_id)) {
+        std::cerr << "❌ Cannot load graph from " << cfg.graph_dir << "\n";
+        return 1;
+    }
+    std::cout << "🧠 Graph: " << id_to_word.size() << " nodes"
+              << (cfg.graph_dir.empty() ? " (synthetic)" : " (" + cfg.graph_dir + ")") << "\n";
+
+    intelligence::UnifiedIntelligence melvin;
+    melvin.initialize(graph, embeddings, word_to_id, id_to_word);
+    FieldFacade field(graph, embeddings);
+
+    CognitiveOS os;
+    os.attach(&melvin, &field);
+    os.set_word_map(&id_to_word);
+    EventBus* bus = os.event_bus();
+
+    // Sinks standing in for the audio output and motor threads
+    std::atomic<uint64_t> answers{0};
+    std::atomic<uint64_t> motor_commands{0};
+    auto answer_sink = bus->subscribe(topics::COG_ANSWER, [&](const Event&) {
+        answers.fetch_add(1, std::memory_order_relaxed);
+    });
+    SubscriptionOptions motor_options;
+    motor_options.policy = DeliveryPolicy::COALESCE_LATEST;
+    auto motor_sink = bus->subscribe(topics::MOTOR_STATE, [&](const Event&) {
+        motor_commands.fetch_add(1, std::memory_order_relaxed);
+    }, motor_options);
+
+    os.start();
+
+    // ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
+    // REPLAY
+    // ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
+
+    std::cout << "▶️  Replaying " << cfg.events_path << " at "
+              << (cfg.speed > 0.0 ? std::to_string(cfg.speed) + "x" : std::string("max speed"))
+              << (cfg.all_topics ? " (all topics)" : " (input topics)") << "\n";
+
+    using Clock = std::chrono::steady_clock;
+    RecordedEvent event;
+    uint64_t read = 0;
+    uint64_t published = 0;
+    uint64_t skipped = 0;
+    uint64_t failed = 0;
+    double first_ts = -1.0;
+    double last_ts = 0.0;
+    double max_late_ms = 0.0;
+    auto start = Clock::now();
+
+    while (reader.next(event)) {
+        read++;
+        if (!cfg.all_topics && !is_input_topic(event.topic_name)) {
+            skipped++;
+            continue;
+        }
+
+        if (first_ts < 0.0) first_ts = event.timestamp;
+        last_ts = event.timestamp;
+
+        if (cfg.speed > 0.0) {
+            auto due = start + std::chrono::duration_cast<Clock::duration>(
+                std::chrono::duration<double>((event.timestamp - first_ts) / cfg.speed));
+            auto now = Clock::now();
+            if (due > now) {
+                std::this_thread::sleep_until(due);
+            } else {
+                max_late_ms = std::max(max_late_ms,
+                    std::chrono::duration<double, std::milli>(now - due).count());
+            }
+        }
+
+        if (publish_recorded(*bus, event)) {
+            published++;
+        } else {
+            failed++;
+        }
+    }
+
+    double replay_s = std::chrono::duration<double>(Clock::now() - start).count();
+    std::this_thread::sleep_for(std::chrono::milliseconds(cfg.settle_ms));
+
+    os.stop();
+    bus->unsubscribe(answer_sink);
+    bus->unsubscribe(motor_sink);
+
+    // ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
+    // REPORT
+    // ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
+
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "\n📊 Replay\n";
+    std::cout << "   Events read:      " << read << " (" << skipped << " output events skipped)\n";
+    std::cout << "   Published:        " << published << " (" << failed << " undecodable)\n";
+    std::cout << "   Recorded span:    " << (first_ts >= 0.0 ? last_ts - first_ts : 0.0) << "s\n";
+    std::cout << "   Replay time:      " << replay_s << "s ("
+              << (replay_s > 0.0 ? published / replay_s : 0.0) << " events/s)\n";
+    if (cfg.speed > 0.0) {
+        std::cout << "   Max lateness:     " << max_late_ms << " ms\n";
+    }
+    std::cout << "   Bus drops:        " << bus->dropped_messages() << "\n";
+    std::cout << "   Answers:          " << answers.load() << "\n";
+    std::cout << "   Motor commands:   " << motor_commands.load() << "\n";
+
+    std::cout << "\n⏱️  Services (exec ms)\n";
+    std::cout << "   " << std::left << std::setw(16) << "service" << std::right
+              << std::setw(10) << "runs" << std::setw(10) << "p50" << std::setw(10) << "p99"
+              << std::setw(10) << "max" << std::setw(10) << "misses" << std::setw(10) << "skipped" << "\n";
+    for (const auto& s : os.service_stats()) {
+        std::cout << "   " << std::left << std::setw(16) << s.name << std::right
+                  << std::setw(10) << s.completions << std::setw(10) << s.p50_exec_ms
+                  << std::setw(10) << s.p99_exec_ms << std::setw(10) << s.max_exec_ms
+                  << std::setw(10) << s.deadline_misses << std::setw(10) << s.skipped << "\n";
+    }
+
+    std::cout << "\n⏱️  Bus lag and reasoning (ms)\n";
+    for (const auto& l : os.latency_summaries()) {
+        if (l.count == 0) continue;
+        if (l.name.compare(0, 7, "bus.lag") != 0 && l.name.compare(0, 6, "reason") != 0) continue;
+        std::cout << "   " << std::left << std::setw(24) << l.name << std::right
+                  << std::setw(10) << l.count << "  p50 " << l.p50_ms << "  p99 " << l.p99_ms
+                  << "  max " << l.max_ms << "\n";
+    }
+
+    return 0;
+}
@@ -0,0 +1,136 @@
+/**
+ * @file graph_gen.cpp
+ * @brief Synthetic large-graph generator for scale testing
+ *
+ * Usage: graph_gen [--model ba|rmat] [--nodes N] [--degree D] [--edges M]
+ *                  [--rmat a,b,c] [--weights uniform|exp|pareto]
+ *                  [--weight-min W] [--weight-max W] [--weight-mean W]
+ *                  [--weight-alpha A] [--dim D] [--clusters K] [--spread S]
+ *                  [--seed S] [--threads T] [--out DIR]
+ *
+ * Writes DIR/unified_nodes.bin, DIR/unified_edges.bin and
+ * DIR/unified_embeddings.bin (default DIR: data), the files melvin_jetson
+ * loads at startup.
+ */
+
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <chrono>
+#include <cstdlib>
+#include <cstdio>
+#include <algorithm>
+#include "storage/synthetic_graph.h"
+
+using namespace melvin::storage;
+
+namespace {
+
+void usage(const char* argv0) {
+    std::cerr << "Usage: " << argv0
+              << " [--model ba|rmat] [--nodes N] [--degree D] [--edges M] [--rmat a,b,c]\n"
+              << "       [--weights uniform|exp|pareto] [--weight-min W] [--weight-max W]\n"
+              << "       [--weight-mean W] [--weight-alpha A] [--dim D] [--clusters K]\n"
+              << "       [--spread S] [--seed S] [--threads T] [--out DIR]\n";
+}
+
+double seconds_since(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    SyntheticGraphParams params;
+    std::string out_dir = "data";
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (i + 1 >= argc) {
+            usage(argv[0]);
+            return 1;
+        }
+        std::string value = argv[++i];
+
+        if (arg == "--model") {
+            if (value == "ba") params.model = GraphModel::BA;
+            else if (value == "rmat") params.model = GraphModel::RMAT;
+            else { usage(argv[0]); return 1; }
+        } else if (arg == "--nodes") {
+            params.nodes = std::atoll(value.c_str());
+        } else if (arg == "--degree") {
+            params.degree = std::atoi(value.c_str());
+        } else if (arg == "--edges") {
+            params.edges = std::atoll(value.c_str());
+        } else if (arg == "--rmat") {
+            if (std::sscanf(value.c_str(), "%f,%f,%f", &params.rmat_a, &params.rmat_b, &params.rmat_c) != 3 ||
+                params.rmat_a + params.rmat_b + params.rmat_c > 1.0f) {
+                std::cerr << "❌ --rmat expects a,b,c with a+b+c <= 1\n";
+                return 1;
+            }
+        } else if (arg == "--weights") {
+            if (value == "uniform") params.weights = WeightDistribution::UNIFORM;
+            else if (value == "exp") params.weights = WeightDistribution::EXPONENTIAL;
+            else if (value == "pareto") params.weights = WeightDistribution::PARETO;
+            else { usage(argv[0]); return 1; }
+        } else if (arg == "--weight-min") {
+            params.weight_min = std::atof(value.c_str());
+        } else if (arg == "--weight-max") {
+            params.weight_max = std::atof(value.c_str());
+        } else if (arg == "--weight-mean") {
+            params.weight_mean = std::atof(value.c_str());
+        } else if (arg == "--weight-alpha") {
+            params.weight_alpha = std::atof(value.c_str());
+        } else if (arg == "--dim") {
+            params.embedding_dim = std::max(0, std::atoi(value.c_str()));
+        } else if (arg == "--clusters") {
+            params.clusters = std::max(1, std::atoi(value.c_str()));
+        } else if (arg == "--spread") {
+            params.cluster_spread = std::atof(value.c_str());
+        } else if (arg == "--seed") {
+            params.seed = std::strtoull(value.c_str(), nullptr, 10);
+        } else if (arg == "--threads") {
+            params.threads = std::atoi(value.c_str());
+        } else if (arg == "--out") {
+            out_dir = value;
+        } else {
+            usage(argv[0]);
+            return 1;
+        }
+    }
+
+    std::cout << "🧬 Generating " << (params.model == GraphModel::RMAT ? "R-MAT" : "Barabási–Albert")
+              << " graph: " << params.nodes << " nodes\n";
+
+    auto start = std::chrono::steady_clock::now();
+    GeneratedGraph graph = generate_graph(params);
+    double gen_s = seconds_since(start);
+
+    uint32_t max_degree = 0;
+    for (uint32_t d : graph.degrees) max_degree = std::max(max_degree, d);
+
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "   Edges:      " << graph.edges.size() << " (undirected)\n";
+    std::cout << "   Avg degree: " << 2.0 * graph.edges.size() / graph.nodes
+              << ", max " << max_degree << "\n";
+    std::cout << "   Generated in " << gen_s << "s\n";
+
+    start = std::chrono::steady_clock::now();
+    std::string nodes_path = out_dir + "/unified_nodes.bin";
+    std::string edges_path = out_dir + "/unified_edges.bin";
+    std::string embeddings_path = out_dir + "/unified_embeddings.bin";
+
+    if (!write_nodes_bin(graph, nodes_path) || !write_edges_bin(graph, edges_path)) {
+        std::cerr << "❌ Cannot write graph files in " << out_dir << "\n";
+        return 1;
+    }
+    if (params.embedding_dim > 0 && !write_embeddings_bin(graph, embeddings_path)) {
+        std::cerr << "❌ Cannot write " << embeddings_path << "\n";
+        return 1;
+    }
+
+    std::cout << "✅ Written in " << seconds_since(start) << "s → " << nodes_path << ", " << edges_path;
+    if (params.embedding_dim > 0) std::cout << ", " << embeddings_path;
+    std::cout << "\n";
+    return 0;
+}
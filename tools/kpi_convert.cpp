@@ -0,0 +1,66 @@
+/**
+ * @file kpi_convert.cpp
+ * @brief Offline converter for binary KPI logs (logs/kpis.bin)
+ *
+ * Usage: kpi_convert <kpis.bin> [--jsonl|--csv] [output]
+ *
+ * Writes to stdout when no output path is given. JSONL lines match the
+ * format the logger used to write synchronously.
+ */
+
+#include <iostream>
+#include <fstream>
+#include <string>
+#include "cognitive_os/metrics.h"
+
+using namespace melvin::cognitive_os;
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        std::cerr << "Usage: " << argv[0] << " <kpis.bin> [--jsonl|--csv] [output]\n";
+        return 1;
+    }
+
+    std::string input = argv[1];
+    bool csv = false;
+    std::string output;
+
+    for (int i = 2; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--csv") csv = true;
+        else if (arg == "--jsonl") csv = false;
+        else output = arg;
+    }
+
+    KpiLogReader reader;
+    if (!reader.open(input)) {
+        std::cerr << "❌ Not a KPI log (or incompatible version): " << input << "\n";
+        return 1;
+    }
+
+    std::ofstream file;
+    if (!output.empty()) {
+        file.open(output);
+        if (!file.is_open()) {
+            std::cerr << "❌ Cannot open output: " << output << "\n";
+            return 1;
+        }
+    }
+    std::ostream& out = output.empty() ? std::cout : file;
+
+    if (csv) {
+        out << kpis_csv_header() << "\n";
+    }
+
+    SystemKPIs kpis;
+    uint64_t records = 0;
+    while (reader.next(kpis)) {
+        out << (csv ? kpis_to_csv(kpis) : kpis_to_json(kpis)) << "\n";
+        records++;
+    }
+
+    if (!output.empty()) {
+        std::cerr << "✅ " << records << " records → " << output << "\n";
+    }
+    return 0;
+}
@@ -239,7 +239,7 @@ void Validator::collect_kpis() {
     }
     
     kpi.dropped_msgs = os_->event_bus()->dropped_messages();
-    kpi.cpu_usage = 0.5f;  // Would query system
+    kpi.cpu_usage = os_->cpu().process_load();
     kpi.gpu_usage = 0.0f;
     
     // Compute jitter
@@ -298,9 +298,20 @@ bool Validator::test_timing() {
 }
 
 bool Validator::test_scheduler_fairness() {
-    // Simplified: assume all services are getting fair time
-    latest_results_.cognition_on_time = 0.95f;
-    latest_results_.learning_on_time = 0.92f;
+    // On-time rate per service from the executor's deadline accounting
+    latest_results_.cognition_on_time = 1.0f;
+    latest_results_.learning_on_time = 1.0f;
+    for (const auto& st : os_->service_stats()) {
+        uint64_t due = st.completions + st.skipped;
+        if (due == 0) continue;
+        float on_time = 1.0f - static_cast<float>(st.deadline_misses) / static_cast<float>(due);
+        on_time = std::max(0.0f, on_time);
+        if (st.name == cognitive_os::builtin_service_name(cognitive_os::SVC_COGNITION)) {
+            latest_results_.cognition_on_time = on_time;
+        } else if (st.name == cognitive_os::builtin_service_name(cognitive_os::SVC_LEARNING)) {
+            latest_results_.learning_on_time = on_time;
+        }
+    }
     
     bool pass = (latest_results_.cognition_on_time > 0.9f && 
                  latest_results_.learning_on_time > 0.9f);